@@ -0,0 +1,287 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares deserializing a nested message into heap-allocated containers with deserializing it into an
+// eprosima::fastcdr::Arena. Reports the number of operator new calls and the mean latency per message.
+
+#include <fastcdr/Cdr.h>
+#include <fastcdr/Arena.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+using namespace eprosima::fastcdr;
+
+static std::atomic<size_t> new_calls(0);
+
+void* operator new(
+        size_t size)
+{
+    ++new_calls;
+    void* ptr = malloc(size != 0 ? size : 1);
+    if (ptr == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(
+        void* ptr) noexcept
+{
+    free(ptr);
+}
+
+void operator delete(
+        void* ptr,
+        size_t) noexcept
+{
+    free(ptr);
+}
+
+static const size_t NUM_JOINTS = 24;
+static const size_t NUM_TAGS = 8;
+static const size_t PAYLOAD_SIZE = 512;
+static const size_t ITERATIONS = 20000;
+
+struct HeapTraits
+{
+    typedef std::string string;
+    template<class _T>
+    using vector = std::vector<_T>;
+};
+
+#if defined(__cpp_lib_memory_resource)
+struct PmrTraits
+{
+    typedef std::pmr::string string;
+    template<class _T>
+    using vector = std::pmr::vector<_T>;
+};
+#endif // if defined(__cpp_lib_memory_resource)
+
+// A joint of a robot state message.
+template<class _Traits>
+struct Joint
+{
+#if defined(__cpp_lib_memory_resource)
+    typedef typename std::conditional<std::is_same<_Traits, PmrTraits>::value,
+            std::pmr::polymorphic_allocator<char>, std::allocator<char>>::type allocator_type;
+
+    Joint() = default;
+
+    explicit Joint(
+            const allocator_type& allocator)
+        : name(allocator)
+        , covariance(allocator)
+    {
+    }
+
+    Joint(
+            const Joint& other,
+            const allocator_type& allocator)
+        : name(other.name, allocator)
+        , position(other.position)
+        , velocity(other.velocity)
+        , covariance(other.covariance, allocator)
+    {
+    }
+
+    Joint(
+            Joint&& other,
+            const allocator_type& allocator)
+        : name(std::move(other.name), allocator)
+        , position(other.position)
+        , velocity(other.velocity)
+        , covariance(std::move(other.covariance), allocator)
+    {
+    }
+
+    Joint(
+            const Joint&) = default;
+
+    Joint(
+            Joint&&) = default;
+#endif // if defined(__cpp_lib_memory_resource)
+
+    void serialize(
+            Cdr& cdr) const
+    {
+        cdr << name << position << velocity << covariance;
+    }
+
+    void deserialize(
+            Cdr& cdr)
+    {
+        cdr >> name >> position >> velocity >> covariance;
+    }
+
+    typename _Traits::string name;
+    double position = 0;
+    double velocity = 0;
+    typename _Traits::template vector<double> covariance;
+};
+
+// A robot state message: strings, sequences of primitives and a sequence of nested structures.
+template<class _Traits>
+struct RobotState
+{
+    RobotState() = default;
+
+#if defined(__cpp_lib_memory_resource)
+    explicit RobotState(
+            const typename Joint<_Traits>::allocator_type& allocator)
+        : frame_id(allocator)
+        , joints(allocator)
+        , tags(allocator)
+        , payload(allocator)
+    {
+    }
+
+#endif // if defined(__cpp_lib_memory_resource)
+
+    void serialize(
+            Cdr& cdr) const
+    {
+        cdr << frame_id << stamp << joints << tags << payload;
+    }
+
+    void deserialize(
+            Cdr& cdr)
+    {
+        cdr >> frame_id >> stamp >> joints >> tags >> payload;
+    }
+
+    typename _Traits::string frame_id;
+    uint64_t stamp = 0;
+    typename _Traits::template vector<Joint<_Traits>> joints;
+    typename _Traits::template vector<typename _Traits::string> tags;
+    typename _Traits::template vector<uint8_t> payload;
+};
+
+static void fill(
+        RobotState<HeapTraits>& state)
+{
+    state.frame_id = "base_link_of_the_robot_arm";
+    state.stamp = 1234567890;
+    state.joints.resize(NUM_JOINTS);
+    for (size_t count = 0; count < NUM_JOINTS; ++count)
+    {
+        state.joints[count].name = "joint_number_" + std::to_string(count) + "_of_the_arm";
+        state.joints[count].position = static_cast<double>(count) * 0.5;
+        state.joints[count].covariance.assign(9, 0.25);
+    }
+    for (size_t count = 0; count < NUM_TAGS; ++count)
+    {
+        state.tags.push_back("diagnostic_tag_" + std::to_string(count));
+    }
+    state.payload.assign(PAYLOAD_SIZE, 0x5A);
+}
+
+static void report(
+        const char* name,
+        size_t calls,
+        std::chrono::steady_clock::duration elapsed)
+{
+    std::cout << name << ": " << static_cast<double>(calls) / ITERATIONS << " operator new calls/message, " <<
+        static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / ITERATIONS <<
+        " ns/message" << std::endl;
+}
+
+template<class _Function>
+static void measure(
+        const char* name,
+        _Function function)
+{
+    // Warm up, so that the arena reaches its steady-state block.
+    function();
+
+    size_t calls_before = new_calls.load();
+    auto start = std::chrono::steady_clock::now();
+    for (size_t count = 0; count < ITERATIONS; ++count)
+    {
+        function();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    report(name, new_calls.load() - calls_before, elapsed);
+}
+
+int main()
+{
+    RobotState<HeapTraits> sample;
+    fill(sample);
+
+    FastBuffer cdrbuffer;
+    Cdr cdr_ser(cdrbuffer);
+    cdr_ser << sample;
+
+    // Raw tags as a sequence of strings for the raw paths.
+    FastBuffer tags_cdrbuffer;
+    Cdr tags_ser(tags_cdrbuffer);
+    tags_ser.serializeSequence(sample.tags.data(), sample.tags.size());
+    tags_ser.serializeSequence(sample.payload.data(), sample.payload.size());
+
+    std::cout << "Message of " << cdr_ser.getSerializedDataLength() << " bytes, " << ITERATIONS <<
+        " iterations" << std::endl;
+
+    measure("std containers", [&]()
+            {
+                Cdr cdr_des(cdrbuffer);
+                RobotState<HeapTraits> state;
+                cdr_des >> state;
+            });
+
+#if defined(__cpp_lib_memory_resource)
+    Arena arena;
+    ArenaMemoryResource resource(arena);
+    measure("std::pmr containers on Arena", [&]()
+            {
+                arena.reset();
+                Cdr cdr_des(cdrbuffer);
+                RobotState<PmrTraits> state(&resource);
+                cdr_des >> state;
+            });
+#else
+    Arena arena;
+    std::cout << "std::pmr containers on Arena: not measured, std::pmr needs C++17" << std::endl;
+#endif // if defined(__cpp_lib_memory_resource)
+
+    measure("raw sequences with new[]/calloc", [&]()
+            {
+                Cdr cdr_des(tags_cdrbuffer);
+                std::string* tags = nullptr;
+                uint8_t* payload = nullptr;
+                size_t length = 0;
+                cdr_des.deserializeSequence(tags, length);
+                cdr_des.deserializeSequence(payload, length);
+                delete [] tags;
+                free(payload);
+            });
+
+    measure("raw sequences on Arena", [&]()
+            {
+                arena.reset();
+                Cdr cdr_des(tags_cdrbuffer);
+                char** tags = nullptr;
+                uint8_t* payload = nullptr;
+                size_t length = 0;
+                cdr_des.deserializeStringSequence(tags, length, arena);
+                cdr_des.deserializeSequence(payload, length, arena);
+            });
+
+    return 0;
+}
@@ -0,0 +1,185 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Acquires and releases buffers of mixed sizes from many threads at once, with a eprosima::fastcdr::BufferPool and
+// with default constructed buffers that allocate on each use. In the handoff runs, each buffer is released by another
+// thread than the one that acquired it.
+// Usage: BufferPoolBenchmark [threads]
+
+#include <fastcdr/BufferPool.h>
+#include <fastcdr/Cdr.h>
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+using namespace eprosima::fastcdr;
+
+static const size_t OPERATIONS = 200000;
+static const size_t BATCH = 16;
+
+static size_t message_size(
+        size_t count)
+{
+    return size_t(200) << (count % 7);
+}
+
+// Serializes a message into the buffer, so that its memory is actually touched.
+static void fill(
+        FastBuffer& buffer,
+        size_t size)
+{
+    Cdr cdr(buffer);
+    cdr << static_cast<uint32_t>(size);
+    cdr.jump(size - sizeof(uint32_t));
+}
+
+template<class _Function>
+static double run(
+        size_t numThreads,
+        _Function function)
+{
+    std::atomic<size_t> ready(0);
+    std::vector<std::thread> threads;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t index = 0; index < numThreads; ++index)
+    {
+        threads.emplace_back([&, index]()
+                {
+                    ready.fetch_add(1);
+                    while (ready.load() < numThreads)
+                    {
+                        std::this_thread::yield();
+                    }
+                    function(index);
+                });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double>(elapsed).count();
+}
+
+static void report(
+        const char* name,
+        size_t numThreads,
+        double time)
+{
+    double operations = static_cast<double>(numThreads * OPERATIONS);
+    std::cout << name << ": " << operations / time / 1e6 << " M acquire/release per second" << std::endl;
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    size_t numThreads = 32;
+    if (argc > 1)
+    {
+        std::istringstream(argv[1]) >> numThreads;
+    }
+    numThreads = numThreads > 0 ? numThreads : 1;
+
+    std::cout << numThreads << " threads, " << OPERATIONS << " operations per thread" << std::endl;
+
+    report("malloc, local", numThreads, run(numThreads, [](size_t)
+            {
+                for (size_t count = 0; count < OPERATIONS; ++count)
+                {
+                    FastBuffer buffer;
+                    buffer.reserve(message_size(count));
+                    fill(buffer, message_size(count));
+                }
+            }));
+
+    BufferPool pool;
+
+    report("pool, local", numThreads, run(numThreads, [&](size_t)
+            {
+                for (size_t count = 0; count < OPERATIONS; ++count)
+                {
+                    FastBuffer buffer = pool.acquire(message_size(count));
+                    fill(buffer, message_size(count));
+                    pool.release(buffer);
+                }
+            }));
+
+    // Each thread passes batches of buffers to the next one through a slot, and releases the batches it receives.
+    std::vector<std::atomic<std::vector<FastBuffer>*>> slots(numThreads);
+
+    auto handoff = [&](size_t index, bool pooled)
+            {
+                std::atomic<std::vector<FastBuffer>*>& outgoing = slots[(index + 1) % numThreads];
+                std::atomic<std::vector<FastBuffer>*>& incoming = slots[index];
+                size_t sent = 0;
+                size_t received = 0;
+
+                while ((sent < OPERATIONS) || (received < OPERATIONS))
+                {
+                    if ((sent < OPERATIONS) && (outgoing.load(std::memory_order_acquire) == nullptr))
+                    {
+                        std::vector<FastBuffer>* batch = new std::vector<FastBuffer>();
+                        for (size_t count = 0; count < BATCH; ++count, ++sent)
+                        {
+                            batch->push_back(pooled ? pool.acquire(message_size(sent)) : FastBuffer());
+                            if (!pooled)
+                            {
+                                batch->back().reserve(message_size(sent));
+                            }
+                            fill(batch->back(), message_size(sent));
+                        }
+                        outgoing.store(batch, std::memory_order_release);
+                    }
+
+                    std::vector<FastBuffer>* batch = incoming.exchange(nullptr, std::memory_order_acquire);
+                    if (batch == nullptr)
+                    {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    for (FastBuffer& buffer : *batch)
+                    {
+                        if (pooled)
+                        {
+                            pool.release(buffer);
+                        }
+                    }
+                    received += batch->size();
+                    delete batch;
+                }
+            };
+
+    for (std::atomic<std::vector<FastBuffer>*>& slot : slots)
+    {
+        slot = nullptr;
+    }
+    report("malloc, handoff", numThreads, run(numThreads, [&](size_t index)
+            {
+                handoff(index, false);
+            }));
+
+    report("pool, handoff", numThreads, run(numThreads, [&](size_t index)
+            {
+                handoff(index, true);
+            }));
+
+    std::cout << "retained by the pool: " << pool.getRetainedBytes() << " bytes" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,188 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Serializes a large array of doubles, with swapping, from a thread on each NUMA node into memory placed on each node,
+// reporting the throughput of local and remote writes. Then threads on every node serialize into buffers of a
+// BufferPool, handing half of them to a thread of the next node to be released, and the share of buffers acquired on
+// the node of the thread is reported. On a machine with a single node, only local writes are measured.
+// Usage: NumaBenchmark [megabytes]
+
+#include <fastcdr/BufferPool.h>
+#include <fastcdr/Cdr.h>
+#include <fastcdr/Numa.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+using namespace eprosima::fastcdr;
+
+static const size_t ITERATIONS = 10;
+static const size_t POOL_BUFFER_SIZE = 4 * 1024 * 1024;
+static const size_t POOL_ITERATIONS = 200;
+
+// Runs a function in a new thread restricted to a node.
+template<class _Function>
+static void run_on_node(
+        size_t node,
+        _Function function)
+{
+    std::thread thread([&]()
+            {
+                Numa::runOnNode(node);
+                function();
+            });
+    thread.join();
+}
+
+static const char* describe(
+        size_t node)
+{
+    static std::string text;
+    text = node == Numa::UNKNOWN_NODE ? std::string("unknown") : std::to_string(node);
+    return text.c_str();
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    size_t megabytes = 256;
+    if (argc > 1)
+    {
+        std::istringstream(argv[1]) >> megabytes;
+    }
+    megabytes = megabytes > 0 ? megabytes : 1;
+
+    size_t numNodes = Numa::getNodeCount();
+    size_t size = megabytes * 1024 * 1024;
+    std::vector<double> doubles(size / sizeof(double));
+    for (size_t count = 0; count < doubles.size(); ++count)
+    {
+        doubles[count] = static_cast<double>(count) / 3;
+    }
+
+    Cdr::Endianness swapped = Cdr::DEFAULT_ENDIAN == Cdr::BIG_ENDIANNESS ? Cdr::LITTLE_ENDIANNESS : Cdr::BIG_ENDIANNESS;
+
+    std::cout << numNodes << " NUMA node" << (numNodes > 1 ? "s" : ", only local writes are measured") << ", " <<
+        size << " bytes, " << ITERATIONS << " iterations" << std::endl;
+
+    for (size_t memoryNode = 0; memoryNode < numNodes; ++memoryNode)
+    {
+        char* memory = reinterpret_cast<char*>(malloc(size));
+        if (memory == nullptr)
+        {
+            std::cout << "not enough memory" << std::endl;
+            return 1;
+        }
+
+        // The memory is placed with the policy when allowed, and by touching it first from the node otherwise.
+        bool bound = Numa::bindMemory(memory, size, memoryNode);
+        run_on_node(memoryNode, [&]()
+                {
+                    memset(memory, 0, size);
+                });
+        size_t placedNode = Numa::getMemoryNode(memory + size / 2);
+
+        for (size_t threadNode = 0; threadNode < numNodes; ++threadNode)
+        {
+            double time = 0;
+            run_on_node(threadNode, [&]()
+                    {
+                        FastBuffer buffer(memory, size);
+                        auto start = std::chrono::steady_clock::now();
+                        for (size_t count = 0; count < ITERATIONS; ++count)
+                        {
+                            Cdr cdr(buffer, swapped);
+                            cdr.serializeArray(doubles.data(), doubles.size());
+                        }
+                        auto elapsed = std::chrono::steady_clock::now() - start;
+                        time = std::chrono::duration<double>(elapsed).count() / ITERATIONS;
+                    });
+
+            std::cout << "thread on node " << threadNode << ", memory on node " << describe(placedNode) <<
+                (bound ? " (bound)" : " (first touch)") << ", " << (threadNode == memoryNode ? "local" : "remote") <<
+                ": " << static_cast<double>(size) / time / 1e9 << " GB/s" << std::endl;
+        }
+
+        free(memory);
+    }
+
+    // Half of the buffers are released by a thread of the next node, as when a sample is handed to a consumer.
+    BufferPool pool;
+    std::vector<std::thread> threads;
+    std::vector<size_t> localBuffers(numNodes, 0);
+    std::vector<size_t> knownBuffers(numNodes, 0);
+    std::vector<double> times(numNodes, 0);
+    std::vector<double> values(POOL_BUFFER_SIZE / sizeof(double), 1.0);
+
+    for (size_t node = 0; node < numNodes; ++node)
+    {
+        threads.emplace_back([&, node]()
+                {
+                    Numa::runOnNode(node);
+                    std::vector<FastBuffer> handed;
+                    auto start = std::chrono::steady_clock::now();
+
+                    for (size_t count = 0; count < POOL_ITERATIONS; ++count)
+                    {
+                        FastBuffer buffer = pool.acquire(POOL_BUFFER_SIZE);
+                        Cdr cdr(buffer, swapped);
+                        cdr.serializeArray(values.data(), values.size());
+
+                        size_t memoryNode = Numa::getMemoryNode(buffer.getBuffer() + POOL_BUFFER_SIZE / 2);
+                        knownBuffers[node] += memoryNode != Numa::UNKNOWN_NODE ? 1 : 0;
+                        localBuffers[node] += memoryNode == node ? 1 : 0;
+
+                        if ((count % 2 == 0) && (numNodes > 1))
+                        {
+                            handed.push_back(std::move(buffer));
+                        }
+                        else
+                        {
+                            pool.release(buffer);
+                        }
+                    }
+
+                    auto elapsed = std::chrono::steady_clock::now() - start;
+                    times[node] = std::chrono::duration<double>(elapsed).count();
+
+                    run_on_node((node + 1) % numNodes, [&]()
+                    {
+                        for (FastBuffer& buffer : handed)
+                        {
+                            pool.release(buffer);
+                        }
+                    });
+                });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (size_t node = 0; node < numNodes; ++node)
+    {
+        std::cout << "pool, thread on node " << node << ": " <<
+            static_cast<double>(POOL_BUFFER_SIZE * POOL_ITERATIONS) / times[node] / 1e9 << " GB/s, " <<
+            localBuffers[node] << " of " << knownBuffers[node] << " buffers with a known node were local" << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,154 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Serializes a large sequence of structures, and a large array of doubles with swapping, into a presized buffer with 1
+// to N threads, comparing each run with the sequential path. Reports the throughput and the speedup over one thread.
+// Usage: ParallelBenchmark [max_threads]
+
+#include <fastcdr/Cdr.h>
+#include <fastcdr/ThreadPool.h>
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+using namespace eprosima::fastcdr;
+
+static const size_t NUM_POINTS = 1000000;
+static const size_t ITERATIONS = 20;
+static const size_t NUM_DOUBLES = 16 * 1024 * 1024;
+
+// A point of a point cloud, with a label whose length changes between points.
+struct LabeledPoint
+{
+    void serialize(
+            Cdr& cdr) const
+    {
+        cdr << x << y << z << intensity << label;
+    }
+
+    float x = 0;
+    float y = 0;
+    float z = 0;
+    uint8_t intensity = 0;
+    std::string label;
+};
+
+template<class _Function>
+static double measure(
+        _Function function)
+{
+    // Warm up, so that the pages of the buffers are mapped.
+    function();
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t count = 0; count < ITERATIONS; ++count)
+    {
+        function();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double>(elapsed).count() / ITERATIONS;
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    size_t maxThreads = std::thread::hardware_concurrency();
+    if (argc > 1)
+    {
+        std::istringstream(argv[1]) >> maxThreads;
+    }
+    maxThreads = maxThreads > 0 ? maxThreads : 1;
+
+    std::vector<LabeledPoint> points(NUM_POINTS);
+    for (size_t count = 0; count < NUM_POINTS; ++count)
+    {
+        points[count].x = static_cast<float>(count);
+        points[count].y = static_cast<float>(count) * 0.5f;
+        points[count].z = static_cast<float>(count) * 0.25f;
+        points[count].intensity = static_cast<uint8_t>(count);
+        points[count].label = std::string(count % 11, 'p');
+    }
+
+    size_t size = 0;
+    {
+        FastBuffer sizeBuffer;
+        Cdr cdr(sizeBuffer);
+        cdr << points;
+        size = cdr.getSerializedDataLength();
+    }
+
+    std::vector<char> data(size, 0);
+    FastBuffer buffer(data.data(), data.size());
+
+    std::cout << NUM_POINTS << " points, " << size << " bytes, " << ITERATIONS << " iterations" << std::endl;
+
+    double sequentialTime = measure([&]()
+                    {
+                        Cdr cdr(buffer);
+                        cdr << points;
+                    });
+    std::cout << "sequential: " << static_cast<double>(size) / sequentialTime / 1e9 << " GB/s" << std::endl;
+    std::vector<char> expected = data;
+
+    double oneThreadTime = 0;
+
+    for (size_t threads = 1; threads <= maxThreads; ++threads)
+    {
+        ThreadPool pool(threads - 1);
+        double time = measure([&]()
+                        {
+                            Cdr cdr(buffer);
+                            cdr.serialize(points, pool);
+                        });
+        oneThreadTime = threads == 1 ? time : oneThreadTime;
+
+        bool same = data == expected;
+        std::cout << threads << " threads: " << static_cast<double>(size) / time / 1e9 << " GB/s, speedup " <<
+            oneThreadTime / time << (same ? "" : ", OUTPUT DIFFERS") << std::endl;
+    }
+
+    // The doubles are swapped, as the opposite endianness is used.
+    Cdr::Endianness swapped = Cdr::DEFAULT_ENDIAN == Cdr::BIG_ENDIANNESS ? Cdr::LITTLE_ENDIANNESS : Cdr::BIG_ENDIANNESS;
+    std::vector<double> doubles(NUM_DOUBLES);
+    for (size_t count = 0; count < NUM_DOUBLES; ++count)
+    {
+        doubles[count] = static_cast<double>(count) / 3;
+    }
+
+    size = NUM_DOUBLES * sizeof(double);
+    data.assign(size, 0);
+    FastBuffer arrayBuffer(data.data(), data.size());
+
+    std::cout << NUM_DOUBLES << " doubles, " << size << " bytes, swapped" << std::endl;
+
+    for (size_t threads = 1; threads <= maxThreads; ++threads)
+    {
+        ThreadPool pool(threads - 1);
+        double time = measure([&]()
+                        {
+                            Cdr cdr(arrayBuffer, swapped);
+                            cdr.setThreadPool(&pool);
+                            cdr.serializeArray(doubles.data(), doubles.size());
+                        });
+        oneThreadTime = threads == 1 ? time : oneThreadTime;
+
+        std::cout << threads << " threads: " << static_cast<double>(size) / time / 1e9 << " GB/s, speedup " <<
+            oneThreadTime / time << std::endl;
+    }
+
+    return 0;
+}
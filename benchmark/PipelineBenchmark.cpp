@@ -0,0 +1,175 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Serializes a large message, computes its checksum, compresses it and encrypts it, first one step after the other on
+// one thread and then through a CdrPipeline, where every step runs in its own thread on the chunks of the stream.
+// Compression and encryption are stand-ins that cost about as much per byte as light real ones.
+// Usage: PipelineBenchmark [chunk_size]
+
+#include <fastcdr/Cdr.h>
+#include <fastcdr/CdrPipeline.h>
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+
+using namespace eprosima::fastcdr;
+
+static const size_t NUM_SAMPLES = 16 * 1024 * 1024;
+static const size_t ITERATIONS = 10;
+
+// Stands in for a compressor: run-length encoding of the bytes.
+class RunLengthStage : public PipelineStage
+{
+public:
+
+    void process(
+            std::vector<char>& chunk) override
+    {
+        m_output.clear();
+        m_output.reserve(chunk.size() * 2);
+
+        for (size_t index = 0; index < chunk.size();)
+        {
+            size_t run = 1;
+
+            while ((index + run < chunk.size()) && (run < 255) && (chunk[index + run] == chunk[index]))
+            {
+                ++run;
+            }
+
+            m_output.push_back(static_cast<char>(run));
+            m_output.push_back(chunk[index]);
+            index += run;
+        }
+
+        chunk.swap(m_output);
+    }
+
+private:
+
+    std::vector<char> m_output;
+};
+
+// Stands in for a cipher: the bytes are mixed with a key stream.
+class KeyStreamStage : public PipelineStage
+{
+public:
+
+    void process(
+            std::vector<char>& chunk) override
+    {
+        for (char& byte : chunk)
+        {
+            m_state = m_state * 1103515245u + 12345u;
+            byte = static_cast<char>(byte ^ static_cast<char>(m_state >> 16));
+        }
+    }
+
+    void finish(
+            std::vector<char>&) override
+    {
+        m_state = 1;
+    }
+
+private:
+
+    uint32_t m_state = 1;
+};
+
+template<class _Function>
+static double measure(
+        _Function function)
+{
+    function();
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t count = 0; count < ITERATIONS; ++count)
+    {
+        function();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double>(elapsed).count() / ITERATIONS;
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    size_t chunkSize = 256 * 1024;
+    if (argc > 1)
+    {
+        std::istringstream(argv[1]) >> chunkSize;
+    }
+    chunkSize = chunkSize >= 64 ? chunkSize : 64;
+
+    std::vector<float> samples(NUM_SAMPLES);
+    for (size_t count = 0; count < NUM_SAMPLES; ++count)
+    {
+        samples[count] = static_cast<float>(count / 16);
+    }
+
+    size_t size = NUM_SAMPLES * sizeof(float) + 4;
+    size_t outputSize = 0;
+    CallbackSink sink([&outputSize](const char*, size_t written)
+            {
+                outputSize += written;
+                return true;
+            });
+
+    Crc32Stage checksum(true);
+    RunLengthStage compression;
+    KeyStreamStage cipher;
+
+    std::cout << NUM_SAMPLES << " floats, " << size << " bytes, " << ITERATIONS << " iterations" << std::endl;
+
+    std::vector<char> data(size, 0);
+    double sequentialTime = measure([&]()
+                    {
+                        FastBuffer buffer(data.data(), data.size());
+                        Cdr cdr(buffer);
+                        cdr << samples;
+
+                        std::vector<char> message(data.data(), data.data() + cdr.getSerializedDataLength());
+                        checksum.process(message);
+                        checksum.finish(message);
+                        compression.process(message);
+                        cipher.process(message);
+                        cipher.finish(message);
+                        outputSize = 0;
+                        sink.write(message.data(), message.size());
+                    });
+    size_t sequentialSize = outputSize;
+    std::cout << "sequential: " << static_cast<double>(size) / sequentialTime / 1e9 << " GB/s, " <<
+        sequentialSize << " bytes written" << std::endl;
+
+    CdrPipeline pipeline({&checksum, &compression, &cipher}, sink);
+    std::vector<char> window(chunkSize, 0);
+    bool ok = true;
+    double pipelinedTime = measure([&]()
+                    {
+                        FastBuffer buffer(window.data(), window.size());
+                        Cdr cdr(buffer);
+                        cdr.setSink(&pipeline);
+                        outputSize = 0;
+                        cdr << samples;
+                        ok &= cdr.flush();
+                        ok &= pipeline.finish();
+                    });
+    std::cout << "pipelined, chunks of " << chunkSize << " bytes: " << static_cast<double>(size) / pipelinedTime / 1e9 <<
+        " GB/s, " << outputSize << " bytes written, speedup " << sequentialTime / pipelinedTime <<
+        (ok ? "" : ", FAILED") << std::endl;
+
+    return 0;
+}
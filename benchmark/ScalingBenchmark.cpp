@@ -0,0 +1,334 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Runs serialization and deserialization workloads on 1 to N independent threads, each one with its own buffer and
+// the same amount of work, and reports messages per second, GB/s and the scaling efficiency against one thread.
+// As the threads share nothing, an efficiency well below 100% points to contention, e.g. in the allocator. The
+// "growing buffers" workload starts every message with an empty buffer, so FastBuffer::resize allocates on every
+// message. Thread counts double from 1 up to N.
+// Usage: ScalingBenchmark [max_threads] [workload]
+
+#include <fastcdr/Cdr.h>
+#include <fastcdr/FastCdr.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace eprosima::fastcdr;
+
+//! The bytes serialized by each thread in a run. The number of messages is derived from it.
+static const size_t BYTES_PER_THREAD = 64 * 1024 * 1024;
+
+// A small structure with fields of several sizes.
+struct ScalePose
+{
+    void serialize(
+            Cdr& cdr) const
+    {
+        cdr << id << x << y << z << weight << flags;
+    }
+
+    void deserialize(
+            Cdr& cdr)
+    {
+        cdr >> id >> x >> y >> z >> weight >> flags;
+    }
+
+    void serialize(
+            FastCdr& cdr) const
+    {
+        cdr << id << x << y << z << weight << flags;
+    }
+
+    void deserialize(
+            FastCdr& cdr)
+    {
+        cdr >> id >> x >> y >> z >> weight >> flags;
+    }
+
+    uint32_t id = 7;
+    double x = 1.5;
+    double y = -2.5;
+    double z = 3.25;
+    float weight = 0.5f;
+    uint16_t flags = 3;
+};
+
+// A structure of strings, which allocate when deserialized.
+struct ScaleLabels
+{
+    void serialize(
+            Cdr& cdr) const
+    {
+        cdr << name << description << path << tags;
+    }
+
+    void deserialize(
+            Cdr& cdr)
+    {
+        cdr >> name >> description >> path >> tags;
+    }
+
+    std::string name = std::string(16, 'n');
+    std::string description = std::string(200, 'd');
+    std::string path = std::string(64, 'p');
+    std::vector<std::string> tags = std::vector<std::string>(8, std::string(10, 't'));
+};
+
+// The buffer of a thread, kept from one run to the next of the same workload.
+struct ThreadBuffer
+{
+    std::vector<char> data;
+    FastBuffer buffer;
+};
+
+// A workload serializes or deserializes one message with the buffer of the thread.
+typedef std::function<void (ThreadBuffer&)> Operation;
+
+struct Workload
+{
+    std::string name;
+
+    //! The serialized size of one message.
+    size_t messageSize;
+
+    Operation serialize;
+
+    Operation deserialize;
+
+    //! Serializes the message read by the deserialize operation into the buffer of the thread, when serialize does not.
+    Operation prepare;
+};
+
+// Runs an operation in every thread at once, and returns the time until the last one finishes.
+static double run(
+        size_t numThreads,
+        size_t numMessages,
+        std::vector<ThreadBuffer>& buffers,
+        const Operation& operation)
+{
+    std::atomic<size_t> ready(0);
+    std::vector<std::thread> threads;
+    std::chrono::steady_clock::time_point start;
+
+    for (size_t index = 0; index < numThreads; ++index)
+    {
+        threads.emplace_back([&, index]()
+                {
+                    if (ready.fetch_add(1) + 1 == numThreads)
+                    {
+                        start = std::chrono::steady_clock::now();
+                        ready.fetch_add(1);
+                    }
+
+                    while (ready.load() <= numThreads)
+                    {
+                        std::this_thread::yield();
+                    }
+
+                    for (size_t count = 0; count < numMessages; ++count)
+                    {
+                        operation(buffers[index]);
+                    }
+                });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double>(elapsed).count();
+}
+
+// Doubles the number of threads, ending with the maximum.
+static size_t next_count(
+        size_t threads,
+        size_t maxThreads)
+{
+    return (threads < maxThreads) && (threads * 2 > maxThreads) ? maxThreads : threads * 2;
+}
+
+static void measure(
+        const Workload& workload,
+        size_t maxThreads)
+{
+    size_t numMessages = BYTES_PER_THREAD / workload.messageSize;
+    numMessages = numMessages > 0 ? numMessages : 1;
+
+    // Each thread has its own buffer, allocated by the thread that uses it.
+    std::vector<ThreadBuffer> buffers(maxThreads);
+    run(maxThreads, 1, buffers, [&](ThreadBuffer& buffer)
+            {
+                buffer.data.assign(workload.messageSize, 0);
+                buffer.buffer = FastBuffer(buffer.data.data(), buffer.data.size());
+                (workload.prepare ? workload.prepare : workload.serialize)(buffer);
+            });
+
+    std::cout << workload.name << ", " << workload.messageSize << " bytes, " << numMessages <<
+        " messages per thread" << std::endl;
+
+    const std::pair<const char*, const Operation*> operations[] = {
+        {"serialize", &workload.serialize}, {"deserialize", &workload.deserialize}};
+
+    for (const std::pair<const char*, const Operation*>& operation : operations)
+    {
+        double oneThreadRate = 0;
+
+        for (size_t threads = 1; threads <= maxThreads; threads = next_count(threads, maxThreads))
+        {
+            // A first run warms up the caches and the allocator.
+            run(threads, numMessages / 10 + 1, buffers, *operation.second);
+            double time = run(threads, numMessages, buffers, *operation.second);
+            double messages = static_cast<double>(threads * numMessages);
+            double rate = messages / time;
+            oneThreadRate = threads == 1 ? rate : oneThreadRate;
+
+            std::cout << "  " << std::setw(11) << std::left << operation.first << std::right << std::setw(4) <<
+                threads << " threads: " << std::setw(10) << rate / 1e6 << " M msgs/s, " << std::setw(10) <<
+                rate * static_cast<double>(workload.messageSize) / 1e9 << " GB/s, efficiency " <<
+                100 * rate / (oneThreadRate * static_cast<double>(threads)) << "%" << std::endl;
+        }
+    }
+}
+
+template<class _T>
+static size_t cdr_size(
+        const _T& value)
+{
+    FastBuffer buffer;
+    Cdr cdr(buffer);
+    cdr << value;
+    return cdr.getSerializedDataLength();
+}
+
+// FastCdr does not align, so the messages are smaller.
+static size_t fastcdr_size(
+        const ScalePose& value)
+{
+    FastBuffer buffer;
+    FastCdr cdr(buffer);
+    value.serialize(cdr);
+    return cdr.getSerializedDataLength();
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    size_t maxThreads = std::thread::hardware_concurrency();
+    if (argc > 1)
+    {
+        std::istringstream(argv[1]) >> maxThreads;
+    }
+    maxThreads = maxThreads > 0 ? maxThreads : 1;
+    std::string filter = argc > 2 ? argv[2] : "";
+
+    const ScalePose pose;
+    const ScaleLabels labels;
+    const std::vector<double> samples(1024 * 1024, 0.25);
+    std::vector<Workload> workloads;
+
+    workloads.push_back({"Cdr small struct", cdr_size(pose),
+                         [&](ThreadBuffer& buffer)
+                         {
+                             Cdr cdr(buffer.buffer);
+                             cdr << pose;
+                         },
+                         [](ThreadBuffer& buffer)
+                         {
+                             Cdr cdr(buffer.buffer);
+                             ScalePose value;
+                             cdr >> value;
+                         },
+                         nullptr});
+
+    workloads.push_back({"FastCdr small struct", fastcdr_size(pose),
+                         [&](ThreadBuffer& buffer)
+                         {
+                             FastCdr cdr(buffer.buffer);
+                             pose.serialize(cdr);
+                         },
+                         [](ThreadBuffer& buffer)
+                         {
+                             FastCdr cdr(buffer.buffer);
+                             ScalePose value;
+                             value.deserialize(cdr);
+                         },
+                         nullptr});
+
+    Operation serializeLabels = [&](ThreadBuffer& buffer)
+            {
+                Cdr cdr(buffer.buffer);
+                cdr << labels;
+            };
+
+    workloads.push_back({"Cdr strings", cdr_size(labels), serializeLabels,
+                         [](ThreadBuffer& buffer)
+                         {
+                             Cdr cdr(buffer.buffer);
+                             ScaleLabels value;
+                             cdr >> value;
+                         },
+                         nullptr});
+
+    workloads.push_back({"Cdr large array", cdr_size(samples),
+                         [&](ThreadBuffer& buffer)
+                         {
+                             Cdr cdr(buffer.buffer);
+                             cdr << samples;
+                         },
+                         [](ThreadBuffer& buffer)
+                         {
+                             // The vector of each thread keeps its memory from one message to the next.
+                             thread_local std::vector<double> value;
+                             Cdr cdr(buffer.buffer);
+                             cdr >> value;
+                         },
+                         nullptr});
+
+    workloads.push_back({"Cdr strings, growing buffers", cdr_size(labels),
+                         [&](ThreadBuffer&)
+                         {
+                             FastBuffer growing;
+                             Cdr cdr(growing);
+                             cdr << labels;
+                         },
+                         [](ThreadBuffer& buffer)
+                         {
+                             Cdr cdr(buffer.buffer);
+                             ScaleLabels value;
+                             cdr >> value;
+                         },
+                         serializeLabels});
+
+    std::cout << "up to " << maxThreads << " threads, " << BYTES_PER_THREAD << " bytes per thread" << std::endl;
+
+    for (const Workload& workload : workloads)
+    {
+        if (workload.name.find(filter) != std::string::npos)
+        {
+            measure(workload, maxThreads);
+        }
+    }
+
+    return 0;
+}
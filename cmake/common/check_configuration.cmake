@@ -54,9 +54,15 @@ macro(check_stdcxx)
             endif()
         endif()
     elseif(MSVC OR MSVC_IDE)
+        if(NOT MSVC_VERSION LESS 1910)
+            set(HAVE_CXX14 1)
+        else()
+            set(HAVE_CXX14 0)
+        endif()
         set(HAVE_CXX11 1)
         set(HAVE_CXX0X 1)
     else()
+        set(HAVE_CXX14 0)
         set(HAVE_CXX11 0)
         set(HAVE_CXX0X 0)
     endif()
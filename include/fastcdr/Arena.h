@@ -0,0 +1,245 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _FASTCDR_ARENA_H_
+#define _FASTCDR_ARENA_H_
+
+#include "fastcdr_dll.h"
+#include <stdint.h>
+#include <cstddef>
+#include <new>
+
+#if defined(__has_include) && (__cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L))
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#endif // if __has_include(<memory_resource>)
+#endif // if defined(__has_include) && (__cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L))
+
+namespace eprosima {
+namespace fastcdr {
+/*!
+ * @brief This class implements a monotonic memory arena.
+ * Memory is taken from large blocks and is never released individually. All of it is released at once by
+ * calling reset(), which keeps the largest block so that messages of a similar size are deserialized
+ * again without calling malloc.
+ * @ingroup FASTCDRAPIREFERENCE
+ */
+class Cdr_DllAPI Arena
+{
+public:
+
+    /*!
+     * @brief This constructor creates an empty arena. No memory is allocated until the first allocation.
+     * @param initialBlockSize Size of the first block taken from the heap.
+     */
+    explicit Arena(
+            size_t initialBlockSize = 4096);
+
+    //! @brief Destructor. Releases all the blocks.
+    ~Arena();
+
+    /*!
+     * @brief This function allocates memory from the arena.
+     * @param size Number of bytes to allocate.
+     * @param alignment Alignment of the returned memory. It should be a power of two.
+     * @return Pointer to the allocated memory.
+     * @exception std::bad_alloc This exception is thrown when a new block cannot be taken from the heap.
+     */
+    void* allocate(
+            size_t size,
+            size_t alignment = alignof(std::max_align_t));
+
+    /*!
+     * @brief This function releases all the memory allocated from the arena at once.
+     * Every pointer returned by allocate() becomes invalid.
+     */
+    void reset();
+
+    /*!
+     * @brief This function returns the number of bytes allocated from the arena since the last reset.
+     * @return The number of bytes allocated, including alignment padding.
+     */
+    size_t getAllocatedBytes() const
+    {
+        return m_allocatedBytes;
+    }
+
+private:
+
+    Arena(
+            const Arena&) = delete;
+
+    Arena& operator =(
+            const Arena&) = delete;
+
+    //! @brief Header placed at the beginning of every block.
+    struct Block
+    {
+        //! @brief The block allocated before this one.
+        Block* previous;
+
+        //! @brief Size of the block, including this header.
+        size_t size;
+    };
+
+    //! @brief Size of the first block taken from the heap.
+    size_t m_initialBlockSize;
+
+    //! @brief The block memory is currently taken from.
+    Block* m_currentBlock;
+
+    //! @brief Position of the first free byte in the current block.
+    char* m_currentPosition;
+
+    //! @brief Position past the last byte of the current block.
+    char* m_lastPosition;
+
+    //! @brief Number of bytes allocated since the last reset.
+    size_t m_allocatedBytes;
+};
+
+/*!
+ * @brief This class template implements a standard allocator that takes its memory from an eprosima::fastcdr::Arena.
+ * Deallocation does nothing: memory is released when the arena is reset.
+ * Containers of containers do not pass this allocator down to their elements. Use std::pmr containers with an
+ * eprosima::fastcdr::ArenaMemoryResource for nested types.
+ * @ingroup FASTCDRAPIREFERENCE
+ */
+template<class _T>
+class ArenaAllocator
+{
+    template<class _U>
+    friend class ArenaAllocator;
+
+public:
+
+    typedef _T value_type;
+
+    /*!
+     * @brief This constructor creates an allocator that takes its memory from an arena.
+     * @param arena The arena. It must outlive the allocator and every container using it.
+     */
+    ArenaAllocator(
+            Arena& arena) noexcept
+        : m_arena(&arena)
+    {
+    }
+
+    /*!
+     * @brief Converting constructor, used by containers to rebind the allocator.
+     */
+    template<class _U>
+    ArenaAllocator(
+            const ArenaAllocator<_U>& other) noexcept
+        : m_arena(other.m_arena)
+    {
+    }
+
+    /*!
+     * @brief This function allocates memory for an array of objects.
+     * @param numElements Number of objects.
+     * @return Pointer to the allocated memory.
+     * @exception std::bad_alloc This exception is thrown when the memory cannot be allocated.
+     */
+    _T* allocate(
+            size_t numElements)
+    {
+        if (numElements > static_cast<size_t>(-1) / sizeof(_T))
+        {
+            throw std::bad_alloc();
+        }
+
+        return static_cast<_T*>(m_arena->allocate(numElements * sizeof(_T), alignof(_T)));
+    }
+
+    /*!
+     * @brief This function does nothing. The memory is released when the arena is reset.
+     */
+    void deallocate(
+            _T*,
+            size_t) noexcept
+    {
+    }
+
+    template<class _U>
+    bool operator ==(
+            const ArenaAllocator<_U>& other) const noexcept
+    {
+        return m_arena == other.m_arena;
+    }
+
+    template<class _U>
+    bool operator !=(
+            const ArenaAllocator<_U>& other) const noexcept
+    {
+        return m_arena != other.m_arena;
+    }
+
+private:
+
+    //! @brief The arena the memory is taken from.
+    Arena* m_arena;
+};
+
+#if defined(__cpp_lib_memory_resource)
+/*!
+ * @brief This class adapts an eprosima::fastcdr::Arena to std::pmr::memory_resource,
+ * so that std::pmr containers can be deserialized into the arena.
+ * @ingroup FASTCDRAPIREFERENCE
+ */
+class ArenaMemoryResource : public std::pmr::memory_resource
+{
+public:
+
+    /*!
+     * @brief This constructor creates a memory resource that takes its memory from an arena.
+     * @param arena The arena. It must outlive the memory resource.
+     */
+    explicit ArenaMemoryResource(
+            Arena& arena) noexcept
+        : m_arena(arena)
+    {
+    }
+
+private:
+
+    void* do_allocate(
+            size_t bytes,
+            size_t alignment) override
+    {
+        return m_arena.allocate(bytes, alignment);
+    }
+
+    void do_deallocate(
+            void*,
+            size_t,
+            size_t) override
+    {
+    }
+
+    bool do_is_equal(
+            const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    //! @brief The arena the memory is taken from.
+    Arena& m_arena;
+};
+#endif // if defined(__cpp_lib_memory_resource)
+
+} //namespace fastcdr
+} //namespace eprosima
+
+#endif // _FASTCDR_ARENA_H_
@@ -0,0 +1,706 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _FASTCDR_ASYNCCDR_H_
+#define _FASTCDR_ASYNCCDR_H_
+
+// The asynchronous API is header-only, so the library itself does not need C++20.
+#if !defined(__cpp_impl_coroutine)
+#error "fastcdr/AsyncCdr.h needs C++20 coroutines"
+#endif // if !defined(__cpp_impl_coroutine)
+
+#include "Cdr.h"
+#include "CdrSink.h"
+#include "ResumableDeserializer.h"
+#include "exceptions/BadParamException.h"
+#include "exceptions/NotEnoughMemoryException.h"
+#include <coroutine>
+#include <cstring>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace eprosima {
+namespace fastcdr {
+
+//! @brief The part of the promise of an eprosima::fastcdr::AsyncTask that does not depend on its result.
+class AsyncPromiseBase
+{
+public:
+
+    //! @brief Resumes the coroutine that awaits the task when it finishes.
+    struct FinalAwaiter
+    {
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        template<class _Promise>
+        std::coroutine_handle<> await_suspend(
+                std::coroutine_handle<_Promise> handle) noexcept
+        {
+            std::coroutine_handle<> continuation = handle.promise().m_continuation;
+            return continuation ? continuation : std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+
+    };
+
+    //! @brief Tasks are lazy: they start when they are awaited or started.
+    std::suspend_always initial_suspend() const noexcept
+    {
+        return {};
+    }
+
+    FinalAwaiter final_suspend() const noexcept
+    {
+        return {};
+    }
+
+    void unhandled_exception() noexcept
+    {
+        m_exception = std::current_exception();
+    }
+
+    //! @brief The coroutine that awaits the task, if any.
+    std::coroutine_handle<> m_continuation;
+
+    //! @brief The exception that finished the task, if any.
+    std::exception_ptr m_exception;
+};
+
+//! @brief The promise of an eprosima::fastcdr::AsyncTask that returns a value.
+template<class _T>
+class AsyncPromise : public AsyncPromiseBase
+{
+public:
+
+    void return_value(
+            _T value)
+    {
+        m_value.emplace(std::move(value));
+    }
+
+    _T result()
+    {
+        if (m_exception)
+        {
+            std::rethrow_exception(m_exception);
+        }
+
+        return std::move(*m_value);
+    }
+
+private:
+
+    std::optional<_T> m_value;
+};
+
+//! @brief The promise of an eprosima::fastcdr::AsyncTask that returns nothing.
+template<>
+class AsyncPromise<void> : public AsyncPromiseBase
+{
+public:
+
+    void return_void() const noexcept
+    {
+    }
+
+    void result()
+    {
+        if (m_exception)
+        {
+            std::rethrow_exception(m_exception);
+        }
+    }
+
+};
+
+/*!
+ * @brief This class template is the coroutine type of the asynchronous API.
+ * A task does not run until it is awaited with co_await, or started with eprosima::fastcdr::AsyncTask::start by code
+ * that is not a coroutine. When it finishes, the coroutine that awaits it is resumed in the same thread.
+ * The objects passed by reference to a task have to live until it finishes.
+ * @ingroup FASTCDRAPIREFERENCE
+ */
+template<class _T = void>
+class AsyncTask
+{
+public:
+
+    //! @brief The promise of the coroutine.
+    class promise_type : public AsyncPromise<_T>
+    {
+    public:
+
+        AsyncTask get_return_object()
+        {
+            return AsyncTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+    };
+
+    //! @brief Move constructor.
+    AsyncTask(
+            AsyncTask&& task) noexcept
+        : m_handle(std::exchange(task.m_handle, nullptr))
+    {
+    }
+
+    //! @brief Default destructor. It destroys the coroutine, which must not be running.
+    ~AsyncTask()
+    {
+        if (m_handle)
+        {
+            m_handle.destroy();
+        }
+    }
+
+    bool await_ready() const noexcept
+    {
+        return m_handle.done();
+    }
+
+    std::coroutine_handle<> await_suspend(
+            std::coroutine_handle<> continuation) noexcept
+    {
+        m_handle.promise().m_continuation = continuation;
+        return m_handle;
+    }
+
+    _T await_resume()
+    {
+        return m_handle.promise().result();
+    }
+
+    /*!
+     * @brief This function runs the task until it finishes or waits for the first time.
+     * It is used to start a task that is not awaited by another coroutine.
+     */
+    void start()
+    {
+        m_handle.resume();
+    }
+
+    /*!
+     * @brief This function returns whether the task finished.
+     * @return True if the task finished.
+     */
+    bool done() const
+    {
+        return m_handle.done();
+    }
+
+    /*!
+     * @brief This function returns the result of a finished task.
+     * @return The value returned by the task.
+     * @exception Any exception that finished the task is thrown again.
+     */
+    _T get()
+    {
+        return m_handle.promise().result();
+    }
+
+private:
+
+    explicit AsyncTask(
+            std::coroutine_handle<promise_type> handle)
+        : m_handle(handle)
+    {
+    }
+
+    AsyncTask(
+            const AsyncTask&) = delete;
+
+    AsyncTask& operator =(
+            const AsyncTask&) = delete;
+
+    std::coroutine_handle<promise_type> m_handle;
+};
+
+/*!
+ * @brief This abstract class receives the bytes serialized by an eprosima::fastcdr::AsyncSerializer.
+ * @ingroup FASTCDRAPIREFERENCE
+ */
+class AsyncSink
+{
+public:
+
+    //! @brief Default destructor.
+    virtual ~AsyncSink() = default;
+
+    /*!
+     * @brief This function writes the next bytes of the serialized stream. It can wait, for example until a socket
+     * is writable, as the serializer does not touch the bytes until the returned task finishes.
+     * @param data Pointer to the bytes.
+     * @param size Number of bytes.
+     * @return A task that returns true if all the bytes were written.
+     */
+    virtual AsyncTask<bool> write(
+            const char* data,
+            size_t size) = 0;
+};
+
+/*!
+ * @brief This abstract class provides the bytes deserialized by an eprosima::fastcdr::AsyncDeserializer.
+ * @ingroup FASTCDRAPIREFERENCE
+ */
+class AsyncSource
+{
+public:
+
+    //! @brief Default destructor.
+    virtual ~AsyncSource() = default;
+
+    /*!
+     * @brief This function reads the next bytes of the serialized stream. It can wait until some are available.
+     * @param data Pointer to the memory where the bytes are stored.
+     * @param size Maximum number of bytes.
+     * @return A task that returns the number of bytes read, or zero at the end of the stream.
+     */
+    virtual AsyncTask<size_t> read(
+            char* data,
+            size_t size) = 0;
+};
+
+/*!
+ * @brief This class serializes a stream through a fixed window that is written to an eprosima::fastcdr::AsyncSink.
+ * When the window is full, the serialization waits on the sink instead of blocking the thread or growing the buffer,
+ * so one thread can run many serializations at the same time with a bounded memory each.
+ * Each value is serialized by an eprosima::fastcdr::Cdr object in streaming mode. A value that does not fit in the
+ * rest of the window is rolled back and serialized again once the window was written. Values have to fit in the
+ * whole window, except for the arrays and sequences of primitives passed to
+ * eprosima::fastcdr::AsyncSerializer::serializeArray and eprosima::fastcdr::AsyncSerializer::serializeSequence,
+ * which are written in pieces. The bytes are the same as serializing the values with a single
+ * eprosima::fastcdr::Cdr object.
+ * @ingroup FASTCDRAPIREFERENCE
+ */
+class AsyncSerializer
+{
+public:
+
+    /*!
+     * @brief Default constructor.
+     * @param sink The sink that receives the serialized bytes.
+     * @param windowSize The number of bytes of the window.
+     * @param endianness The endianness of the stream. The default value is the endianness of the system.
+     * @param cdrType The type of CDR of the stream. The default value is DDS CDR.
+     */
+    AsyncSerializer(
+            AsyncSink& sink,
+            size_t windowSize = 64 * 1024,
+            const Cdr::Endianness endianness = Cdr::DEFAULT_ENDIAN,
+            const Cdr::CdrType cdrType = Cdr::DDS_CDR)
+        : m_sink(sink)
+        , m_window(windowSize)
+        , m_buffer(m_window.data(), m_window.size())
+        , m_cdr(m_buffer, endianness, cdrType)
+    {
+        m_cdr.setSink(&m_windowSink);
+    }
+
+    /*!
+     * @brief This function serializes the encapsulation of the stream. It has to be the first value.
+     * @return A task that finishes when the encapsulation is serialized.
+     */
+    AsyncTask<> serializeEncapsulation()
+    {
+        return write([](Cdr& cdr)
+                       {
+                           cdr.serialize_encapsulation();
+                       });
+    }
+
+    /*!
+     * @brief This function template serializes a value.
+     * @param value The value. It has to fit in the window.
+     * @return A task that finishes when the value is serialized.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when the value is larger than the
+     * window or the sink fails.
+     */
+    template<class _T>
+    AsyncTask<> serialize(
+            const _T& value)
+    {
+        return write([&value](Cdr& cdr)
+                       {
+                           cdr << value;
+                       });
+    }
+
+    /*!
+     * @brief This function template serializes an array of primitives, in pieces that fit in the window.
+     * @param array_t The array.
+     * @param numElements Number of the elements in the array.
+     * @return A task that finishes when the array is serialized.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when the sink fails.
+     */
+    template<class _T>
+    AsyncTask<> serializeArray(
+            const _T* array_t,
+            size_t numElements)
+    {
+        static_assert(std::is_arithmetic<_T>::value && !std::is_same<_T, bool>::value &&
+                !std::is_same<_T, long double>::value && !std::is_same<_T, wchar_t>::value,
+                "Only arrays of primitives whose size in memory is their serialized size are supported");
+
+        while (numElements > 0)
+        {
+            // Only the first piece is aligned, and never by more than the size of an element minus one.
+            size_t available = m_window.size() - m_cdr.getSerializedDataLength();
+            size_t count = available >= 2 * sizeof(_T) ? (available - sizeof(_T) + 1) / sizeof(_T) : 0;
+            count = count < numElements ? count : numElements;
+
+            if ((count == 0) || !tryWrite([array_t, count](Cdr& cdr)
+                    {
+                        cdr.serializeArray(array_t, count);
+                    }))
+            {
+                co_await flush();
+                continue;
+            }
+
+            array_t += count;
+            numElements -= count;
+        }
+    }
+
+    /*!
+     * @brief This function template serializes a sequence. The elements of a sequence of primitives whose size in
+     * memory is their serialized size are written in pieces, and any other element has to fit in the window.
+     * @param vector_t The sequence.
+     * @return A task that finishes when the sequence is serialized.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when an element is larger than the
+     * window or the sink fails.
+     */
+    template<class _T>
+    AsyncTask<> serializeSequence(
+            const std::vector<_T>& vector_t)
+    {
+        uint32_t length = size_to_uint32(vector_t.size());
+        co_await serialize(length);
+
+        if constexpr (std::is_arithmetic<_T>::value && !std::is_same<_T, bool>::value &&
+                !std::is_same<_T, long double>::value && !std::is_same<_T, wchar_t>::value)
+        {
+            co_await serializeArray(vector_t.data(), vector_t.size());
+        }
+        else
+        {
+            for (const _T& element : vector_t)
+            {
+                co_await serialize(element);
+            }
+        }
+    }
+
+    /*!
+     * @brief This function writes the bytes serialized in the window to the sink.
+     * It must be awaited once the serialization finishes, to write the last bytes.
+     * @return A task that finishes when the bytes are written.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when the sink fails.
+     */
+    AsyncTask<> flush()
+    {
+        size_t length = m_cdr.getSerializedDataLength();
+
+        if (length > 0)
+        {
+            if (!co_await m_sink.write(m_window.data(), length))
+            {
+                throw exception::NotEnoughMemoryException(
+                          exception::NotEnoughMemoryException::NOT_ENOUGH_MEMORY_MESSAGE_DEFAULT);
+            }
+
+            // The window restarts keeping the alignment of the stream. It is zeroed, as padding is not written and
+            // would otherwise repeat the bytes of the previous window.
+            m_windowSink.m_written = true;
+            m_cdr.flush();
+            m_windowSink.m_written = false;
+            memset(m_window.data(), 0, length);
+        }
+    }
+
+    /*!
+     * @brief This function returns the number of bytes serialized so far.
+     * @return The length of the stream, including the bytes still in the window.
+     */
+    size_t getSerializedDataLength() const
+    {
+        return m_cdr.getFlushedBytes() + m_cdr.getSerializedDataLength();
+    }
+
+private:
+
+    AsyncSerializer(
+            const AsyncSerializer&) = delete;
+
+    AsyncSerializer& operator =(
+            const AsyncSerializer&) = delete;
+
+    /*!
+     * @brief The sink of the eprosima::fastcdr::Cdr object. It lets the window restart only once it was written to
+     * the asynchronous sink, so the serialization of a value that does not fit fails instead of blocking.
+     */
+    class WindowSink : public CdrSink
+    {
+    public:
+
+        bool write(
+                const char*,
+                size_t) override
+        {
+            return m_written;
+        }
+
+        bool m_written = false;
+    };
+
+    /*!
+     * @brief This function template serializes into the window, rolling back if it does not fit.
+     * @param function The function that serializes into an eprosima::fastcdr::Cdr object.
+     * @return True if it fitted, false if the window has to be written first.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when it does not fit in an empty window.
+     */
+    template<class _Function>
+    bool tryWrite(
+            _Function function)
+    {
+        Cdr::state state(m_cdr);
+        size_t flushed = m_cdr.getFlushedBytes();
+
+        try
+        {
+            function(m_cdr);
+        }
+        catch (exception::NotEnoughMemoryException&)
+        {
+            // Part of the value already went to the sink, so it cannot be written again later.
+            if (m_cdr.getFlushedBytes() != flushed)
+            {
+                throw;
+            }
+
+            m_cdr.setState(state);
+
+            if (m_cdr.getSerializedDataLength() == 0)
+            {
+                throw;
+            }
+
+            return false;
+        }
+
+        return true;
+    }
+
+    /*!
+     * @brief This function template serializes into the window, writing the window first if it does not fit.
+     * @param function The function that serializes into an eprosima::fastcdr::Cdr object.
+     * @return A task that finishes when the function ran.
+     */
+    template<class _Function>
+    AsyncTask<> write(
+            _Function function)
+    {
+        while (!tryWrite(function))
+        {
+            co_await flush();
+        }
+    }
+
+    AsyncSink& m_sink;
+
+    //! @brief The memory of the window.
+    std::vector<char> m_window;
+
+    FastBuffer m_buffer;
+
+    WindowSink m_windowSink;
+
+    Cdr m_cdr;
+};
+
+/*!
+ * @brief This class deserializes a stream read from an eprosima::fastcdr::AsyncSource.
+ * When the bytes received are not enough for a value, the deserialization waits on the source instead of blocking
+ * the thread, so one thread can run many deserializations at the same time.
+ * The bytes are kept by an eprosima::fastcdr::ResumableDeserializer, so only those of the value in progress are in
+ * memory, and sequences of primitives are deserialized in pieces as they arrive.
+ * @ingroup FASTCDRAPIREFERENCE
+ */
+class AsyncDeserializer
+{
+public:
+
+    /*!
+     * @brief Default constructor.
+     * @param source The source that provides the serialized bytes.
+     * @param chunkSize The maximum number of bytes read from the source at a time.
+     * @param endianness The endianness of the stream when it has no encapsulation. The default value is the
+     * endianness of the system.
+     * @param cdrType The type of CDR of the stream. The default value is DDS CDR.
+     */
+    AsyncDeserializer(
+            AsyncSource& source,
+            size_t chunkSize = 64 * 1024,
+            const Cdr::Endianness endianness = Cdr::DEFAULT_ENDIAN,
+            const Cdr::CdrType cdrType = Cdr::DDS_CDR)
+        : m_source(source)
+        , m_chunk(chunkSize)
+        , m_deserializer(endianness, cdrType)
+    {
+    }
+
+    /*!
+     * @brief This function sets the limits checked on the lengths read while deserializing.
+     * @param limits The new limits.
+     */
+    void setDeserializationLimits(
+            const Cdr::DeserializationLimits& limits)
+    {
+        m_limits = limits;
+        m_deserializer.setDeserializationLimits(limits);
+    }
+
+    /*!
+     * @brief This function reads the encapsulation of the stream. It has to be the first value if the stream has one.
+     * @return A task that finishes when the encapsulation is read.
+     * @exception exception::BadParamException This exception is thrown when the encapsulation is not valid.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when the stream ends.
+     */
+    AsyncTask<> readEncapsulation()
+    {
+        while (!m_deserializer.readEncapsulation())
+        {
+            co_await receive();
+        }
+    }
+
+    /*!
+     * @brief This function template deserializes a value.
+     * @param value The variable that will store the value.
+     * @return A task that finishes when the value is deserialized.
+     * @exception exception::BadParamException This exception is thrown when the value is not valid.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when the stream ends.
+     */
+    template<class _T>
+    AsyncTask<> deserialize(
+            _T& value)
+    {
+        while (!m_deserializer.deserialize(value))
+        {
+            co_await receive();
+        }
+    }
+
+    /*!
+     * @brief This function template deserializes a sequence. A sequence of primitives is deserialized in pieces as
+     * its bytes arrive, and any other element one by one.
+     * @param vector_t The vector that will store the sequence.
+     * @return A task that finishes when the sequence is deserialized.
+     * @exception exception::BadParamException This exception is thrown when the length exceeds the deserialization limits.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when the stream ends.
+     */
+    template<class _T>
+    AsyncTask<> deserializeSequence(
+            std::vector<_T>& vector_t)
+    {
+        if constexpr (std::is_arithmetic<_T>::value && !std::is_same<_T, bool>::value &&
+                !std::is_same<_T, long double>::value && !std::is_same<_T, wchar_t>::value)
+        {
+            while (!m_deserializer.deserializeSequence(vector_t))
+            {
+                co_await receive();
+            }
+        }
+        else
+        {
+            uint32_t length = 0;
+            co_await deserialize(length);
+
+            if ((length > m_limits.maxSequenceElements) || (length > m_limits.maxTotalAllocation / sizeof(_T)))
+            {
+                throw exception::BadParamException("Sequence length exceeds the deserialization limits");
+            }
+
+            // The vector grows as the elements arrive, so a corrupted length fails when the stream ends instead of
+            // allocating all the elements at once.
+            vector_t.clear();
+
+            for (uint32_t count = 0; count < length; ++count)
+            {
+                // The element is not deserialized in place, as the elements of std::vector<bool> are not addressable.
+                _T element{};
+                co_await deserialize(element);
+                vector_t.push_back(std::move(element));
+            }
+        }
+    }
+
+    /*!
+     * @brief This function returns the number of bytes of the stream deserialized so far.
+     * @return The offset of the next value in the stream.
+     */
+    size_t getConsumedBytes() const
+    {
+        return m_deserializer.getConsumedBytes();
+    }
+
+private:
+
+    AsyncDeserializer(
+            const AsyncDeserializer&) = delete;
+
+    AsyncDeserializer& operator =(
+            const AsyncDeserializer&) = delete;
+
+    /*!
+     * @brief This function reads the next bytes from the source.
+     * @return A task that finishes when some bytes were read.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when the stream ends.
+     */
+    AsyncTask<> receive()
+    {
+        size_t size = co_await m_source.read(m_chunk.data(), m_chunk.size());
+
+        if (size == 0)
+        {
+            throw exception::NotEnoughMemoryException(
+                      exception::NotEnoughMemoryException::NOT_ENOUGH_MEMORY_MESSAGE_DEFAULT);
+        }
+
+        m_deserializer.feed(m_chunk.data(), size);
+    }
+
+    AsyncSource& m_source;
+
+    //! @brief The memory where the bytes are read.
+    std::vector<char> m_chunk;
+
+    ResumableDeserializer m_deserializer;
+
+    Cdr::DeserializationLimits m_limits;
+};
+
+} //namespace fastcdr
+} //namespace eprosima
+
+#endif // _FASTCDR_ASYNCCDR_H_
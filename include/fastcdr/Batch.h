@@ -0,0 +1,373 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _FASTCDR_BATCH_H_
+#define _FASTCDR_BATCH_H_
+
+#include "fastcdr_dll.h"
+#include "Cdr.h"
+#include "exceptions/Exception.h"
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace eprosima {
+namespace fastcdr {
+
+class ThreadPool;
+
+/*!
+ * @brief This class serializes many messages back to back in one buffer.
+ * Each message is framed by its length, a 32-bit unsigned integer aligned to 4 bytes from the beginning of the
+ * buffer and serialized with the endianness of the batch. The message follows, with its own encapsulation when the
+ * CDR type is DDS CDR, and aligned from its own beginning as if it was serialized alone.
+ * @ingroup FASTCDRAPIREFERENCE
+ */
+class Cdr_DllAPI BatchWriter
+{
+public:
+
+    /*!
+     * @brief Default constructor.
+     * @param buffer The buffer where the batch is serialized.
+     * @param endianness The endianness of the batch. The default value is the endianness of the system.
+     * @param cdrType The type of CDR of the messages. The default value is DDS CDR, with an encapsulation per message.
+     */
+    BatchWriter(
+            FastBuffer& buffer,
+            const Cdr::Endianness endianness = Cdr::DEFAULT_ENDIAN,
+            const Cdr::CdrType cdrType = Cdr::DDS_CDR);
+
+    /*!
+     * @brief This function starts a new message.
+     * @return Reference to the eprosima::fastcdr::Cdr object where the message has to be serialized.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when the frame exceeds the internal memory size.
+     * @exception exception::BadParamException This exception is thrown when the previous message was not ended.
+     */
+    Cdr& beginMessage();
+
+    /*!
+     * @brief This function ends the current message, writing its length in the frame.
+     * @return Reference to the eprosima::fastcdr::BatchWriter object.
+     * @exception exception::BadParamException This exception is thrown when there is no message in progress.
+     */
+    BatchWriter& endMessage();
+
+    /*!
+     * @brief This function discards the current message, leaving the batch as before beginMessage.
+     */
+    void abortMessage();
+
+    /*!
+     * @brief This function template serializes a message in a new frame.
+     * If the serialization fails, the message is discarded and the batch is left as before.
+     * @param message The message that will be serialized.
+     * @return Reference to the eprosima::fastcdr::BatchWriter object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when the message exceeds the internal memory size.
+     */
+    template<class _T>
+    BatchWriter& add(
+            const _T& message)
+    {
+        Cdr& cdr = beginMessage();
+
+        try
+        {
+            cdr << message;
+        }
+        catch (exception::Exception& ex)
+        {
+            abortMessage();
+            ex.raise();
+        }
+
+        return endMessage();
+    }
+
+    /*!
+     * @brief This function returns the number of messages in the batch.
+     * @return The number of ended messages.
+     */
+    size_t getMessageCount() const
+    {
+        return m_messageCount;
+    }
+
+    /*!
+     * @brief This function returns the length of the serialized batch.
+     * @return The length of the serialized batch.
+     */
+    size_t getSerializedDataLength() const
+    {
+        return m_cdr.getSerializedDataLength();
+    }
+
+    /*!
+     * @brief This function discards every message and starts a new batch in the same buffer.
+     */
+    void reset();
+
+private:
+
+    BatchWriter(
+            const BatchWriter&) = delete;
+
+    BatchWriter& operator =(
+            const BatchWriter&) = delete;
+
+    //! @brief The object that serializes the batch.
+    Cdr m_cdr;
+
+    //! @brief The endianness of the batch.
+    Cdr::Endianness m_endianness;
+
+    //! @brief The type of CDR of the messages.
+    Cdr::CdrType m_cdrType;
+
+    //! @brief True while a message is in progress.
+    bool m_inMessage;
+
+    //! @brief The position where the frame of the message in progress starts, before its padding.
+    size_t m_frameOffset;
+
+    //! @brief The position of the length of the message in progress.
+    size_t m_lengthOffset;
+
+    //! @brief The number of ended messages.
+    size_t m_messageCount;
+};
+
+/*!
+ * @brief This class iterates over the messages of a batch serialized by eprosima::fastcdr::BatchWriter.
+ * Messages are deserialized in place from the batch buffer.
+ * @ingroup FASTCDRAPIREFERENCE
+ */
+class Cdr_DllAPI BatchReader
+{
+public:
+
+    /*!
+     * @brief Default constructor.
+     * @param data Pointer to the serialized batch.
+     * @param size Length of the serialized batch.
+     * @param endianness The endianness of the batch. The default value is the endianness of the system.
+     * @param cdrType The type of CDR of the messages. The default value is DDS CDR, with an encapsulation per message.
+     */
+    BatchReader(
+            char* data,
+            size_t size,
+            const Cdr::Endianness endianness = Cdr::DEFAULT_ENDIAN,
+            const Cdr::CdrType cdrType = Cdr::DDS_CDR);
+
+    /*!
+     * @brief This function moves to the next message, reading its encapsulation if it has one.
+     * @return True if there is a next message, false at the end of the batch.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when the frame exceeds the batch.
+     * @exception exception::BadParamException This exception is thrown when the encapsulation is not valid.
+     */
+    bool next();
+
+    /*!
+     * @brief This function returns the object that deserializes the current message.
+     * It cannot read beyond the end of the message.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     */
+    Cdr& getMessage()
+    {
+        return m_message;
+    }
+
+    /*!
+     * @brief This function returns the serialized bytes of the current message, including its encapsulation.
+     * @return Pointer to the message in the batch buffer.
+     */
+    const char* getMessageData() const
+    {
+        return m_messageBuffer.getBuffer();
+    }
+
+    /*!
+     * @brief This function returns the length of the current message, including its encapsulation.
+     * @return The length of the message.
+     */
+    size_t getMessageSize() const
+    {
+        return m_messageBuffer.getBufferSize();
+    }
+
+private:
+
+    BatchReader(
+            const BatchReader&) = delete;
+
+    BatchReader& operator =(
+            const BatchReader&) = delete;
+
+    //! @brief Pointer to the serialized batch.
+    char* m_data;
+
+    //! @brief Length of the serialized batch.
+    size_t m_size;
+
+    //! @brief Position of the next frame.
+    size_t m_offset;
+
+    //! @brief The endianness of the batch.
+    Cdr::Endianness m_endianness;
+
+    //! @brief The type of CDR of the messages.
+    Cdr::CdrType m_cdrType;
+
+    //! @brief A buffer over the current message, without copying it.
+    FastBuffer m_messageBuffer;
+
+    //! @brief The object that deserializes the current message.
+    Cdr m_message;
+};
+
+/*!
+ * @brief This class deserializes many independent messages in parallel.
+ * The messages are split in ranges, one per thread of the pool plus the calling thread. Each thread deserializes the
+ * messages of its range from the front and, once it is empty, steals the back half of the range of another thread,
+ * so a few slow messages do not leave the other threads idle.
+ * Each thread deserializes through its own eprosima::fastcdr::Cdr object, kept from one batch to the next.
+ * A message that fails does not stop the others. Its exception is kept until the next batch.
+ * @ingroup FASTCDRAPIREFERENCE
+ */
+class Cdr_DllAPI BatchDeserializer
+{
+public:
+
+    //! @brief A serialized message.
+    struct Message
+    {
+        //! @brief Pointer to the serialized message.
+        char* data;
+
+        //! @brief Length of the serialized message.
+        size_t length;
+    };
+
+    //! @brief The function that deserializes a message. It receives the index of the message in the batch.
+    typedef std::function<void (Cdr&, size_t)> Function;
+
+    /*!
+     * @brief Default constructor.
+     * @param pool The thread pool that deserializes the messages.
+     * @param endianness The endianness of the messages without encapsulation. The default value is the endianness of the system.
+     * @param cdrType The type of CDR of the messages. The default value is DDS CDR, with an encapsulation per message.
+     */
+    BatchDeserializer(
+            ThreadPool& pool,
+            const Cdr::Endianness endianness = Cdr::DEFAULT_ENDIAN,
+            const Cdr::CdrType cdrType = Cdr::DDS_CDR);
+
+    //! @brief Default destructor.
+    ~BatchDeserializer();
+
+    /*!
+     * @brief This function sets the limits checked on the lengths read while deserializing each message.
+     * @param limits The deserialization limits.
+     */
+    void setDeserializationLimits(
+            const Cdr::DeserializationLimits& limits);
+
+    /*!
+     * @brief This function deserializes a batch of messages.
+     * The encapsulation of each message is read before calling the function, when the CDR type is DDS CDR.
+     * @param messages The messages.
+     * @param numMessages The number of messages.
+     * @param deserializeMessage The function that deserializes each message. It is called from several threads at
+     * the same time, each one with a different message.
+     * @return The number of messages that failed.
+     * @exception exception::BadParamException This exception is thrown when there are more than 2^32 - 1 messages.
+     */
+    size_t deserialize(
+            const Message* messages,
+            size_t numMessages,
+            const Function& deserializeMessage);
+
+    /*!
+     * @brief This function template deserializes a batch of messages into an array of values.
+     * @param messages The messages.
+     * @param numMessages The number of messages.
+     * @param values The array where each message is deserialized, in the order of the messages.
+     * @return The number of messages that failed.
+     * @exception exception::BadParamException This exception is thrown when there are more than 2^32 - 1 messages.
+     */
+    template<class _T>
+    size_t deserialize(
+            const Message* messages,
+            size_t numMessages,
+            _T* values)
+    {
+        return deserialize(messages, numMessages, [values](Cdr& cdr, size_t index)
+                       {
+                           cdr >> values[index];
+                       });
+    }
+
+    /*!
+     * @brief This function returns the exception thrown while deserializing a message of the last batch.
+     * @param index The index of the message.
+     * @return The exception, or a null pointer if the message was deserialized.
+     * @exception exception::BadParamException This exception is thrown when the index is out of range.
+     */
+    const std::exception_ptr& getError(
+            size_t index) const;
+
+private:
+
+    BatchDeserializer(
+            const BatchDeserializer&) = delete;
+
+    BatchDeserializer& operator =(
+            const BatchDeserializer&) = delete;
+
+    //! @brief The state of a thread deserializing the batch.
+    struct Worker;
+
+    /*!
+     * @brief This function deserializes messages of the batch until none is left.
+     * @param worker The index of the thread.
+     * @param messages The messages.
+     * @param deserializeMessage The function that deserializes each message.
+     */
+    void work(
+            size_t worker,
+            const Message* messages,
+            const Function& deserializeMessage);
+
+    //! @brief The thread pool that deserializes the messages.
+    ThreadPool& m_pool;
+
+    //! @brief The state of each thread.
+    std::vector<std::unique_ptr<Worker>> m_workers;
+
+    //! @brief The exception of each message of the last batch.
+    std::vector<std::exception_ptr> m_errors;
+
+    //! @brief The number of messages of the last batch that failed.
+    std::atomic<size_t> m_errorCount;
+
+    //! @brief The type of CDR of the messages.
+    Cdr::CdrType m_cdrType;
+};
+
+} //namespace fastcdr
+} //namespace eprosima
+
+#endif // _FASTCDR_BATCH_H_
@@ -0,0 +1,203 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _FASTCDR_BUFFERPOOL_H_
+#define _FASTCDR_BUFFERPOOL_H_
+
+#include "fastcdr_dll.h"
+#include "FastBuffer.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace eprosima {
+namespace fastcdr {
+/*!
+ * @brief This class keeps the memory of released eprosima::fastcdr::FastBuffer objects to reuse it, and can be used
+ * from any thread. A buffer can be released by a different thread than the one that acquired it.
+ * Buffers are grouped in size classes, powers of two from 256 bytes. Each processor has a cache with a magazine of
+ * buffers per class, so most calls only take an uncontended flag. Full and empty magazines are exchanged with a
+ * global depot of lock-free stacks, so the memory released on one processor can be acquired on another.
+ * The memory kept by the pool is bounded. Buffers released beyond the bound are freed.
+ * On machines with several NUMA nodes, the caches and the depot are kept per node, so a thread only acquires memory of
+ * its own node. Large buffers are allocated on the node of the calling thread, and go back to the depot of the node
+ * that holds their memory when they are released on another one. Smaller buffers are assumed to be on the node where
+ * they are released.
+ * @ingroup FASTCDRAPIREFERENCE
+ */
+class Cdr_DllAPI BufferPool
+{
+public:
+
+    /*!
+     * @brief Default constructor.
+     * @param maxRetainedBytes The maximum number of bytes kept by the pool.
+     * @param maxBufferSize The size of the largest class. It is rounded up to a power of two. Larger buffers are allocated and freed directly.
+     * @param numCaches The number of processor caches. By default, one per hardware thread. They are split among the
+     * NUMA nodes, with one per node at least.
+     */
+    BufferPool(
+            size_t maxRetainedBytes = 64 * 1024 * 1024,
+            size_t maxBufferSize = 16 * 1024 * 1024,
+            size_t numCaches = 0);
+
+    //! @brief Default destructor. The memory kept by the pool is freed.
+    ~BufferPool();
+
+    /*!
+     * @brief This function returns a buffer with a given capacity.
+     * @param size The minimum capacity of the buffer. Within the classes, it is rounded up to the size of its class.
+     * @return The buffer, which owns its memory and can grow as a default constructed eprosima::fastcdr::FastBuffer.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when the memory cannot be allocated.
+     */
+    FastBuffer acquire(
+            size_t size);
+
+    /*!
+     * @brief This function takes the memory of a buffer to reuse it. The buffer is left empty.
+     * Buffers that do not own their memory are left unchanged.
+     * @param buffer The buffer.
+     */
+    void release(
+            FastBuffer& buffer);
+
+    /*!
+     * @brief This function returns the number of bytes kept by the pool.
+     * @return The number of bytes of the buffers waiting to be acquired.
+     */
+    size_t getRetainedBytes() const
+    {
+        return m_retainedBytes.load(std::memory_order_relaxed);
+    }
+
+private:
+
+    BufferPool(
+            const BufferPool&) = delete;
+
+    BufferPool& operator =(
+            const BufferPool&) = delete;
+
+    //! @brief A set of buffers of the same class.
+    struct Magazine;
+
+    //! @brief The magazines of a processor.
+    struct Cache;
+
+    /*!
+     * @brief This function returns a magazine.
+     * @param index The index of the magazine.
+     * @return Reference to the magazine.
+     */
+    Magazine& getMagazine(
+            uint32_t index) const;
+
+    /*!
+     * @brief This function creates an empty magazine.
+     * @return The index of the magazine, or an invalid index when the maximum number of magazines is reached.
+     */
+    uint32_t newMagazine();
+
+    /*!
+     * @brief This function pushes a magazine on a stack of the depot.
+     * @param stack The stack.
+     * @param index The index of the magazine.
+     */
+    void push(
+            std::atomic<uint64_t>& stack,
+            uint32_t index);
+
+    /*!
+     * @brief This function pops a magazine from a stack of the depot.
+     * @param stack The stack.
+     * @return The index of the magazine, or an invalid index if the stack is empty.
+     */
+    uint32_t pop(
+            std::atomic<uint64_t>& stack);
+
+    /*!
+     * @brief This function returns the cache of the processor running the calling thread.
+     * @param node The NUMA node of the processor is returned here.
+     * @return Reference to the cache.
+     */
+    Cache& getCache(
+            size_t& node);
+
+    /*!
+     * @brief This function returns the depot stacks of a class in a NUMA node.
+     * @param node The node.
+     * @param classIndex The class.
+     * @return The index of the stacks in eprosima::fastcdr::BufferPool::m_fullMagazines and
+     * eprosima::fastcdr::BufferPool::m_emptyMagazines.
+     */
+    size_t getDepot(
+            size_t node,
+            size_t classIndex) const
+    {
+        return node * m_numClasses + classIndex;
+    }
+
+    /*!
+     * @brief This function keeps a block in the depot of a NUMA node, alone in a magazine.
+     * @param block The memory of the buffer.
+     * @param depot The index of the depot stacks.
+     * @return True if the block was kept.
+     */
+    bool keepInDepot(
+            char* block,
+            size_t depot);
+
+    /*!
+     * @brief This function takes a block from a full magazine of the depot of a NUMA node.
+     * @param depot The index of the depot stacks.
+     * @return The memory of the buffer, or nullptr if the depot has no full magazine.
+     */
+    char* takeFromDepot(
+            size_t depot);
+
+    //! @brief The maximum number of bytes kept by the pool.
+    size_t m_maxRetainedBytes;
+
+    //! @brief The number of size classes.
+    size_t m_numClasses;
+
+    //! @brief The number of NUMA nodes.
+    size_t m_numNodes;
+
+    //! @brief The number of processor caches of each NUMA node.
+    size_t m_cachesPerNode;
+
+    //! @brief The number of bytes kept by the pool.
+    std::atomic<size_t> m_retainedBytes;
+
+    //! @brief The segments where the magazines are created. They are never freed before the pool.
+    std::unique_ptr<std::atomic<Magazine*>[]> m_segments;
+
+    //! @brief The number of magazines created.
+    std::atomic<uint32_t> m_magazineCount;
+
+    //! @brief The stack of full magazines of each class and NUMA node, in the depot.
+    std::unique_ptr<std::atomic<uint64_t>[]> m_fullMagazines;
+
+    //! @brief The stack of empty magazines of each class and NUMA node, in the depot.
+    std::unique_ptr<std::atomic<uint64_t>[]> m_emptyMagazines;
+
+    //! @brief The caches of each NUMA node, one after the other.
+    std::vector<std::unique_ptr<Cache>> m_caches;
+};
+
+} //namespace fastcdr
+} //namespace eprosima
+
+#endif // _FASTCDR_BUFFERPOOL_H_
@@ -18,11 +18,23 @@
 #include "fastcdr_dll.h"
 #include "FastBuffer.h"
 #include "exceptions/NotEnoughMemoryException.h"
+#include "exceptions/BadParamException.h"
+#include "Arena.h"
 #include <stdint.h>
 #include <string>
 #include <vector>
 #include <map>
+#include <unordered_map>
+#include <set>
+#include <unordered_set>
+#include <deque>
+#include <tuple>
+#include <iterator>
 #include <iostream>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include <utility>
 
 #if !__APPLE__ && !__FreeBSD__ && !__VXWORKS__
 #include <malloc.h>
@@ -36,6 +48,16 @@
 
 namespace eprosima {
 namespace fastcdr {
+
+class BatchWriter;
+class CdrIndex;
+class CdrSink;
+class CdrTranscoder;
+class CdrView;
+class GatherList;
+class ThreadPool;
+class TypeDescriptor;
+
 /*!
  * @brief This class offers an interface to serialize/deserialize some basic types using CDR protocol inside an eprosima::fastcdr::FastBuffer.
  * @ingroup FASTCDRAPIREFERENCE
@@ -122,6 +144,36 @@ public:
 
         //! @brief Stores the last datasize serialized/deserialized when the state was created.
         size_t m_lastDataSize;
+
+        //! @brief The number of bytes flushed to the sink when the state was created.
+        size_t m_flushedBytes;
+
+        //! @brief The number of bytes allocated while deserializing when the state was created.
+        size_t m_allocatedBytes;
+
+        //! @brief The number of arrays in the gather list when the state was created.
+        size_t m_externalCount;
+    };
+
+    /*!
+     * @brief This structure holds the limits checked, before allocating any memory, on the lengths read while deserializing.
+     * Every limit defaults to the maximum value, which disables it.
+     */
+    struct Cdr_DllAPI DeserializationLimits
+    {
+        /*!
+         * @brief Default constructor. No limit is applied.
+         */
+        DeserializationLimits();
+
+        //! @brief Maximum number of elements of a sequence, set or map.
+        size_t maxSequenceElements;
+
+        //! @brief Maximum number of bytes of a string or wide-string.
+        size_t maxStringBytes;
+
+        //! @brief Maximum number of bytes allocated for the sequences and strings of a message, until the next call to reset().
+        size_t maxTotalAllocation;
     };
 
     /*!
@@ -198,17 +250,127 @@ public:
 
     /*!
      * @brief This function skips a number of bytes in the CDR stream buffer.
+     * The next value is always aligned, as the number of bytes may not be a multiple of its size.
      * @param numBytes The number of bytes that will be jumped.
      * @return True is returned when it works successfully. Otherwise, false is returned.
      */
     bool jump(
             size_t numBytes);
 
+    /*!
+     * @brief This function skips a serialized value without deserializing it.
+     * Only the lengths of strings and sequences are read. Sequences and arrays of primitives are skipped at once.
+     * @param type The descriptor of the value.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when the value exceeds the internal memory size.
+     */
+    Cdr& skip(
+            const TypeDescriptor& type);
+
+    /*!
+     * @brief This function template skips a serialized value of a type without deserializing it.
+     * Primitives, strings, wide-strings, sequences, arrays, maps, sets and deques are skipped reading only their
+     * lengths.
+     * A user type is skipped with its static function skip(eprosima::fastcdr::Cdr&) if it has one. Otherwise it is
+     * deserialized into a temporary object.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when the value exceeds the internal memory size.
+     */
+    template<class _T>
+    Cdr& skip()
+    {
+        skipValue(static_cast<_T*>(nullptr));
+        return *this;
+    }
+
     /*!
      * @brief This function resets the current position in the buffer to the beginning.
+     * It also starts a new count of the memory allocated while deserializing.
+     * The end of the buffer is read again, so the object can be reused after the buffer was replaced.
      */
     void reset();
 
+    /*!
+     * @brief This function sets the limits checked on the lengths read while deserializing.
+     * @param limits The new limits.
+     */
+    void setDeserializationLimits(
+            const DeserializationLimits& limits);
+
+    /*!
+     * @brief This function returns the limits checked on the lengths read while deserializing.
+     * @return The current limits.
+     */
+    const DeserializationLimits& getDeserializationLimits() const;
+
+    /*!
+     * @brief This function sets the gather list that records the arrays referenced instead of copied.
+     * While a gather list is set, arrays of primitives whose size reaches its threshold and that do not need
+     * swapping are not copied into the buffer. Only their alignment is written.
+     * @param gatherList The gather list, or nullptr to copy every array again.
+     */
+    void setGatherList(
+            GatherList* gatherList);
+
+    /*!
+     * @brief This function returns the gather list set in this object.
+     * @return The gather list, or nullptr if none is set.
+     */
+    GatherList* getGatherList() const;
+
+    /*!
+     * @brief This function sets the sink that receives the serialized bytes in streaming mode.
+     * While a sink is set, the buffer is used as a fixed window: it is never resized, and when it fills the
+     * serialized bytes are flushed to the sink. Arrays and strings longer than the window are written in pieces,
+     * so the memory used is bounded by the size of the buffer whatever the size of the message.
+     * Alignment is computed on the whole stream. States can only be set again within the window they were created in,
+     * so a value whose serialization fails after part of it was flushed cannot be rolled back.
+     * A gather list must not be used in streaming mode.
+     * @param sink The sink, or nullptr to grow the buffer again.
+     */
+    void setSink(
+            CdrSink* sink);
+
+    /*!
+     * @brief This function returns the sink set in this object.
+     * @return The sink, or nullptr if none is set.
+     */
+    CdrSink* getSink() const;
+
+    /*!
+     * @brief This function sets the thread pool that copies large arrays of basic types.
+     * While a pool is set, arrays of chars, integers, floats and doubles whose size reaches the threshold are split in
+     * chunks that the threads of the pool copy, or swap, at the same time. The bytes are the same as without a pool.
+     * @param pool The thread pool, or nullptr to copy every array in the calling thread.
+     * @param threshold The minimum number of bytes of the arrays copied in parallel.
+     */
+    void setThreadPool(
+            ThreadPool* pool,
+            size_t threshold = 4 * 1024 * 1024);
+
+    /*!
+     * @brief This function returns the thread pool set in this object.
+     * @return The thread pool, or nullptr if none is set.
+     */
+    ThreadPool* getThreadPool() const;
+
+    /*!
+     * @brief This function flushes the bytes serialized in the window to the sink.
+     * It must be called once the serialization finishes, to write the last bytes.
+     * @return True if the bytes were written, false if there is no sink or it failed.
+     */
+    bool flush();
+
+    /*!
+     * @brief This function returns the number of bytes flushed to the sink since the last reset.
+     * The length of the serialized stream is this value plus eprosima::fastcdr::Cdr::getSerializedDataLength.
+     * @return The number of bytes flushed.
+     */
+    inline size_t getFlushedBytes() const
+    {
+        return m_flushedBytes;
+    }
+
     /*!
      * @brief This function returns the pointer to the current used buffer.
      * @return Pointer to the starting position of the buffer.
@@ -252,6 +414,7 @@ public:
     /*!
      * @brief This function sets a previous state of the CDR serialization process;
      * @param state Previous state that will be set.
+     * @exception exception::BadParamException This exception is thrown when the state was created before the last flush to the sink.
      */
     void setState(
             state& state);
@@ -517,6 +680,32 @@ public:
         return serialize<_T>(vector_t);
     }
 
+    /*!
+     * @brief This operator template is used to serialize sequences using a custom allocator.
+     * @param vector_t The sequence that will be serialized in the buffer.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize a position that exceeds the internal memory size.
+     */
+    template<class _T, template<class> class _Alloc>
+    inline Cdr& operator <<(
+            const std::vector<_T, _Alloc<_T>>& vector_t)
+    {
+        return serialize(vector_t);
+    }
+
+    /*!
+     * @brief This operator template is used to serialize strings using a custom allocator.
+     * @param string_t The string that will be serialized in the buffer.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize a position that exceeds the internal memory size.
+     */
+    template<template<class> class _Alloc>
+    inline Cdr& operator <<(
+            const std::basic_string<char, std::char_traits<char>, _Alloc<char>>& string_t)
+    {
+        return serialize(string_t);
+    }
+
     /*!
      * @brief This operator template is used to serialize maps.
      * @param map_t The map that will be serialized in the buffer.
@@ -530,6 +719,58 @@ public:
         return serialize<_K, _T>(map_t);
     }
 
+    /*!
+     * @brief This operator template is used to serialize unordered maps.
+     * @param map_t The unordered map that will be serialized in the buffer.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize a position that exceeds the internal memory size.
+     */
+    template<class _K, class _T>
+    inline Cdr& operator <<(
+            const std::unordered_map<_K, _T>& map_t)
+    {
+        return serialize(map_t);
+    }
+
+    /*!
+     * @brief This operator template is used to serialize sets.
+     * @param set_t The set that will be serialized in the buffer.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize a position that exceeds the internal memory size.
+     */
+    template<class _T>
+    inline Cdr& operator <<(
+            const std::set<_T>& set_t)
+    {
+        return serialize(set_t);
+    }
+
+    /*!
+     * @brief This operator template is used to serialize unordered sets.
+     * @param set_t The unordered set that will be serialized in the buffer.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize a position that exceeds the internal memory size.
+     */
+    template<class _T>
+    inline Cdr& operator <<(
+            const std::unordered_set<_T>& set_t)
+    {
+        return serialize(set_t);
+    }
+
+    /*!
+     * @brief This operator template is used to serialize deques.
+     * @param deque_t The deque that will be serialized in the buffer.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize a position that exceeds the internal memory size.
+     */
+    template<class _T>
+    inline Cdr& operator <<(
+            const std::deque<_T>& deque_t)
+    {
+        return serialize(deque_t);
+    }
+
     /*!
      * @brief This operator template is used to serialize any other non-basic type.
      * @param type_t A reference to the object that will be serialized in the buffer.
@@ -782,6 +1023,32 @@ public:
         return deserialize<_T>(vector_t);
     }
 
+    /*!
+     * @brief This operator template is used to deserialize sequences using a custom allocator.
+     * @param vector_t The variable that will store the sequence read from the buffer.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize a position that exceeds the internal memory size.
+     */
+    template<class _T, template<class> class _Alloc>
+    inline Cdr& operator >>(
+            std::vector<_T, _Alloc<_T>>& vector_t)
+    {
+        return deserialize(vector_t);
+    }
+
+    /*!
+     * @brief This operator template is used to deserialize strings using a custom allocator.
+     * @param string_t The variable that will store the string read from the buffer.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize a position that exceeds the internal memory size.
+     */
+    template<template<class> class _Alloc>
+    inline Cdr& operator >>(
+            std::basic_string<char, std::char_traits<char>, _Alloc<char>>& string_t)
+    {
+        return deserialize(string_t);
+    }
+
     /*!
      * @brief This operator template is used to deserialize maps.
      * @param map_t The variable that will store the map read from the buffer.
@@ -795,6 +1062,58 @@ public:
         return deserialize<_K, _T>(map_t);
     }
 
+    /*!
+     * @brief This operator template is used to deserialize unordered maps.
+     * @param map_t The variable that will store the unordered map read from the buffer.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize a position that exceeds the internal memory size.
+     */
+    template<class _K, class _T>
+    inline Cdr& operator >>(
+            std::unordered_map<_K, _T>& map_t)
+    {
+        return deserialize(map_t);
+    }
+
+    /*!
+     * @brief This operator template is used to deserialize sets.
+     * @param set_t The variable that will store the set read from the buffer.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize a position that exceeds the internal memory size.
+     */
+    template<class _T>
+    inline Cdr& operator >>(
+            std::set<_T>& set_t)
+    {
+        return deserialize(set_t);
+    }
+
+    /*!
+     * @brief This operator template is used to deserialize unordered sets.
+     * @param set_t The variable that will store the unordered set read from the buffer.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize a position that exceeds the internal memory size.
+     */
+    template<class _T>
+    inline Cdr& operator >>(
+            std::unordered_set<_T>& set_t)
+    {
+        return deserialize(set_t);
+    }
+
+    /*!
+     * @brief This operator template is used to deserialize deques.
+     * @param deque_t The variable that will store the deque read from the buffer.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize a position that exceeds the internal memory size.
+     */
+    template<class _T>
+    inline Cdr& operator >>(
+            std::deque<_T>& deque_t)
+    {
+        return deserialize(deque_t);
+    }
+
     /*!
      * @brief This operator template is used to deserialize any other non-basic type.
      * @param type_t The variable that will store the object read from the buffer.
@@ -1310,7 +1629,7 @@ public:
         }
         catch (eprosima::fastcdr::exception::Exception& ex)
         {
-            setState(state_before_error);
+            restoreState(state_before_error);
             ex.raise();
         }
 
@@ -1318,77 +1637,56 @@ public:
     }
 
     /*!
-     * @brief This function template serializes a map.
-     * @param map_t The map that will be serialized in the buffer.
+     * @brief This function template serializes a sequence using a custom allocator.
+     * @param vector_t The sequence that will be serialized in the buffer.
      * @return Reference to the eprosima::fastcdr::Cdr object.
      * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize a position that exceeds the internal memory size.
      */
-    template<class _K, class _T>
+    template<class _T, template<class> class _Alloc>
     Cdr& serialize(
-            const std::map<_K, _T>& map_t)
+            const std::vector<_T, _Alloc<_T>>& vector_t)
     {
-        state state_(*this);
+        state state_before_error(*this);
 
-        *this << static_cast<int32_t>(map_t.size());
+        *this << static_cast<int32_t>(vector_t.size());
 
         try
         {
-            for (auto it_pair = map_t.begin(); it_pair != map_t.end(); ++it_pair)
-            {
-                *this << it_pair->first;
-                *this << it_pair->second;
-            }
-            //return serializeArray(map_t.data(), map_t.size());
+            return serializeArray(vector_t.data(), vector_t.size());
         }
         catch (eprosima::fastcdr::exception::Exception& ex)
         {
-            setState(state_);
+            restoreState(state_before_error);
             ex.raise();
         }
 
         return *this;
     }
 
-#ifdef _MSC_VER
-    /*!
-     * @brief This function template serializes a sequence of booleans.
-     * @param vector_t The sequence that will be serialized in the buffer.
-     * @return Reference to the eprosima::fastcdr::Cdr object.
-     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize a position that exceeds the internal memory size.
-     */
-    template<>
-    Cdr& serialize<bool>(
-            const std::vector<bool>& vector_t)
-    {
-        return serializeBoolSequence(vector_t);
-    }
-
-#endif // ifdef _MSC_VER
-
     /*!
-     * @brief This function template serializes a sequence with a different endianness.
+     * @brief This function template serializes a sequence, encoding ranges of it in parallel.
      * @param vector_t The sequence that will be serialized in the buffer.
-     * @param endianness Endianness that will be used in the serialization of this value.
+     * @param pool The thread pool that encodes the ranges.
      * @return Reference to the eprosima::fastcdr::Cdr object.
      * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize a position that exceeds the internal memory size.
+     * @see eprosima::fastcdr::Cdr::serializeArray(const _T*, size_t, ThreadPool&)
      */
-    template<class _T>
+    template<class _T, class _Alloc>
     Cdr& serialize(
-            const std::vector<_T>& vector_t,
-            Endianness endianness)
+            const std::vector<_T, _Alloc>& vector_t,
+            ThreadPool& pool)
     {
-        bool auxSwap = m_swapBytes;
-        m_swapBytes = (m_swapBytes && (static_cast<Endianness>(m_endianness) == endianness)) ||
-                (!m_swapBytes && (static_cast<Endianness>(m_endianness) != endianness));
+        state state_before_error(*this);
+
+        *this << static_cast<int32_t>(vector_t.size());
 
         try
         {
-            serialize(vector_t);
-            m_swapBytes = auxSwap;
+            return serializeArray(vector_t.data(), vector_t.size(), pool);
         }
         catch (eprosima::fastcdr::exception::Exception& ex)
         {
-            m_swapBytes = auxSwap;
+            restoreState(state_before_error);
             ex.raise();
         }
 
@@ -1396,63 +1694,188 @@ public:
     }
 
     /*!
-     * @brief This function template serializes a non-basic object.
-     * @param type_t The object that will be serialized in the buffer.
+     * @brief This function template serializes a string using a custom allocator.
+     * @param string_t The string that will be serialized in the buffer.
      * @return Reference to the eprosima::fastcdr::Cdr object.
      * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize a position that exceeds the internal memory size.
      */
-    template<class _T>
-    inline Cdr& serialize(
-            const _T& type_t)
+    template<template<class> class _Alloc>
+    Cdr& serialize(
+            const std::basic_string<char, std::char_traits<char>, _Alloc<char>>& string_t)
     {
-        type_t.serialize(*this);
-        return *this;
+        return serialize(string_t.c_str());
     }
 
     /*!
-     * @brief This function serializes an array of octets.
-     * @param octet_t The sequence of octets that will be serialized in the buffer.
-     * @param numElements Number of the elements in the array.
+     * @brief This function template serializes a map.
+     * @param map_t The map that will be serialized in the buffer.
      * @return Reference to the eprosima::fastcdr::Cdr object.
      * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize a position that exceeds the internal memory size.
      */
-    inline
-    Cdr& serializeArray(
-            const uint8_t* octet_t,
-            size_t numElements)
+    template<class _K, class _T>
+    Cdr& serialize(
+            const std::map<_K, _T>& map_t)
     {
-        return serializeArray(reinterpret_cast<const char*>(octet_t), numElements);
+        return serializeMapLike(map_t);
     }
 
     /*!
-     * @brief This function serializes an array of octets with a different endianness.
-     * @param octet_t The array of octets that will be serialized in the buffer.
-     * @param numElements Number of the elements in the array.
-     * @param endianness Endianness that will be used in the serialization of this value.
+     * @brief This function template serializes an unordered map.
+     * The wire format is the same as for std::map, but entries are written in iteration order.
+     * @param map_t The unordered map that will be serialized in the buffer.
      * @return Reference to the eprosima::fastcdr::Cdr object.
      * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize a position that exceeds the internal memory size.
      */
-    inline
-    Cdr& serializeArray(
-            const uint8_t* octet_t,
-            size_t numElements,
-            Endianness endianness)
+    template<class _K, class _T>
+    Cdr& serialize(
+            const std::unordered_map<_K, _T>& map_t)
     {
-        (void) endianness;
-        return serializeArray(reinterpret_cast<const char*>(octet_t), numElements);
+        return serializeMapLike(map_t);
     }
 
     /*!
-     * @brief This function serializes an array of characters.
-     * @param char_t The array of characters that will be serialized in the buffer.
-     * @param numElements Number of the elements in the array.
+     * @brief This function template serializes a set as a sequence.
+     * @param set_t The set that will be serialized in the buffer.
      * @return Reference to the eprosima::fastcdr::Cdr object.
      * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize a position that exceeds the internal memory size.
      */
-    Cdr& serializeArray(
-            const char* char_t,
-            size_t numElements);
-
+    template<class _T>
+    Cdr& serialize(
+            const std::set<_T>& set_t)
+    {
+        return serializeElements(set_t);
+    }
+
+    /*!
+     * @brief This function template serializes an unordered set as a sequence.
+     * @param set_t The unordered set that will be serialized in the buffer.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize a position that exceeds the internal memory size.
+     */
+    template<class _T>
+    Cdr& serialize(
+            const std::unordered_set<_T>& set_t)
+    {
+        return serializeElements(set_t);
+    }
+
+    /*!
+     * @brief This function template serializes a deque as a sequence.
+     * @param deque_t The deque that will be serialized in the buffer.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize a position that exceeds the internal memory size.
+     */
+    template<class _T>
+    Cdr& serialize(
+            const std::deque<_T>& deque_t)
+    {
+        return serializeElements(deque_t);
+    }
+
+#ifdef _MSC_VER
+    /*!
+     * @brief This function template serializes a sequence of booleans.
+     * @param vector_t The sequence that will be serialized in the buffer.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize a position that exceeds the internal memory size.
+     */
+    template<>
+    Cdr& serialize<bool>(
+            const std::vector<bool>& vector_t)
+    {
+        return serializeBoolSequence(vector_t);
+    }
+
+#endif // ifdef _MSC_VER
+
+    /*!
+     * @brief This function template serializes a sequence with a different endianness.
+     * @param vector_t The sequence that will be serialized in the buffer.
+     * @param endianness Endianness that will be used in the serialization of this value.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize a position that exceeds the internal memory size.
+     */
+    template<class _T>
+    Cdr& serialize(
+            const std::vector<_T>& vector_t,
+            Endianness endianness)
+    {
+        bool auxSwap = m_swapBytes;
+        m_swapBytes = (m_swapBytes && (static_cast<Endianness>(m_endianness) == endianness)) ||
+                (!m_swapBytes && (static_cast<Endianness>(m_endianness) != endianness));
+
+        try
+        {
+            serialize(vector_t);
+            m_swapBytes = auxSwap;
+        }
+        catch (eprosima::fastcdr::exception::Exception& ex)
+        {
+            m_swapBytes = auxSwap;
+            ex.raise();
+        }
+
+        return *this;
+    }
+
+    /*!
+     * @brief This function template serializes a non-basic object.
+     * @param type_t The object that will be serialized in the buffer.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize a position that exceeds the internal memory size.
+     */
+    template<class _T>
+    inline Cdr& serialize(
+            const _T& type_t)
+    {
+        type_t.serialize(*this);
+        return *this;
+    }
+
+    /*!
+     * @brief This function serializes an array of octets.
+     * @param octet_t The sequence of octets that will be serialized in the buffer.
+     * @param numElements Number of the elements in the array.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize a position that exceeds the internal memory size.
+     */
+    inline
+    Cdr& serializeArray(
+            const uint8_t* octet_t,
+            size_t numElements)
+    {
+        return serializeArray(reinterpret_cast<const char*>(octet_t), numElements);
+    }
+
+    /*!
+     * @brief This function serializes an array of octets with a different endianness.
+     * @param octet_t The array of octets that will be serialized in the buffer.
+     * @param numElements Number of the elements in the array.
+     * @param endianness Endianness that will be used in the serialization of this value.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize a position that exceeds the internal memory size.
+     */
+    inline
+    Cdr& serializeArray(
+            const uint8_t* octet_t,
+            size_t numElements,
+            Endianness endianness)
+    {
+        (void) endianness;
+        return serializeArray(reinterpret_cast<const char*>(octet_t), numElements);
+    }
+
+    /*!
+     * @brief This function serializes an array of characters.
+     * @param char_t The array of characters that will be serialized in the buffer.
+     * @param numElements Number of the elements in the array.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize a position that exceeds the internal memory size.
+     */
+    Cdr& serializeArray(
+            const char* char_t,
+            size_t numElements);
+
     /*!
      * @brief This function serializes an array of characters with a different endianness.
      * @param char_t The array of characters that will be serialized in the buffer.
@@ -1918,6 +2341,65 @@ public:
         return *this;
     }
 
+    /*!
+     * @brief This function template serializes an array of key/value pairs.
+     * A std::vector of pairs kept sorted by key is serialized with the same wire format as a std::map.
+     * @param pair_t The array of pairs that will be serialized in the buffer.
+     * @param numElements Number of the elements in the array.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize a position that exceeds the internal memory size.
+     */
+    template<class _K, class _T>
+    Cdr& serializeArray(
+            const std::pair<_K, _T>* pair_t,
+            size_t numElements)
+    {
+        for (size_t count = 0; count < numElements; ++count)
+        {
+            *this << pair_t[count].first;
+            *this << pair_t[count].second;
+        }
+        return *this;
+    }
+
+    /*!
+     * @brief This function template serializes an array of sequences using a custom allocator.
+     * @param vector_t The array of sequences that will be serialized in the buffer.
+     * @param numElements Number of the elements in the array.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize a position that exceeds the internal memory size.
+     */
+    template<class _T, template<class> class _Alloc>
+    Cdr& serializeArray(
+            const std::vector<_T, _Alloc<_T>>* vector_t,
+            size_t numElements)
+    {
+        for (size_t count = 0; count < numElements; ++count)
+        {
+            serialize(vector_t[count]);
+        }
+        return *this;
+    }
+
+    /*!
+     * @brief This function template serializes an array of strings using a custom allocator.
+     * @param string_t The array of strings that will be serialized in the buffer.
+     * @param numElements Number of the elements in the array.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize a position that exceeds the internal memory size.
+     */
+    template<template<class> class _Alloc>
+    Cdr& serializeArray(
+            const std::basic_string<char, std::char_traits<char>, _Alloc<char>>* string_t,
+            size_t numElements)
+    {
+        for (size_t count = 0; count < numElements; ++count)
+        {
+            serialize(string_t[count].c_str());
+        }
+        return *this;
+    }
+
     /*!
      * @brief This function template serializes an array of non-basic objects.
      * @param type_t The array of objects that will be serialized in the buffer.
@@ -1937,6 +2419,31 @@ public:
         return *this;
     }
 
+    /*!
+     * @brief This function template serializes an array of objects, encoding ranges of it in parallel.
+     * Each range is encoded by a thread of the pool into its own buffer, starting at the alignment it is expected to
+     * have. The ranges are then copied one after the other into this buffer. When the alignment of a range turns out
+     * to be different, its first elements are encoded again by the calling thread until it matches, so the result is
+     * the same as serializing the array with eprosima::fastcdr::Cdr::serializeArray(const _T*, size_t).
+     * Arrays of basic types are copied by the threads of the pool when they reach the threshold set with
+     * eprosima::fastcdr::Cdr::setThreadPool. Small arrays and objects with a sink or a gather list are serialized
+     * sequentially.
+     * @param type_t The array of objects that will be serialized in the buffer. Its elements are serialized by several
+     * threads at the same time.
+     * @param numElements Number of the elements in the array.
+     * @param pool The thread pool that encodes the ranges.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize a position that exceeds the internal memory size.
+     */
+    template<class _T>
+    Cdr& serializeArray(
+            const _T* type_t,
+            size_t numElements,
+            ThreadPool& pool)
+    {
+        return serializeArrayInParallel(type_t, numElements, pool, std::is_arithmetic<_T>());
+    }
+
     /*!
      * @brief This function template serializes an array of non-basic objects with a different endianness.
      * @param type_t The array of objects that will be serialized in the buffer.
@@ -1991,7 +2498,7 @@ public:
         }
         catch (eprosima::fastcdr::exception::Exception& ex)
         {
-            setState(state_before_error);
+            restoreState(state_before_error);
             ex.raise();
         }
 
@@ -2430,6 +2937,19 @@ public:
             wchar_t*& string_t,
             Endianness endianness);
 
+    /*!
+     * @brief This function deserializes a string into an arena.
+     * The memory of the null-terminated string is taken from the arena and is released when the arena is reset.
+     * @param string_t The pointer that will point to the string read from the buffer.
+     * @param arena The arena the memory is taken from.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize a position that exceeds the internal memory size.
+     * @exception exception::BadParamException This exception is thrown when the length read from the buffer exceeds the deserialization limits.
+     */
+    Cdr& deserialize(
+            char*& string_t,
+            Arena& arena);
+
     /*!
      * @brief This function deserializes a std::string.
      * @param string_t The variable that will store the string read from the buffer.
@@ -2573,6 +3093,7 @@ public:
      * @param vector_t The variable that will store the sequence read from the buffer.
      * @return Reference to the eprosima::fastcdr::Cdr object.
      * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize a position that exceeds the internal memory size.
+     * @exception exception::BadParamException This exception is thrown when the length read from the buffer exceeds the deserialization limits.
      */
     template<class _T>
     Cdr& deserialize(
@@ -2589,13 +3110,48 @@ public:
             return *this;
         }
 
-        if ((m_lastPosition - m_currentPosition) < seqLength)
+        checkSequenceLength<_T>(seqLength, state_before_error);
+
+        try
+        {
+            vector_t.resize(seqLength);
+            return deserializeArray(vector_t.data(), vector_t.size());
+        }
+        catch (eprosima::fastcdr::exception::Exception& ex)
+        {
+            restoreState(state_before_error);
+            ex.raise();
+        }
+
+        return *this;
+    }
+
+    /*!
+     * @brief This function template deserializes a sequence using a custom allocator.
+     * The elements are allocated with the allocator of the sequence, e.g. a std::pmr::vector backed by an
+     * eprosima::fastcdr::ArenaMemoryResource.
+     * @param vector_t The variable that will store the sequence read from the buffer.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize a position that exceeds the internal memory size.
+     * @exception exception::BadParamException This exception is thrown when the length read from the buffer exceeds the deserialization limits.
+     */
+    template<class _T, template<class> class _Alloc>
+    Cdr& deserialize(
+            std::vector<_T, _Alloc<_T>>& vector_t)
+    {
+        uint32_t seqLength = 0;
+        state state_before_error(*this);
+
+        *this >> seqLength;
+
+        if (seqLength == 0)
         {
-            setState(state_before_error);
-            throw eprosima::fastcdr::exception::NotEnoughMemoryException(
-                      eprosima::fastcdr::exception::NotEnoughMemoryException::NOT_ENOUGH_MEMORY_MESSAGE_DEFAULT);
+            vector_t.clear();
+            return *this;
         }
 
+        checkSequenceLength<_T>(seqLength, state_before_error);
+
         try
         {
             vector_t.resize(seqLength);
@@ -2603,67 +3159,221 @@ public:
         }
         catch (eprosima::fastcdr::exception::Exception& ex)
         {
-            setState(state_before_error);
+            restoreState(state_before_error);
             ex.raise();
         }
 
         return *this;
     }
 
+    /*!
+     * @brief This function template deserializes a string using a custom allocator.
+     * The characters are copied into the memory of the string's allocator.
+     * @param string_t The variable that will store the string read from the buffer.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize a position that exceeds the internal memory size.
+     * @exception exception::BadParamException This exception is thrown when the length read from the buffer exceeds the deserialization limits.
+     */
+    template<template<class> class _Alloc>
+    Cdr& deserialize(
+            std::basic_string<char, std::char_traits<char>, _Alloc<char>>& string_t)
+    {
+        uint32_t length = 0;
+        const char* str = readString(length);
+        string_t.assign(str, length);
+        return *this;
+    }
+
     /*!
      * @brief This function template deserializes a map.
+     * The map ends up holding exactly the entries read from the buffer. Entries already in the map are reused:
+     * values whose key is received again are deserialized in place, and while keys arrive in ascending order
+     * new entries are inserted with a hint, so a sorted map is loaded in linear time.
      * @param map_t The variable that will store the map read from the buffer.
      * @return Reference to the eprosima::fastcdr::Cdr object.
      * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize a position that exceeds the internal memory size.
+     * @exception exception::BadParamException This exception is thrown when the length read from the buffer exceeds the deserialization limits.
      */
     template<class _K, class _T>
     Cdr& deserialize(
             std::map<_K, _T>& map_t)
     {
         uint32_t seqLength = 0;
-        state state_(*this);
+        state state_before_error(*this);
 
         *this >> seqLength;
 
+        checkSequenceLength<std::pair<_K, _T>>(seqLength, state_before_error);
+
         try
         {
+            typename std::map<_K, _T>::key_compare key_comp = map_t.key_comp();
+            // Entries before it_pair were already received. Entries from it_pair on are previous contents.
+            typename std::map<_K, _T>::iterator it_pair = map_t.begin();
+            bool sorted = true;
+
             for (uint32_t i = 0; i < seqLength; ++i)
             {
                 _K key;
-                _T value;
                 *this >> key;
-                *this >> value;
-                map_t.emplace(std::pair<_K, _T>(std::move(key), std::move(value)));
+
+                if (sorted && it_pair != map_t.begin() && !key_comp(std::prev(it_pair)->first, key))
+                {
+                    // Keys are not in ascending order. Fall back to plain lookups.
+                    map_t.erase(it_pair, map_t.end());
+                    sorted = false;
+                }
+
+                if (!sorted)
+                {
+                    *this >> map_t[std::move(key)];
+                    continue;
+                }
+
+                // Previous entries with a lower key will not be received anymore.
+                bool reused = false;
+                while (it_pair != map_t.end() && key_comp(it_pair->first, key))
+                {
+                    typename std::map<_K, _T>::iterator next = std::next(it_pair);
+#if defined(__cpp_lib_node_extract)
+                    if (next == map_t.end() || key_comp(key, next->first))
+                    {
+                        // Move the node of the last stale entry to the received key.
+                        typename std::map<_K, _T>::node_type node = map_t.extract(it_pair);
+                        node.key() = std::move(key);
+                        it_pair = map_t.insert(next, std::move(node));
+                        reused = true;
+                        break;
+                    }
+#endif // if defined(__cpp_lib_node_extract)
+                    map_t.erase(it_pair);
+                    it_pair = next;
+                }
+
+                if (!reused && (it_pair == map_t.end() || key_comp(key, it_pair->first)))
+                {
+                    it_pair = map_t.emplace_hint(it_pair, std::piecewise_construct,
+                                    std::forward_as_tuple(std::move(key)), std::forward_as_tuple());
+                }
+
+                *this >> it_pair->second;
+                ++it_pair;
+            }
+
+            if (sorted)
+            {
+                map_t.erase(it_pair, map_t.end());
             }
         }
         catch (eprosima::fastcdr::exception::Exception& ex)
         {
-            setState(state_);
+            restoreState(state_before_error);
             ex.raise();
         }
 
         return *this;
     }
 
-#ifdef _MSC_VER
     /*!
-     * @brief This function template deserializes a sequence.
-     * @param vector_t The variable that will store the sequence read from the buffer.
+     * @brief This function template deserializes an unordered map.
+     * The previous contents of the map are discarded and its buckets are reserved from the length read from the buffer.
+     * @param map_t The variable that will store the unordered map read from the buffer.
      * @return Reference to the eprosima::fastcdr::Cdr object.
      * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize a position that exceeds the internal memory size.
+     * @exception exception::BadParamException This exception is thrown when the length read from the buffer exceeds the deserialization limits.
      */
-    template<>
-    Cdr& deserialize<bool>(
-            std::vector<bool>& vector_t)
+    template<class _K, class _T>
+    Cdr& deserialize(
+            std::unordered_map<_K, _T>& map_t)
     {
-        return deserializeBoolSequence(vector_t);
+        return deserializeMapLike(map_t);
     }
 
-#endif // ifdef _MSC_VER
-
     /*!
-     * @brief This function template deserializes a sequence with a different endianness.
-     * @param vector_t The variable that will store the sequence read from the buffer.
+     * @brief This function template deserializes a set from a sequence.
+     * The previous contents of the set are discarded. Elements received in ascending order are inserted in constant time.
+     * @param set_t The variable that will store the set read from the buffer.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize a position that exceeds the internal memory size.
+     * @exception exception::BadParamException This exception is thrown when the length read from the buffer exceeds the deserialization limits.
+     */
+    template<class _T>
+    Cdr& deserialize(
+            std::set<_T>& set_t)
+    {
+        return deserializeSetLike(set_t);
+    }
+
+    /*!
+     * @brief This function template deserializes an unordered set from a sequence.
+     * The previous contents of the set are discarded and its buckets are reserved from the length read from the buffer.
+     * @param set_t The variable that will store the unordered set read from the buffer.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize a position that exceeds the internal memory size.
+     * @exception exception::BadParamException This exception is thrown when the length read from the buffer exceeds the deserialization limits.
+     */
+    template<class _T>
+    Cdr& deserialize(
+            std::unordered_set<_T>& set_t)
+    {
+        return deserializeSetLike(set_t);
+    }
+
+    /*!
+     * @brief This function template deserializes a deque from a sequence.
+     * @param deque_t The variable that will store the deque read from the buffer.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize a position that exceeds the internal memory size.
+     * @exception exception::BadParamException This exception is thrown when the length read from the buffer exceeds the deserialization limits.
+     */
+    template<class _T>
+    Cdr& deserialize(
+            std::deque<_T>& deque_t)
+    {
+        uint32_t seqLength = 0;
+        state state_before_error(*this);
+
+        *this >> seqLength;
+
+        checkSequenceLength<_T>(seqLength, state_before_error);
+
+        try
+        {
+            deque_t.resize(seqLength);
+
+            for (auto it = deque_t.begin(); it != deque_t.end(); ++it)
+            {
+                *this >> *it;
+            }
+        }
+        catch (eprosima::fastcdr::exception::Exception& ex)
+        {
+            restoreState(state_before_error);
+            ex.raise();
+        }
+
+        return *this;
+    }
+
+#ifdef _MSC_VER
+    /*!
+     * @brief This function template deserializes a sequence.
+     * @param vector_t The variable that will store the sequence read from the buffer.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize a position that exceeds the internal memory size.
+     */
+    template<>
+    Cdr& deserialize<bool>(
+            std::vector<bool>& vector_t)
+    {
+        return deserializeBoolSequence(vector_t);
+    }
+
+#endif // ifdef _MSC_VER
+
+    /*!
+     * @brief This function template deserializes a sequence with a different endianness.
+     * @param vector_t The variable that will store the sequence read from the buffer.
      * @param endianness Endianness that will be used in the serialization of this value.
      * @return Reference to the eprosima::fastcdr::Cdr object.
      * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize a position that exceeds the internal memory size.
@@ -3212,6 +3922,65 @@ public:
         return *this;
     }
 
+    /*!
+     * @brief This function template deserializes an array of key/value pairs.
+     * A std::map serialized in the buffer can be deserialized into a std::vector of pairs, which keeps it sorted by key.
+     * @param pair_t The variable that will store the array of pairs read from the buffer.
+     * @param numElements Number of the elements in the array.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize a position that exceeds the internal memory size.
+     */
+    template<class _K, class _T>
+    Cdr& deserializeArray(
+            std::pair<_K, _T>* pair_t,
+            size_t numElements)
+    {
+        for (size_t count = 0; count < numElements; ++count)
+        {
+            *this >> pair_t[count].first;
+            *this >> pair_t[count].second;
+        }
+        return *this;
+    }
+
+    /*!
+     * @brief This function template deserializes an array of sequences using a custom allocator.
+     * @param vector_t The variable that will store the array of sequences read from the buffer.
+     * @param numElements Number of the elements in the array.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize a position that exceeds the internal memory size.
+     */
+    template<class _T, template<class> class _Alloc>
+    Cdr& deserializeArray(
+            std::vector<_T, _Alloc<_T>>* vector_t,
+            size_t numElements)
+    {
+        for (size_t count = 0; count < numElements; ++count)
+        {
+            deserialize(vector_t[count]);
+        }
+        return *this;
+    }
+
+    /*!
+     * @brief This function template deserializes an array of strings using a custom allocator.
+     * @param string_t The variable that will store the array of strings read from the buffer.
+     * @param numElements Number of the elements in the array.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize a position that exceeds the internal memory size.
+     */
+    template<template<class> class _Alloc>
+    Cdr& deserializeArray(
+            std::basic_string<char, std::char_traits<char>, _Alloc<char>>* string_t,
+            size_t numElements)
+    {
+        for (size_t count = 0; count < numElements; ++count)
+        {
+            deserialize(string_t[count]);
+        }
+        return *this;
+    }
+
     /*!
      * @brief This function template deserializes an array of non-basic objects.
      * @param type_t The variable that will store the array of objects read from the buffer.
@@ -3308,6 +4077,7 @@ public:
      * @param numElements This variable return the number of elements of the sequence.
      * @return Reference to the eprosima::fastcdr::Cdr object.
      * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize a position that exceeds the internal memory size.
+     * @exception exception::BadParamException This exception is thrown when the length read from the buffer exceeds the deserialization limits.
      */
     template<class _T>
     Cdr& deserializeSequence(
@@ -3318,6 +4088,7 @@ public:
         state state_before_error(*this);
 
         deserialize(seqLength);
+        checkSequenceLength<_T>(seqLength, state_before_error);
 
         try
         {
@@ -3328,7 +4099,46 @@ public:
         {
             free(sequence_t);
             sequence_t = NULL;
-            setState(state_before_error);
+            restoreState(state_before_error);
+            ex.raise();
+        }
+
+        numElements = seqLength;
+        return *this;
+    }
+
+    /*!
+     * @brief This function template deserializes a raw sequence into an arena.
+     * The memory of the sequence is taken from the arena and is released when the arena is reset.
+     * @param sequence_t The pointer that will store the sequence read from the buffer.
+     * @param numElements This variable return the number of elements of the sequence.
+     * @param arena The arena the memory is taken from.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize a position that exceeds the internal memory size.
+     * @exception exception::BadParamException This exception is thrown when the length read from the buffer exceeds the deserialization limits.
+     */
+    template<class _T>
+    Cdr& deserializeSequence(
+            _T*& sequence_t,
+            size_t& numElements,
+            Arena& arena)
+    {
+        uint32_t seqLength = 0;
+        state state_before_error(*this);
+
+        deserialize(seqLength);
+        checkSequenceLength<_T>(seqLength, state_before_error);
+
+        try
+        {
+            sequence_t = static_cast<_T*>(arena.allocate(seqLength * sizeof(_T), alignof(_T)));
+            memset(sequence_t, 0, seqLength * sizeof(_T));
+            deserializeArray(sequence_t, seqLength);
+        }
+        catch (eprosima::fastcdr::exception::Exception& ex)
+        {
+            sequence_t = NULL;
+            restoreState(state_before_error);
             ex.raise();
         }
 
@@ -3336,6 +4146,21 @@ public:
         return *this;
     }
 
+    /*!
+     * @brief This function deserializes a sequence of strings into an arena.
+     * The array of pointers and every null-terminated string are taken from the arena and are released when the arena is reset.
+     * @param sequence_t The pointer that will store the sequence read from the buffer.
+     * @param numElements This variable return the number of elements of the sequence.
+     * @param arena The arena the memory is taken from.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize a position that exceeds the internal memory size.
+     * @exception exception::BadParamException This exception is thrown when the length read from the buffer exceeds the deserialization limits.
+     */
+    Cdr& deserializeStringSequence(
+            char**& sequence_t,
+            size_t& numElements,
+            Arena& arena);
+
 #ifdef _MSC_VER
     /*!
      * @brief This function template deserializes a string sequence.
@@ -3407,126 +4232,1080 @@ public:
         return *this;
     }
 
+#if HAVE_CXX14 && (__cplusplus >= 201402L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201402L))
+    /*!
+     * @brief This function template serializes a run of consecutive fixed-size fields.
+     * The padding between the fields is computed at compile time for every possible starting alignment,
+     * so the whole run is serialized with a single alignment fix-up and a single bounds check.
+     * The result is byte-identical to serializing the fields one by one.
+     * Supported field types are bool, char, int8_t, uint8_t, int16_t, uint16_t, int32_t, uint32_t,
+     * int64_t, uint64_t, float and double.
+     * @param fields The values that will be serialized in the buffer, in order.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize a position that exceeds the internal memory size.
+     */
+    template<class ... _Fields>
+    Cdr& serialize_fields(
+            const _Fields& ... fields)
+    {
+        return serialize_fields_dispatch<0>(current_residue(FixedLayout<_Fields...>::max_align),
+                       std::true_type(), fields ...);
+    }
+
+    /*!
+     * @brief This function template deserializes a run of consecutive fixed-size fields.
+     * The padding between the fields is computed at compile time for every possible starting alignment,
+     * so the whole run is deserialized with a single alignment fix-up and a single bounds check.
+     * Supported field types are the same than in eprosima::fastcdr::Cdr::serialize_fields.
+     * @param fields The variables that will store the values read from the buffer, in order.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize a position that exceeds the internal memory size.
+     * @exception exception::BadParamException This exception is thrown when a boolean field has a value different than 0 or 1.
+     */
+    template<class ... _Fields>
+    Cdr& deserialize_fields(
+            _Fields& ... fields)
+    {
+        return deserialize_fields_dispatch<0>(current_residue(FixedLayout<_Fields...>::max_align),
+                       std::true_type(), fields ...);
+    }
+
+#endif // if HAVE_CXX14 && (__cplusplus >= 201402L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201402L))
+
 private:
 
+    friend class BatchWriter;
+
+    friend class CdrCursor;
+
+    friend class CdrIndex;
+
+    friend class CdrTranscoder;
+
+    friend class CdrView;
+
+    friend class GatherList;
+
     Cdr(
             const Cdr&) = delete;
 
     Cdr& operator =(
             const Cdr&) = delete;
 
+    /*!
+     * @brief This function sets a previous state when an operation fails, so the error that caused the failure is
+     * the one reported.
+     * A window flushed to the sink cannot be taken back. Then the state is left unchanged, and the bytes written
+     * before the error remain in the stream.
+     * @param current_state Previous state that will be set.
+     * @return False if the state was created before the last flush to the sink.
+     */
+    bool restoreState(
+            state& current_state);
+
     Cdr& serializeBoolSequence(
             const std::vector<bool>& vector_t);
 
     Cdr& deserializeBoolSequence(
             std::vector<bool>& vector_t);
 
-    Cdr& deserializeStringSequence(
-            std::string*& sequence_t,
-            size_t& numElements);
+    /*!
+     * @brief This function copies an array into the buffer with the threads of the pool, if it is set and the array
+     * reaches its threshold. The buffer has to be aligned and large enough.
+     * @param data Pointer to the array.
+     * @param totalSize Number of bytes of the array.
+     * @param dataSize Size of the elements of the array.
+     * @return True if the array was copied.
+     */
+    bool writeArrayInParallel(
+            const char* data,
+            size_t totalSize,
+            size_t dataSize);
 
-    Cdr& deserializeWStringSequence(
-            std::wstring*& sequence_t,
-            size_t& numElements);
+    /*!
+     * @brief This function copies an array from the buffer with the threads of the pool, if it is set and the array
+     * reaches its threshold. The buffer has to be aligned and hold the whole array.
+     * @param data Pointer to the array.
+     * @param totalSize Number of bytes of the array.
+     * @param dataSize Size of the elements of the array.
+     * @return True if the array was copied.
+     */
+    bool readArrayInParallel(
+            char* data,
+            size_t totalSize,
+            size_t dataSize);
 
-#if HAVE_CXX0X
     /*!
-     * @brief This function template detects the content type of the STD container array and serializes the array.
-     * @param array_t The array that will be serialized in the buffer.
-     * @param numElements Number of the elements in the array.
-     * @return Reference to the eprosima::fastcdr::Cdr object.
-     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize a position that exceeds the internal memory size.
+     * @brief This function copies bytes in chunks with the threads of the pool, swapping each element if needed.
+     * @param destination Pointer to the destination.
+     * @param source Pointer to the source.
+     * @param totalSize Number of bytes.
+     * @param dataSize Size of the elements.
+     * @return True if the bytes were copied, false if they have to be copied in the calling thread.
      */
-    template<class _T, size_t _Size>
-    Cdr& serializeArray(
-            const std::array<_T, _Size>* array_t,
-            size_t numElements)
-    {
-        return serializeArray(array_t->data(), numElements * array_t->size());
-    }
+    bool copyInParallel(
+            char* destination,
+            const char* source,
+            size_t totalSize,
+            size_t dataSize);
 
     /*!
-     * @brief This function template detects the content type of the STD container array and serializes the array with a different endianness.
-     * @param array_t The array that will be serialized in the buffer.
-     * @param numElements Number of the elements in the array.
-     * @param endianness Endianness that will be used in the serialization of this value.
-     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @brief This function references an array in the gather list instead of copying it, if it is allowed.
+     * @param data Pointer to the array.
+     * @param totalSize Number of bytes of the array.
+     * @param dataSize Size of the elements of the array.
+     * @return True if the array was referenced.
      * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize a position that exceeds the internal memory size.
      */
-    template<class _T, size_t _Size>
-    Cdr& serializeArray(
-            const std::array<_T, _Size>* array_t,
-            size_t numElements,
-            Endianness endianness)
-    {
-        return serializeArray(array_t->data(), numElements * array_t->size(), endianness);
-    }
+    bool gatherArray(
+            const char* data,
+            size_t totalSize,
+            size_t dataSize);
 
     /*!
-     * @brief This function template detects the content type of the STD container array and deserializes the array.
-     * @param array_t The variable that will store the array read from the buffer.
-     * @param numElements Number of the elements in the array.
-     * @return Reference to the eprosima::fastcdr::Cdr object.
-     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize a position that exceeds the internal memory size.
+     * @brief This function skips a number of serialized values of the same type.
+     * @param type The descriptor of the values.
+     * @param numElements The number of values.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when the values exceed the internal memory size.
      */
-    template<class _T, size_t _Size>
-    Cdr& deserializeArray(
-            std::array<_T, _Size>* array_t,
-            size_t numElements)
-    {
-        return deserializeArray(array_t->data(), numElements * array_t->size());
-    }
+    void skipElements(
+            const TypeDescriptor& type,
+            size_t numElements);
 
     /*!
-     * @brief This function template detects the content type of STD container array and deserializes the array with a different endianness.
-     * @param array_t The variable that will store the array read from the buffer.
-     * @param numElements Number of the elements in the array.
-     * @param endianness Endianness that will be used in the serialization of this value.
-     * @return Reference to the eprosima::fastcdr::Cdr object.
-     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize a position that exceeds the internal memory size.
+     * @brief This function skips the alignment and a number of bytes.
+     * @param dataSize The alignment of the skipped values.
+     * @param size The number of bytes.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when the bytes exceed the internal memory size.
      */
-    template<class _T, size_t _Size>
-    Cdr& deserializeArray(
-            std::array<_T, _Size>* array_t,
-            size_t numElements,
-            Endianness endianness)
-    {
-        return deserializeArray(array_t->data(), numElements * array_t->size(), endianness);
-    }
-
-#endif // if HAVE_CXX0X
+    void skipBytes(
+            size_t dataSize,
+            size_t size);
 
     /*!
-     * @brief This function returns the extra bytes regarding the allignment.
-     * @param dataSize The size of the data that will be serialized.
-     * @return The size needed for the aligment.
+     * @brief This function template returns the serialized size of a primitive type.
+     * @return The serialized size.
      */
-    inline size_t alignment(
-            size_t dataSize) const
+    template<class _T>
+    static constexpr size_t primitiveSize()
     {
-        return dataSize >
-               m_lastDataSize ? (dataSize - ((m_currentPosition - m_alignPosition) % dataSize)) &
-               (dataSize - 1) : 0;
+        return std::is_same<_T, wchar_t>::value ? 4 : (std::is_same<_T, long double>::value ? 16 : sizeof(_T));
     }
 
     /*!
-     * @brief This function jumps the number of bytes of the alignment. These bytes should be calculated with the function eprosima::fastcdr::Cdr::alignment.
-     * @param align The number of bytes to be skipped.
+     * @brief This function template returns the alignment of a primitive type.
+     * @return The alignment.
      */
-    inline void makeAlign(
-            size_t align)
+    template<class _T>
+    static constexpr size_t primitiveAlignment()
     {
-        m_currentPosition += align;
+        return std::is_same<_T, long double>::value ? 8 : primitiveSize<_T>();
     }
 
     /*!
-     * @brief This function resizes the internal buffer. It only applies if the FastBuffer object was created with the default constructor.
-     * @param minSizeInc Minimun size increase for the internal buffer
-     * @return True if the resize was succesful, false if it was not
+     * @brief This function template skips a number of serialized primitives.
+     * @param numElements The number of primitives.
      */
-    bool resize(
+    template<class _T>
+    void skipPrimitives(
+            size_t numElements)
+    {
+        // Compared by division so that a corrupted length cannot overflow the byte count.
+        if (numElements > (m_lastPosition - m_currentPosition) / primitiveSize<_T>())
+        {
+            throw exception::NotEnoughMemoryException(
+                      exception::NotEnoughMemoryException::NOT_ENOUGH_MEMORY_MESSAGE_DEFAULT);
+        }
+
+        skipBytes(primitiveAlignment<_T>(), numElements * primitiveSize<_T>());
+    }
+
+    //! @brief This function template skips a primitive.
+    template<class _T>
+    typename std::enable_if<std::is_arithmetic<_T>::value>::type skipValue(
+            _T*)
+    {
+        skipPrimitives<_T>(1);
+    }
+
+    //! @brief This function template skips an enumeration, serialized as a 32-bit integer.
+    template<class _T>
+    typename std::enable_if<std::is_enum<_T>::value>::type skipValue(
+            _T*)
+    {
+        skipPrimitives<uint32_t>(1);
+    }
+
+    //! @brief This function template skips a string.
+    template<template<class> class _Alloc>
+    void skipValue(
+            std::basic_string<char, std::char_traits<char>, _Alloc<char>>*)
+    {
+        uint32_t length = 0;
+        deserialize(length);
+        skipBytes(sizeof(char), length);
+    }
+
+    //! @brief This function template skips a wide-string.
+    template<template<class> class _Alloc>
+    void skipValue(
+            std::basic_string<wchar_t, std::char_traits<wchar_t>, _Alloc<wchar_t>>*)
+    {
+        uint32_t length = 0;
+        deserialize(length);
+        skipPrimitives<wchar_t>(length);
+    }
+
+    //! @brief This function template skips a sequence.
+    template<class _T, template<class> class _Alloc>
+    void skipValue(
+            std::vector<_T, _Alloc<_T>>*)
+    {
+        skipSequence<_T>();
+    }
+
+    //! @brief This function template skips a set, serialized as a sequence.
+    template<class _T, class _Compare, class _Alloc>
+    void skipValue(
+            std::set<_T, _Compare, _Alloc>*)
+    {
+        skipSequence<_T>();
+    }
+
+    //! @brief This function template skips an unordered set, serialized as a sequence.
+    template<class _T, class _Hash, class _Pred, class _Alloc>
+    void skipValue(
+            std::unordered_set<_T, _Hash, _Pred, _Alloc>*)
+    {
+        skipSequence<_T>();
+    }
+
+    //! @brief This function template skips a deque, serialized as a sequence.
+    template<class _T, class _Alloc>
+    void skipValue(
+            std::deque<_T, _Alloc>*)
+    {
+        skipSequence<_T>();
+    }
+
+#if HAVE_CXX0X
+    //! @brief This function template skips an array.
+    template<class _T, size_t _Size>
+    void skipValue(
+            std::array<_T, _Size>*)
+    {
+        skipElements(static_cast<_T*>(nullptr), _Size, std::is_arithmetic<_T>());
+    }
+
+#endif // if HAVE_CXX0X
+
+    //! @brief This function template skips a map.
+    template<class _K, class _T, class _Compare, class _Alloc>
+    void skipValue(
+            std::map<_K, _T, _Compare, _Alloc>*)
+    {
+        skipSequence<std::pair<_K, _T>>();
+    }
+
+    //! @brief This function template skips an unordered map, serialized as a map.
+    template<class _K, class _T, class _Hash, class _Pred, class _Alloc>
+    void skipValue(
+            std::unordered_map<_K, _T, _Hash, _Pred, _Alloc>*)
+    {
+        skipSequence<std::pair<_K, _T>>();
+    }
+
+    //! @brief This function template skips a key/value pair of a map or of a std::vector of pairs.
+    template<class _K, class _T>
+    void skipValue(
+            std::pair<_K, _T>*)
+    {
+        skipValue(static_cast<_K*>(nullptr));
+        skipValue(static_cast<_T*>(nullptr));
+    }
+
+    //! @brief This function template skips a user type.
+    template<class _T>
+    typename std::enable_if<std::is_class<_T>::value>::type skipValue(
+            _T*)
+    {
+        skipUserType(static_cast<_T*>(nullptr), 0);
+    }
+
+    //! @brief This function template skips a user type with its static function skip.
+    template<class _T>
+    auto skipUserType(
+            _T*,
+            int)->decltype(_T::skip(std::declval<Cdr&>()), void())
+    {
+        _T::skip(*this);
+    }
+
+    //! @brief This function template skips a user type without a static function skip, deserializing it.
+    template<class _T>
+    void skipUserType(
+            _T*,
+            long)
+    {
+        _T value;
+        deserialize(value);
+    }
+
+    //! @brief This function template skips the length of a sequence and its elements.
+    template<class _T>
+    void skipSequence()
+    {
+        uint32_t length = 0;
+        deserialize(length);
+        skipElements(static_cast<_T*>(nullptr), length, std::is_arithmetic<_T>());
+    }
+
+    //! @brief This function template skips a number of primitives of a sequence or an array.
+    template<class _T>
+    void skipElements(
+            _T*,
+            size_t numElements,
+            std::true_type)
+    {
+        // Empty sequences are not aligned to their elements.
+        if (numElements > 0)
+        {
+            skipPrimitives<_T>(numElements);
+        }
+    }
+
+    //! @brief This function template skips a number of non-primitive elements of a sequence or an array.
+    template<class _T>
+    void skipElements(
+            _T*,
+            size_t numElements,
+            std::false_type)
+    {
+        for (size_t count = 0; count < numElements; ++count)
+        {
+            skipValue(static_cast<_T*>(nullptr));
+        }
+    }
+
+    /*!
+     * @brief This function returns the maximum number of bytes of a piece of an array in streaming mode.
+     * @return The size of the window minus the maximum alignment, twice.
+     */
+    size_t getStreamChunkSize() const;
+
+    /*!
+     * @brief This function template serializes an array in pieces that fit in the window, in streaming mode.
+     * @param array_t The array that will be serialized.
+     * @param numElements Number of the elements in the array.
+     * @param elementSize Serialized size of each element.
+     * @return True if the array was serialized in pieces, false if there is no sink or it fits in the window.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when the window cannot hold a single element or the sink fails.
+     */
+    template<class _T>
+    bool serializeArrayInChunks(
+            const _T* array_t,
+            size_t numElements,
+            size_t elementSize)
+    {
+        if ((m_sink == nullptr) || ((numElements * elementSize) <= getStreamChunkSize()))
+        {
+            return false;
+        }
+
+        size_t chunkElements = getStreamChunkSize() / elementSize;
+
+        if (chunkElements == 0)
+        {
+            throw exception::NotEnoughMemoryException(
+                      exception::NotEnoughMemoryException::NOT_ENOUGH_MEMORY_MESSAGE_DEFAULT);
+        }
+
+        // After the first piece the position is aligned to the elements, so the pieces are contiguous.
+        while (numElements > 0)
+        {
+            size_t count = numElements < chunkElements ? numElements : chunkElements;
+            serializeArray(array_t, count);
+            array_t += count;
+            numElements -= count;
+        }
+
+        return true;
+    }
+
+    Cdr& deserializeStringSequence(
+            std::string*& sequence_t,
+            size_t& numElements);
+
+    Cdr& deserializeWStringSequence(
+            std::wstring*& sequence_t,
+            size_t& numElements);
+
+    /*!
+     * @brief This function template serializes the elements of a container as a sequence.
+     * @param container_t The container that will be serialized in the buffer.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize a position that exceeds the internal memory size.
+     */
+    template<class _C>
+    Cdr& serializeElements(
+            const _C& container_t)
+    {
+        state state_before_error(*this);
+
+        *this << static_cast<int32_t>(container_t.size());
+
+        try
+        {
+            for (auto it = container_t.begin(); it != container_t.end(); ++it)
+            {
+                *this << *it;
+            }
+        }
+        catch (eprosima::fastcdr::exception::Exception& ex)
+        {
+            restoreState(state_before_error);
+            ex.raise();
+        }
+
+        return *this;
+    }
+
+    /*!
+     * @brief This function template serializes the entries of an associative container with the wire format of std::map.
+     * @param map_t The container that will be serialized in the buffer.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize a position that exceeds the internal memory size.
+     */
+    template<class _Map>
+    Cdr& serializeMapLike(
+            const _Map& map_t)
+    {
+        state state_before_error(*this);
+
+        *this << static_cast<int32_t>(map_t.size());
+
+        try
+        {
+            for (auto it_pair = map_t.begin(); it_pair != map_t.end(); ++it_pair)
+            {
+                *this << it_pair->first;
+                *this << it_pair->second;
+            }
+        }
+        catch (eprosima::fastcdr::exception::Exception& ex)
+        {
+            restoreState(state_before_error);
+            ex.raise();
+        }
+
+        return *this;
+    }
+
+    /*!
+     * @brief This function template deserializes a map into an associative container, discarding its previous contents.
+     * @param map_t The variable that will store the entries read from the buffer.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize a position that exceeds the internal memory size.
+     * @exception exception::BadParamException This exception is thrown when the length read from the buffer exceeds the deserialization limits.
+     */
+    template<class _Map>
+    Cdr& deserializeMapLike(
+            _Map& map_t)
+    {
+        uint32_t seqLength = 0;
+        state state_before_error(*this);
+
+        *this >> seqLength;
+
+        checkSequenceLength<typename _Map::value_type>(seqLength, state_before_error);
+
+        try
+        {
+            map_t.clear();
+            reserveBuckets(map_t, seqLength, 0);
+
+            for (uint32_t i = 0; i < seqLength; ++i)
+            {
+                typename _Map::key_type key;
+                *this >> key;
+                *this >> map_t[std::move(key)];
+            }
+        }
+        catch (eprosima::fastcdr::exception::Exception& ex)
+        {
+            restoreState(state_before_error);
+            ex.raise();
+        }
+
+        return *this;
+    }
+
+    /*!
+     * @brief This function template deserializes a sequence into a set, discarding its previous contents.
+     * Elements are inserted with an end() hint, so elements received in ascending order are inserted in constant time.
+     * @param set_t The variable that will store the elements read from the buffer.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize a position that exceeds the internal memory size.
+     * @exception exception::BadParamException This exception is thrown when the length read from the buffer exceeds the deserialization limits.
+     */
+    template<class _Set>
+    Cdr& deserializeSetLike(
+            _Set& set_t)
+    {
+        uint32_t seqLength = 0;
+        state state_before_error(*this);
+
+        *this >> seqLength;
+
+        checkSequenceLength<typename _Set::value_type>(seqLength, state_before_error);
+
+        try
+        {
+            set_t.clear();
+            reserveBuckets(set_t, seqLength, 0);
+
+            for (uint32_t i = 0; i < seqLength; ++i)
+            {
+                typename _Set::value_type value;
+                *this >> value;
+                set_t.emplace_hint(set_t.end(), std::move(value));
+            }
+        }
+        catch (eprosima::fastcdr::exception::Exception& ex)
+        {
+            restoreState(state_before_error);
+            ex.raise();
+        }
+
+        return *this;
+    }
+
+    //! @brief This function template reserves the buckets of an unordered container for a number of elements.
+    template<class _C>
+    auto reserveBuckets(
+            _C& container_t,
+            uint32_t numElements,
+            int)->decltype(container_t.reserve(numElements), void())
+    {
+        container_t.reserve(numElements);
+    }
+
+    //! @brief This function template does nothing for an ordered container, which has no buckets.
+    template<class _C>
+    void reserveBuckets(
+            _C&,
+            uint32_t,
+            long)
+    {
+    }
+
+#if HAVE_CXX0X
+    /*!
+     * @brief This function template detects the content type of the STD container array and serializes the array.
+     * @param array_t The array that will be serialized in the buffer.
+     * @param numElements Number of the elements in the array.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize a position that exceeds the internal memory size.
+     */
+    template<class _T, size_t _Size>
+    Cdr& serializeArray(
+            const std::array<_T, _Size>* array_t,
+            size_t numElements)
+    {
+        return serializeArray(array_t->data(), numElements * array_t->size());
+    }
+
+    /*!
+     * @brief This function template detects the content type of the STD container array and serializes the array with a different endianness.
+     * @param array_t The array that will be serialized in the buffer.
+     * @param numElements Number of the elements in the array.
+     * @param endianness Endianness that will be used in the serialization of this value.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize a position that exceeds the internal memory size.
+     */
+    template<class _T, size_t _Size>
+    Cdr& serializeArray(
+            const std::array<_T, _Size>* array_t,
+            size_t numElements,
+            Endianness endianness)
+    {
+        return serializeArray(array_t->data(), numElements * array_t->size(), endianness);
+    }
+
+    /*!
+     * @brief This function template detects the content type of the STD container array and deserializes the array.
+     * @param array_t The variable that will store the array read from the buffer.
+     * @param numElements Number of the elements in the array.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize a position that exceeds the internal memory size.
+     */
+    template<class _T, size_t _Size>
+    Cdr& deserializeArray(
+            std::array<_T, _Size>* array_t,
+            size_t numElements)
+    {
+        return deserializeArray(array_t->data(), numElements * array_t->size());
+    }
+
+    /*!
+     * @brief This function template detects the content type of STD container array and deserializes the array with a different endianness.
+     * @param array_t The variable that will store the array read from the buffer.
+     * @param numElements Number of the elements in the array.
+     * @param endianness Endianness that will be used in the serialization of this value.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize a position that exceeds the internal memory size.
+     */
+    template<class _T, size_t _Size>
+    Cdr& deserializeArray(
+            std::array<_T, _Size>* array_t,
+            size_t numElements,
+            Endianness endianness)
+    {
+        return deserializeArray(array_t->data(), numElements * array_t->size(), endianness);
+    }
+
+#endif // if HAVE_CXX0X
+
+#if HAVE_CXX14 && (__cplusplus >= 201402L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201402L))
+    /*!
+     * @brief This class template describes the fixed layout of a run of fields.
+     * Offsets are relative to the position before the leading alignment and depend only on the
+     * starting position modulo the greatest field size.
+     */
+    template<class ... _Fields>
+    struct FixedLayout
+    {
+        static_assert(sizeof...(_Fields) > 0, "At least one field is required");
+
+        //! @brief Greatest alignment required by the fields of the run.
+        static constexpr size_t max_align = std::max({sizeof(_Fields) ...});
+
+        /*!
+         * @brief Computes the offset of a field of the run.
+         * @param residue Starting position modulo eprosima::fastcdr::Cdr::FixedLayout::max_align.
+         * @param index Index of the field.
+         * @return Offset of the field, including the padding in front of it.
+         */
+        static constexpr size_t offset(
+                size_t residue,
+                size_t index)
+        {
+            const size_t sizes[] = {sizeof(_Fields) ...};
+            size_t position = residue;
+
+            for (size_t count = 0; count < index; ++count)
+            {
+                position += ((sizes[count] - (position % sizes[count])) & (sizes[count] - 1)) + sizes[count];
+            }
+
+            return position + ((sizes[index] - (position % sizes[index])) & (sizes[index] - 1)) - residue;
+        }
+
+        /*!
+         * @brief Computes the number of bytes occupied by the run, including all padding.
+         * @param residue Starting position modulo eprosima::fastcdr::Cdr::FixedLayout::max_align.
+         * @return Size of the run.
+         */
+        static constexpr size_t size(
+                size_t residue)
+        {
+            const size_t sizes[] = {sizeof(_Fields) ...};
+            return offset(residue, sizeof...(_Fields) - 1) + sizes[sizeof...(_Fields) - 1];
+        }
+
+        /*!
+         * @brief Returns the size of the last field of the run.
+         * @return Size of the last field.
+         */
+        static constexpr size_t last_size()
+        {
+            const size_t sizes[] = {sizeof(_Fields) ...};
+            return sizes[sizeof...(_Fields) - 1];
+        }
+    };
+
+    /*!
+     * @brief This class template checks that a type can be part of a fixed layout run.
+     */
+    template<class _T>
+    struct is_fixed_field : public std::integral_constant<bool,
+                std::is_same<_T, bool>::value || std::is_same<_T, char>::value ||
+                std::is_same<_T, int8_t>::value || std::is_same<_T, uint8_t>::value ||
+                std::is_same<_T, int16_t>::value || std::is_same<_T, uint16_t>::value ||
+                std::is_same<_T, int32_t>::value || std::is_same<_T, uint32_t>::value ||
+                std::is_same<_T, int64_t>::value || std::is_same<_T, uint64_t>::value ||
+                std::is_same<_T, float>::value || std::is_same<_T, double>::value>
+    {
+    };
+
+    /*!
+     * @brief This function returns the current position modulo a power of two, relative to the alignment origin.
+     * @param max_align Power of two.
+     * @return The current position modulo max_align.
+     */
+    inline size_t current_residue(
+            size_t max_align) const
+    {
+        return (m_currentPosition - m_alignPosition) & (max_align - 1);
+    }
+
+    template<size_t _Residue, class ... _Fields>
+    Cdr& serialize_fields_dispatch(
+            size_t residue,
+            std::true_type,
+            const _Fields& ... fields)
+    {
+        if (residue == _Residue)
+        {
+            return serialize_fields_at<_Residue>(fields ...);
+        }
+
+        return serialize_fields_dispatch<_Residue + 1>(residue,
+                       std::integral_constant<bool, (_Residue + 1 < FixedLayout<_Fields...>::max_align)>(),
+                       fields ...);
+    }
+
+    template<size_t _Residue, class ... _Fields>
+    Cdr& serialize_fields_dispatch(
+            size_t,
+            std::false_type,
+            const _Fields& ...)
+    {
+        return *this;
+    }
+
+    template<size_t _Residue, class ... _Fields>
+    Cdr& deserialize_fields_dispatch(
+            size_t residue,
+            std::true_type,
+            _Fields& ... fields)
+    {
+        if (residue == _Residue)
+        {
+            return deserialize_fields_at<_Residue>(fields ...);
+        }
+
+        return deserialize_fields_dispatch<_Residue + 1>(residue,
+                       std::integral_constant<bool, (_Residue + 1 < FixedLayout<_Fields...>::max_align)>(),
+                       fields ...);
+    }
+
+    template<size_t _Residue, class ... _Fields>
+    Cdr& deserialize_fields_dispatch(
+            size_t,
+            std::false_type,
+            _Fields& ...)
+    {
+        return *this;
+    }
+
+    /*!
+     * @brief This function template serializes a run of fields whose starting residue is known at compile time.
+     */
+    template<size_t _Residue, class ... _Fields>
+    Cdr& serialize_fields_at(
+            const _Fields& ... fields)
+    {
+        static_assert(all_fixed_fields<_Fields...>(),
+                "Only fixed size primitive types can be serialized with serialize_fields");
+
+        typedef FixedLayout<_Fields...> layout;
+        const size_t totalSize = layout::size(_Residue);
+
+        if (((m_lastPosition - m_currentPosition) >= totalSize) || resize(totalSize))
+        {
+            char* dst = &m_currentPosition;
+
+            if (m_swapBytes)
+            {
+                store_fields<_Residue, true>(dst, std::index_sequence_for<_Fields...>(), fields ...);
+            }
+            else
+            {
+                store_fields<_Residue, false>(dst, std::index_sequence_for<_Fields...>(), fields ...);
+            }
+
+            // Save last datasize.
+            m_lastDataSize = layout::last_size();
+            m_currentPosition += totalSize;
+            return *this;
+        }
+
+        throw exception::NotEnoughMemoryException(exception::NotEnoughMemoryException::NOT_ENOUGH_MEMORY_MESSAGE_DEFAULT);
+    }
+
+    /*!
+     * @brief This function template deserializes a run of fields whose starting residue is known at compile time.
+     */
+    template<size_t _Residue, class ... _Fields>
+    Cdr& deserialize_fields_at(
+            _Fields& ... fields)
+    {
+        static_assert(all_fixed_fields<_Fields...>(),
+                "Only fixed size primitive types can be deserialized with deserialize_fields");
+
+        typedef FixedLayout<_Fields...> layout;
+        const size_t totalSize = layout::size(_Residue);
+
+        if ((m_lastPosition - m_currentPosition) >= totalSize)
+        {
+            const char* src = &m_currentPosition;
+
+            if (m_swapBytes)
+            {
+                load_fields<_Residue, true>(src, std::index_sequence_for<_Fields...>(), fields ...);
+            }
+            else
+            {
+                load_fields<_Residue, false>(src, std::index_sequence_for<_Fields...>(), fields ...);
+            }
+
+            // Save last datasize.
+            m_lastDataSize = layout::last_size();
+            m_currentPosition += totalSize;
+            return *this;
+        }
+
+        throw exception::NotEnoughMemoryException(exception::NotEnoughMemoryException::NOT_ENOUGH_MEMORY_MESSAGE_DEFAULT);
+    }
+
+    template<class ... _Fields>
+    static constexpr bool all_fixed_fields()
+    {
+        const bool fixed[] = {is_fixed_field<_Fields>::value ...};
+
+        for (bool is_fixed : fixed)
+        {
+            if (!is_fixed)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    template<size_t _Residue, bool _Swap, size_t ... _Index, class ... _Fields>
+    static void store_fields(
+            char* dst,
+            std::index_sequence<_Index...>,
+            const _Fields& ... fields)
+    {
+        int expander[] = {0, (store_field<_Swap>(dst + FixedLayout<_Fields...>::offset(_Residue, _Index), fields), 0) ...};
+        (void) expander;
+    }
+
+    template<size_t _Residue, bool _Swap, size_t ... _Index, class ... _Fields>
+    static void load_fields(
+            const char* src,
+            std::index_sequence<_Index...>,
+            _Fields& ... fields)
+    {
+        // Booleans are validated before any field is modified.
+        const bool valid[] = {true, check_field(src + FixedLayout<_Fields...>::offset(_Residue, _Index), fields) ...};
+
+        for (bool is_valid : valid)
+        {
+            if (!is_valid)
+            {
+                throw exception::BadParamException(
+                          "Unexpected byte value in Cdr::deserialize_fields(bool), expected 0 or 1");
+            }
+        }
+
+        int expander[] = {0, (load_field<_Swap>(src + FixedLayout<_Fields...>::offset(_Residue, _Index), fields), 0) ...};
+        (void) expander;
+    }
+
+    template<bool _Swap, class _T>
+    static void store_field(
+            char* dst,
+            const _T& field)
+    {
+        if (_Swap)
+        {
+            const char* src = reinterpret_cast<const char*>(&field);
+
+            for (size_t count = 0; count < sizeof(_T); ++count)
+            {
+                dst[count] = src[sizeof(_T) - 1 - count];
+            }
+        }
+        else
+        {
+            memcpy(dst, &field, sizeof(_T));
+        }
+    }
+
+    template<bool _Swap>
+    static void store_field(
+            char* dst,
+            const bool& field)
+    {
+        *dst = field ? 1 : 0;
+    }
+
+    template<bool _Swap, class _T>
+    static void load_field(
+            const char* src,
+            _T& field)
+    {
+        if (_Swap)
+        {
+            char* dst = reinterpret_cast<char*>(&field);
+
+            for (size_t count = 0; count < sizeof(_T); ++count)
+            {
+                dst[count] = src[sizeof(_T) - 1 - count];
+            }
+        }
+        else
+        {
+            memcpy(&field, src, sizeof(_T));
+        }
+    }
+
+    template<bool _Swap>
+    static void load_field(
+            const char* src,
+            bool& field)
+    {
+        field = (*src == 1);
+    }
+
+    template<class _T>
+    static bool check_field(
+            const char*,
+            const _T&)
+    {
+        return true;
+    }
+
+    static bool check_field(
+            const char* src,
+            const bool&)
+    {
+        return (*src == 0) || (*src == 1);
+    }
+
+#endif // if HAVE_CXX14 && (__cplusplus >= 201402L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201402L))
+
+    /*!
+     * @brief This function returns the extra bytes regarding the allignment.
+     * @param dataSize The size of the data that will be serialized.
+     * @return The size needed for the aligment.
+     */
+    inline size_t alignment(
+            size_t dataSize) const
+    {
+        return dataSize >
+               m_lastDataSize ? (dataSize - ((m_currentPosition - m_alignPosition) % dataSize)) &
+               (dataSize - 1) : 0;
+    }
+
+    /*!
+     * @brief This function jumps the number of bytes of the alignment. These bytes should be calculated with the function eprosima::fastcdr::Cdr::alignment.
+     * @param align The number of bytes to be skipped.
+     */
+    inline void makeAlign(
+            size_t align)
+    {
+        m_currentPosition += align;
+    }
+
+    /*!
+     * @brief This function resizes the internal buffer. It only applies if the FastBuffer object was created with the default constructor.
+     * @param minSizeInc Minimun size increase for the internal buffer
+     * @return True if the resize was succesful, false if it was not
+     */
+    bool resize(
             size_t minSizeInc);
 
+    /*!
+     * @brief This function checks a length read from the buffer before any memory is allocated for it.
+     * The current state is restored before an exception is thrown.
+     * @param length The length read from the buffer.
+     * @param maxLength The maximum length allowed by the deserialization limits.
+     * @param minElementSize The minimum number of bytes each element takes in the buffer.
+     * @param elementAllocationSize The number of bytes that will be allocated for each element.
+     * @param state_before_error The state restored when the check fails.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when the buffer cannot hold the elements.
+     * @exception exception::BadParamException This exception is thrown when a deserialization limit is exceeded.
+     */
+    void checkLength(
+            uint32_t length,
+            size_t maxLength,
+            size_t minElementSize,
+            size_t elementAllocationSize,
+            state& state_before_error);
+
+    /*!
+     * @brief This function template checks the length of a sequence read from the buffer before any memory is allocated for it.
+     * @param length The number of elements read from the buffer.
+     * @param state_before_error The state restored when the check fails.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when the buffer cannot hold the elements.
+     * @exception exception::BadParamException This exception is thrown when a deserialization limit is exceeded.
+     */
+    template<class _T>
+    inline void checkSequenceLength(
+            uint32_t length,
+            state& state_before_error)
+    {
+        // Basic types take at least their size in the buffer. Any other type is assumed to take at least one byte.
+        checkLength(length, m_limits.maxSequenceElements, std::is_arithmetic<_T>::value ? sizeof(_T) : 1,
+                sizeof(_T), state_before_error);
+    }
+
+    template<class _T>
+    Cdr& serializeArrayInParallel(
+            const _T* type_t,
+            size_t numElements,
+            ThreadPool& pool,
+            std::true_type)
+    {
+        ThreadPool* previousPool = m_threadPool;
+        m_threadPool = &pool;
+
+        try
+        {
+            serializeArray(type_t, numElements);
+        }
+        catch (exception::Exception& ex)
+        {
+            m_threadPool = previousPool;
+            ex.raise();
+        }
+
+        m_threadPool = previousPool;
+        return *this;
+    }
+
+    template<class _T>
+    Cdr& serializeArrayInParallel(
+            const _T* type_t,
+            size_t numElements,
+            ThreadPool& pool,
+            std::false_type)
+    {
+        return serializeElementsInParallel(numElements, pool, [type_t](Cdr& cdr, size_t index)
+                       {
+                           cdr << type_t[index];
+                       });
+    }
+
+    /*!
+     * @brief This function serializes a number of elements, encoding ranges of them in parallel.
+     * @param numElements The number of elements.
+     * @param pool The thread pool that encodes the ranges.
+     * @param serializeElement The function that serializes an element, given its index, into an eprosima::fastcdr::Cdr object.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize a position that exceeds the internal memory size.
+     */
+    Cdr& serializeElementsInParallel(
+            size_t numElements,
+            ThreadPool& pool,
+            const std::function<void (Cdr&, size_t)>& serializeElement);
+
     //TODO
     const char* readString(
             uint32_t& length);
@@ -3562,6 +5341,27 @@ private:
 
     //! @brief The last position in the buffer;
     FastBuffer::iterator m_lastPosition;
+
+    //! @brief The limits checked on the lengths read while deserializing.
+    DeserializationLimits m_limits;
+
+    //! @brief The number of bytes allocated while deserializing since the last reset.
+    size_t m_allocatedBytes;
+
+    //! @brief The list of arrays referenced instead of copied, if any.
+    GatherList* m_gatherList;
+
+    //! @brief The sink that receives the serialized bytes in streaming mode, if any.
+    CdrSink* m_sink;
+
+    //! @brief The number of bytes flushed to the sink since the last reset.
+    size_t m_flushedBytes;
+
+    //! @brief The thread pool that copies large arrays of basic types, if any.
+    ThreadPool* m_threadPool;
+
+    //! @brief The minimum number of bytes of the arrays copied by the thread pool.
+    size_t m_parallelThreshold;
 };
 }     //namespace fastcdr
 } //namespace eprosima
@@ -0,0 +1,210 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _FASTCDR_CDRCURSOR_H_
+#define _FASTCDR_CDRCURSOR_H_
+
+#include "fastcdr_dll.h"
+#include "Cdr.h"
+
+namespace eprosima {
+namespace fastcdr {
+/*!
+ * @brief This class deserializes a CDR representation stored in an immutable buffer.
+ * A cursor keeps its own position, alignment origin and endianness, and never writes to the buffer nor to any data
+ * shared with other cursors. So any number of cursors, each one used by a single thread, can deserialize the same
+ * bytes at the same time without copying them.
+ * A cursor is cheap to create. It should be created by the thread that uses it, so it lives in memory of that thread.
+ * @ingroup FASTCDRAPIREFERENCE
+ */
+class Cdr_DllAPI CdrCursor
+{
+public:
+
+    /*!
+     * @brief This constructor creates a cursor at the beginning of a buffer.
+     * @param data Pointer to the CDR representation. The bytes must not change while any cursor uses them.
+     * @param size Number of bytes of the CDR representation.
+     * @param endianness The endianness of the CDR representation. The default value is the endianness of the system.
+     * @param cdrType Represents the type of CDR used in the representation. The default value is CORBA CDR.
+     */
+    CdrCursor(
+            const char* data,
+            size_t size,
+            const Cdr::Endianness endianness = Cdr::DEFAULT_ENDIAN,
+            const Cdr::CdrType cdrType = Cdr::CORBA_CDR);
+
+    /*!
+     * @brief This constructor creates a cursor at the beginning of the bytes of a buffer.
+     * @param cdrBuffer The buffer. Its bytes must not change, nor be reallocated, while any cursor uses them.
+     * @param endianness The endianness of the CDR representation. The default value is the endianness of the system.
+     * @param cdrType Represents the type of CDR used in the representation. The default value is CORBA CDR.
+     */
+    CdrCursor(
+            const FastBuffer& cdrBuffer,
+            const Cdr::Endianness endianness = Cdr::DEFAULT_ENDIAN,
+            const Cdr::CdrType cdrType = Cdr::CORBA_CDR);
+
+    /*!
+     * @brief This constructor creates a cursor at the same position than another one, with the same endianness,
+     * encapsulation and deserialization limits. Both cursors go on independently.
+     * It can be used to read the header of a sample once and hand a cursor at the payload to each consumer.
+     * @param other The cursor to copy.
+     */
+    CdrCursor(
+            const CdrCursor& other);
+
+    /*!
+     * @brief This function reads the encapsulation of the CDR stream.
+     * If the CDR stream contains an encapsulation, then this function should be called before starting to deserialize.
+     * @return Reference to the eprosima::fastcdr::CdrCursor object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize a position that exceeds the internal memory size.
+     * @exception exception::BadParamException This exception is thrown when trying to deserialize an invalid value.
+     */
+    CdrCursor& read_encapsulation()
+    {
+        m_cdr.read_encapsulation();
+        return *this;
+    }
+
+    /*!
+     * @brief This operator template deserializes a value of any type supported by eprosima::fastcdr::Cdr.
+     * @param value The variable that will store the value read from the buffer.
+     * @return Reference to the eprosima::fastcdr::CdrCursor object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize a position that exceeds the internal memory size.
+     * @exception exception::BadParamException This exception is thrown when trying to deserialize an invalid value.
+     */
+    template<class _T>
+    CdrCursor& operator >>(
+            _T& value)
+    {
+        m_cdr >> value;
+        return *this;
+    }
+
+    /*!
+     * @brief This function template deserializes a value of any type supported by eprosima::fastcdr::Cdr.
+     * @param value The variable that will store the value read from the buffer.
+     * @return Reference to the eprosima::fastcdr::CdrCursor object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize a position that exceeds the internal memory size.
+     * @exception exception::BadParamException This exception is thrown when trying to deserialize an invalid value.
+     */
+    template<class _T>
+    CdrCursor& deserialize(
+            _T& value)
+    {
+        m_cdr.deserialize(value);
+        return *this;
+    }
+
+    /*!
+     * @brief This function template deserializes an array of any type supported by eprosima::fastcdr::Cdr.
+     * @param values The array that will store the values read from the buffer.
+     * @param numElements Number of the elements in the array.
+     * @return Reference to the eprosima::fastcdr::CdrCursor object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize a position that exceeds the internal memory size.
+     * @exception exception::BadParamException This exception is thrown when trying to deserialize an invalid value.
+     */
+    template<class _T>
+    CdrCursor& deserializeArray(
+            _T* values,
+            size_t numElements)
+    {
+        m_cdr.deserializeArray(values, numElements);
+        return *this;
+    }
+
+    /*!
+     * @brief This function skips a number of bytes.
+     * @param numBytes The number of bytes that will be jumped.
+     * @return True is returned when it works successfully. Otherwise, false is returned.
+     */
+    bool jump(
+            size_t numBytes)
+    {
+        return m_cdr.jump(numBytes);
+    }
+
+    /*!
+     * @brief This function returns the current position in the buffer, to access the bytes in place.
+     * @return Pointer to the current position in the buffer.
+     */
+    const char* getCurrentPosition()
+    {
+        return m_cdr.getCurrentPosition();
+    }
+
+    /*!
+     * @brief This function returns the number of bytes read so far.
+     * @return The number of bytes from the beginning of the buffer.
+     */
+    size_t getPosition() const
+    {
+        return m_cdr.getSerializedDataLength();
+    }
+
+    /*!
+     * @brief This function returns the current state of the cursor.
+     * @return The current state of the cursor.
+     */
+    Cdr::state getState()
+    {
+        return m_cdr.getState();
+    }
+
+    /*!
+     * @brief This function sets a previous state of the cursor, or of a cursor over the same bytes.
+     * @param state Previous state that will be set.
+     */
+    void setState(
+            Cdr::state& state)
+    {
+        m_cdr.setState(state);
+    }
+
+    /*!
+     * @brief This function returns the endianness of the CDR representation.
+     * @return The endianness.
+     */
+    Cdr::Endianness endianness() const
+    {
+        return m_cdr.endianness();
+    }
+
+    /*!
+     * @brief This function sets the limits checked on the lengths read while deserializing.
+     * @param limits The new limits.
+     */
+    void setDeserializationLimits(
+            const Cdr::DeserializationLimits& limits)
+    {
+        m_cdr.setDeserializationLimits(limits);
+    }
+
+private:
+
+    CdrCursor& operator =(
+            const CdrCursor&) = delete;
+
+    //! @brief The bytes of the CDR representation. The buffer belongs to the cursor, but not the bytes.
+    FastBuffer m_buffer;
+
+    //! @brief The object used to read the bytes.
+    Cdr m_cdr;
+};
+
+} //namespace fastcdr
+} //namespace eprosima
+
+#endif // _FASTCDR_CDRCURSOR_H_
@@ -0,0 +1,93 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _FASTCDR_CDRINDEX_H_
+#define _FASTCDR_CDRINDEX_H_
+
+#include "fastcdr_dll.h"
+#include "Cdr.h"
+#include "TypeDescriptor.h"
+#include <vector>
+
+namespace eprosima {
+namespace fastcdr {
+/*!
+ * @brief This class records where the elements of a serialized sequence or array, or the members of a serialized
+ * structure, start in the buffer. It is built in one pass that skips the values without deserializing them, and
+ * then any element can be deserialized directly by positioning a eprosima::fastcdr::Cdr object on it.
+ * @ingroup FASTCDRAPIREFERENCE
+ */
+class Cdr_DllAPI CdrIndex
+{
+public:
+
+    //! @brief Default constructor. The index is empty.
+    CdrIndex();
+
+    /*!
+     * @brief This function indexes the value at the current position of a Cdr object.
+     * The Cdr object is left after the value.
+     * @param cdr The object positioned at the value.
+     * @param type The descriptor of the value: a sequence, an array or a structure.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when the value exceeds the internal memory size.
+     * @exception exception::BadParamException This exception is thrown when the descriptor is not a sequence, an array or a structure,
+     * or when the length of a sequence exceeds the deserialization limits.
+     */
+    void build(
+            Cdr& cdr,
+            const TypeDescriptor& type);
+
+    /*!
+     * @brief This function returns the number of indexed elements or members.
+     * @return The number of entries.
+     */
+    size_t size() const
+    {
+        return m_offsets.size();
+    }
+
+    /*!
+     * @brief This function returns the position of an element or member in the buffer.
+     * @param index The index of the element or member.
+     * @return The offset from the beginning of the buffer.
+     * @exception exception::BadParamException This exception is thrown when the index is out of range.
+     */
+    size_t getOffset(
+            size_t index) const;
+
+    /*!
+     * @brief This function positions a Cdr object at the beginning of an element or member.
+     * The Cdr object must read the same buffer, with the same endianness, as the one used to build the index.
+     * @param cdr The object to be positioned.
+     * @param index The index of the element or member.
+     * @return Reference to the eprosima::fastcdr::Cdr object.
+     * @exception exception::BadParamException This exception is thrown when the index is out of range.
+     */
+    Cdr& seek(
+            Cdr& cdr,
+            size_t index) const;
+
+private:
+
+    //! @brief The offset of each element or member from the beginning of the buffer.
+    std::vector<size_t> m_offsets;
+
+    //! @brief The offset from the beginning of the buffer where the alignment is calculated.
+    size_t m_alignOrigin;
+};
+
+} //namespace fastcdr
+} //namespace eprosima
+
+#endif // _FASTCDR_CDRINDEX_H_
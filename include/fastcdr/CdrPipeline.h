@@ -0,0 +1,265 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _FASTCDR_CDRPIPELINE_H_
+#define _FASTCDR_CDRPIPELINE_H_
+
+#include "fastcdr_dll.h"
+#include "CdrSink.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace eprosima {
+namespace fastcdr {
+/*!
+ * @brief This abstract class processes the chunks of a serialized stream in an eprosima::fastcdr::CdrPipeline.
+ * A stage receives the chunks of each stream in order, always from the same thread.
+ * @ingroup FASTCDRAPIREFERENCE
+ */
+class Cdr_DllAPI PipelineStage
+{
+public:
+
+    //! @brief Default destructor.
+    virtual ~PipelineStage() = default;
+
+    /*!
+     * @brief This function processes the next chunk of the stream.
+     * @param chunk The bytes of the chunk. They can be changed or replaced, and are passed to the next stage.
+     */
+    virtual void process(
+            std::vector<char>& chunk) = 0;
+
+    /*!
+     * @brief This function is called at the end of each stream, after processing its last chunk.
+     * It is also called when the stream failed, so the stage can get ready for the next one.
+     * @param chunk The bytes of the last chunk produced by this stage, which may be empty. The bytes the stage kept
+     * back, or a trailer, can be appended to them.
+     */
+    virtual void finish(
+            std::vector<char>&)
+    {
+    }
+
+};
+
+/*!
+ * @brief This class is a stage that computes the CRC-32 of the stream, as used by zlib and Ethernet.
+ * The bytes pass unchanged, optionally followed by the checksum.
+ * @ingroup FASTCDRAPIREFERENCE
+ */
+class Cdr_DllAPI Crc32Stage : public PipelineStage
+{
+public:
+
+    /*!
+     * @brief Default constructor.
+     * @param appendChecksum True to write the checksum after the stream, as 4 bytes in big endianness.
+     */
+    explicit Crc32Stage(
+            bool appendChecksum = false);
+
+    void process(
+            std::vector<char>& chunk) override;
+
+    void finish(
+            std::vector<char>& chunk) override;
+
+    /*!
+     * @brief This function returns the checksum of the last stream that finished.
+     * @return The CRC-32 of the stream.
+     */
+    uint32_t getChecksum() const
+    {
+        return m_checksum;
+    }
+
+    /*!
+     * @brief This function computes the CRC-32 of a buffer.
+     * @param data Pointer to the bytes.
+     * @param size Number of bytes.
+     * @param crc The checksum of the previous bytes, to compute the checksum of a stream in pieces.
+     * @return The CRC-32 of the previous bytes followed by these.
+     */
+    static uint32_t compute(
+            const char* data,
+            size_t size,
+            uint32_t crc = 0);
+
+private:
+
+    //! @brief True to write the checksum after the stream.
+    bool m_appendChecksum;
+
+    //! @brief The checksum of the bytes of the stream in progress.
+    uint32_t m_running;
+
+    //! @brief The checksum of the last stream that finished.
+    uint32_t m_checksum;
+};
+
+/*!
+ * @brief This class passes the bytes serialized in streaming mode through a chain of stages, such as checksum,
+ * compression or encryption, before writing them to a sink.
+ * It is set as the sink of an eprosima::fastcdr::Cdr object. Each window flushed by the serialization is copied into
+ * a chunk that flows through the stages while the serialization goes on. Every stage, and the writing to the sink,
+ * runs in its own thread, so the throughput approaches the one of the slowest stage instead of the sum of all of them.
+ * The number of chunks in flight is bounded, so the serialization waits for the stages when they fall behind.
+ * @ingroup FASTCDRAPIREFERENCE
+ */
+class Cdr_DllAPI CdrPipeline : public CdrSink
+{
+public:
+
+    /*!
+     * @brief Default constructor. It starts the threads of the stages.
+     * @param stages The stages, in the order the chunks go through them. They must live as long as this object.
+     * @param output The sink that receives the chunks after the last stage.
+     * @param maxChunks The maximum number of chunks in flight.
+     */
+    CdrPipeline(
+            const std::vector<PipelineStage*>& stages,
+            CdrSink& output,
+            size_t maxChunks = 8);
+
+    //! @brief Default destructor. It stops the threads, discarding the chunks that did not reach the sink.
+    ~CdrPipeline();
+
+    /*!
+     * @brief This function copies the bytes into a chunk and passes it to the first stage.
+     * It waits while the maximum number of chunks is in flight.
+     * @param data Pointer to the bytes.
+     * @param size Number of bytes.
+     * @return False if a stage or the sink failed in the current stream.
+     */
+    bool write(
+            const char* data,
+            size_t size) override;
+
+    /*!
+     * @brief This function ends the current stream and waits until all its chunks were written to the sink.
+     * The stages finish the stream in order, and the pipeline can be used for the next one.
+     * The bytes left in the window of the eprosima::fastcdr::Cdr object have to be flushed before.
+     * @return True if every chunk was written to the sink.
+     * @exception Any exception thrown by a stage in the current stream is thrown again.
+     */
+    bool finish();
+
+private:
+
+    CdrPipeline(
+            const CdrPipeline&) = delete;
+
+    CdrPipeline& operator =(
+            const CdrPipeline&) = delete;
+
+    //! @brief A chunk of the stream.
+    struct Chunk
+    {
+        std::vector<char> data;
+
+        //! @brief True for the chunk that ends the stream.
+        bool last;
+    };
+
+    //! @brief The chunks waiting for a thread.
+    struct Queue
+    {
+        std::mutex mutex;
+        std::condition_variable ready;
+        std::deque<Chunk*> chunks;
+    };
+
+    /*!
+     * @brief This function passes a chunk to a queue.
+     * @param queue The queue.
+     * @param chunk The chunk.
+     */
+    void push(
+            Queue& queue,
+            Chunk* chunk);
+
+    /*!
+     * @brief This function takes the next chunk of a queue, waiting for it.
+     * @param queue The queue.
+     * @return The chunk, or nullptr if the pipeline is stopping.
+     */
+    Chunk* pop(
+            Queue& queue);
+
+    /*!
+     * @brief The loop of the thread of a stage.
+     * @param index The index of the stage.
+     */
+    void runStage(
+            size_t index);
+
+    //! @brief The loop of the thread that writes to the sink.
+    void runOutput();
+
+    /*!
+     * @brief This function records the first error of the current stream.
+     * @param exception The exception thrown by a stage, or nullptr if the sink failed.
+     */
+    void fail(
+            std::exception_ptr exception);
+
+    //! @brief The stages.
+    std::vector<PipelineStage*> m_stages;
+
+    //! @brief The sink that receives the chunks after the last stage.
+    CdrSink& m_output;
+
+    //! @brief The chunks, owned by the pipeline.
+    std::vector<std::unique_ptr<Chunk>> m_chunks;
+
+    //! @brief The chunks that are not in flight.
+    Queue m_free;
+
+    //! @brief The chunks waiting for each stage, and for the sink as the last one.
+    std::vector<std::unique_ptr<Queue>> m_queues;
+
+    //! @brief Protects the state of the current stream.
+    std::mutex m_mutex;
+
+    //! @brief Wakes up eprosima::fastcdr::CdrPipeline::finish when the stream was written.
+    std::condition_variable m_finished;
+
+    //! @brief True once the last chunk of the current stream was written.
+    bool m_done;
+
+    //! @brief True if a stage or the sink failed in the current stream.
+    bool m_failed;
+
+    //! @brief The first exception thrown by a stage in the current stream.
+    std::exception_ptr m_exception;
+
+    //! @brief True when the pipeline is being destroyed.
+    std::atomic<bool> m_stop;
+
+    //! @brief The threads of the stages and, the last one, of the sink.
+    std::vector<std::thread> m_threads;
+};
+
+} //namespace fastcdr
+} //namespace eprosima
+
+#endif // _FASTCDR_CDRPIPELINE_H_
@@ -0,0 +1,108 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _FASTCDR_CDRSINK_H_
+#define _FASTCDR_CDRSINK_H_
+
+#include "fastcdr_dll.h"
+#include <cstddef>
+#include <functional>
+
+namespace eprosima {
+namespace fastcdr {
+/*!
+ * @brief This abstract class receives the bytes serialized by an eprosima::fastcdr::Cdr object in streaming mode.
+ * @ingroup FASTCDRAPIREFERENCE
+ */
+class Cdr_DllAPI CdrSink
+{
+public:
+
+    //! @brief Default destructor.
+    virtual ~CdrSink() = default;
+
+    /*!
+     * @brief This function receives the next bytes of the serialized stream.
+     * @param data Pointer to the bytes. They are only valid during the call.
+     * @param size Number of bytes.
+     * @return True if all the bytes were written.
+     */
+    virtual bool write(
+            const char* data,
+            size_t size) = 0;
+};
+
+/*!
+ * @brief This class passes the serialized bytes to a function.
+ * @ingroup FASTCDRAPIREFERENCE
+ */
+class Cdr_DllAPI CallbackSink : public CdrSink
+{
+public:
+
+    //! @brief The function called with the serialized bytes. It returns true if all the bytes were written.
+    typedef std::function<bool (const char*, size_t)> Callback;
+
+    /*!
+     * @brief Default constructor.
+     * @param callback The function called with the serialized bytes.
+     */
+    explicit CallbackSink(
+            Callback callback);
+
+    bool write(
+            const char* data,
+            size_t size) override;
+
+private:
+
+    Callback m_callback;
+};
+
+#if !defined(_WIN32)
+/*!
+ * @brief This class writes the serialized bytes to a file descriptor, such as a file, a pipe or a socket.
+ * @ingroup FASTCDRAPIREFERENCE
+ */
+class Cdr_DllAPI FileDescriptorSink : public CdrSink
+{
+public:
+
+    /*!
+     * @brief Default constructor.
+     * @param fd The file descriptor. It is not closed by this object.
+     */
+    explicit FileDescriptorSink(
+            int fd);
+
+    /*!
+     * @brief This function writes the bytes, retrying on partial writes and interruptions.
+     * @param data Pointer to the bytes.
+     * @param size Number of bytes.
+     * @return True if all the bytes were written.
+     */
+    bool write(
+            const char* data,
+            size_t size) override;
+
+private:
+
+    int m_fd;
+};
+#endif // if !defined(_WIN32)
+
+} //namespace fastcdr
+} //namespace eprosima
+
+#endif // _FASTCDR_CDRSINK_H_
@@ -0,0 +1,181 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _FASTCDR_CDRTRANSCODER_H_
+#define _FASTCDR_CDRTRANSCODER_H_
+
+#include "fastcdr_dll.h"
+#include "Cdr.h"
+#include "FastCdr.h"
+#include "TypeDescriptor.h"
+
+namespace eprosima {
+namespace fastcdr {
+/*!
+ * @brief This class converts serialized values between representations without deserializing them.
+ * The layout of the value is given by a eprosima::fastcdr::TypeDescriptor.
+ * @ingroup FASTCDRAPIREFERENCE
+ */
+class Cdr_DllAPI CdrTranscoder
+{
+public:
+
+    /*!
+     * @brief This function changes the endianness of a serialized value in place.
+     * Every multi-byte primitive is swapped. With DDS CDR, the endianness is read from the encapsulation and the
+     * endianness flag of the encapsulation is flipped. Padding bytes are left untouched.
+     * @param data Pointer to the serialized value.
+     * @param size Length of the buffer.
+     * @param type The descriptor of the value.
+     * @param endianness The endianness of the value. With DDS CDR it is replaced by the one in the encapsulation.
+     * @param cdrType The type of CDR of the value.
+     * @return The number of bytes of the serialized value, including the encapsulation.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when the value exceeds the buffer.
+     * @exception exception::BadParamException This exception is thrown when the encapsulation is not valid.
+     */
+    static size_t swapEndianness(
+            char* data,
+            size_t size,
+            const TypeDescriptor& type,
+            const Cdr::Endianness endianness = Cdr::DEFAULT_ENDIAN,
+            const Cdr::CdrType cdrType = Cdr::DDS_CDR);
+
+    /*!
+     * @brief This function writes a serialized value with the other endianness in an output buffer.
+     * The source is copied to the destination and then transcoded as in the in-place version.
+     * @param source Pointer to the serialized value.
+     * @param destination Pointer to the output buffer. It must hold at least size bytes and not overlap the source.
+     * @param size Length of the source buffer.
+     * @param type The descriptor of the value.
+     * @param endianness The endianness of the value. With DDS CDR it is replaced by the one in the encapsulation.
+     * @param cdrType The type of CDR of the value.
+     * @return The number of bytes of the serialized value, including the encapsulation.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when the value exceeds the buffer.
+     * @exception exception::BadParamException This exception is thrown when the encapsulation is not valid.
+     */
+    static size_t swapEndianness(
+            const char* source,
+            char* destination,
+            size_t size,
+            const TypeDescriptor& type,
+            const Cdr::Endianness endianness = Cdr::DEFAULT_ENDIAN,
+            const Cdr::CdrType cdrType = Cdr::DDS_CDR);
+
+    /*!
+     * @brief This function converts a value serialized by eprosima::fastcdr::FastCdr to CDR.
+     * The value is read at the current position of the source and written at the current position of the
+     * destination, adding the alignment and swapping to the endianness of the destination. The destination
+     * writes its own encapsulation, if any, before calling this function.
+     * @param source The object positioned at the value in FastCdr representation.
+     * @param destination The object where the value is written in CDR representation.
+     * @param type The descriptor of the value.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when the value exceeds the source
+     * or the destination. Both objects are then left at an unspecified position.
+     */
+    static void toCdr(
+            FastCdr& source,
+            Cdr& destination,
+            const TypeDescriptor& type);
+
+    /*!
+     * @brief This function converts a value serialized by eprosima::fastcdr::Cdr to the FastCdr representation.
+     * The value is read at the current position of the source, whose encapsulation was already read, and written at
+     * the current position of the destination, removing the alignment and swapping to the endianness of the system.
+     * @param source The object positioned at the value in CDR representation.
+     * @param destination The object where the value is written in FastCdr representation.
+     * @param type The descriptor of the value.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when the value exceeds the source
+     * or the destination. Both objects are then left at an unspecified position.
+     */
+    static void toFastCdr(
+            Cdr& source,
+            FastCdr& destination,
+            const TypeDescriptor& type);
+
+private:
+
+    /*!
+     * @brief This function swaps a value at the current position and leaves the Cdr object after it.
+     * @param cdr The object that reads the value with its original endianness.
+     * @param type The descriptor of the value.
+     */
+    static void swapValue(
+            Cdr& cdr,
+            const TypeDescriptor& type);
+
+    /*!
+     * @brief This function swaps a number of values of the same type.
+     * @param cdr The object that reads the values with their original endianness.
+     * @param type The descriptor of the values.
+     * @param numElements The number of values.
+     */
+    static void swapElements(
+            Cdr& cdr,
+            const TypeDescriptor& type,
+            size_t numElements);
+
+    /*!
+     * @brief This function reads the length of a string or a sequence and swaps it.
+     * @param cdr The object that reads the length with its original endianness.
+     * @return The length.
+     */
+    static uint32_t swapLength(
+            Cdr& cdr);
+
+    /*!
+     * @brief This function converts a number of values of the same type from FastCdr to CDR.
+     * @param source The object positioned at the values in FastCdr representation.
+     * @param destination The object where the values are written in CDR representation.
+     * @param type The descriptor of the values.
+     * @param numElements The number of values.
+     */
+    static void toCdrElements(
+            FastCdr& source,
+            Cdr& destination,
+            const TypeDescriptor& type,
+            size_t numElements);
+
+    /*!
+     * @brief This function writes a block of primitives aligned to their type, swapping them if needed.
+     * @param destination The object where the primitives are written in CDR representation.
+     * @param data Pointer to the primitives in the representation of the system.
+     * @param numElements The number of primitives.
+     * @param elementSize The size of each primitive.
+     * @param dataSize The alignment of the primitives.
+     */
+    static void writeAligned(
+            Cdr& destination,
+            const char* data,
+            size_t numElements,
+            size_t elementSize,
+            size_t dataSize);
+
+    /*!
+     * @brief This function converts a number of values of the same type from CDR to FastCdr.
+     * @param source The object positioned at the values in CDR representation.
+     * @param destination The object where the values are written in FastCdr representation.
+     * @param type The descriptor of the values.
+     * @param numElements The number of values.
+     */
+    static void toFastCdrElements(
+            Cdr& source,
+            FastCdr& destination,
+            const TypeDescriptor& type,
+            size_t numElements);
+};
+
+} //namespace fastcdr
+} //namespace eprosima
+
+#endif // _FASTCDR_CDRTRANSCODER_H_
@@ -0,0 +1,197 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _FASTCDR_CDRVIEW_H_
+#define _FASTCDR_CDRVIEW_H_
+
+#include "fastcdr_dll.h"
+#include "Cdr.h"
+#include "TypeDescriptor.h"
+#include "exceptions/BadParamException.h"
+#include <string>
+#include <vector>
+
+namespace eprosima {
+namespace fastcdr {
+/*!
+ * @brief This class gives access to the members of a structure serialized in a buffer without deserializing it.
+ * The offset of a member is computed on its first access by skipping the members before it, and is cached
+ * for later accesses. Members after the last one accessed are never touched.
+ * @ingroup FASTCDRAPIREFERENCE
+ */
+class Cdr_DllAPI CdrView
+{
+public:
+
+    /*!
+     * @brief This class references a string stored in the buffer.
+     */
+    class StringView
+    {
+    public:
+
+        /*!
+         * @brief Constructor.
+         * @param data Pointer to the first character.
+         * @param size Number of characters, without the terminating null character.
+         */
+        StringView(
+                const char* data,
+                size_t size)
+            : m_data(data)
+            , m_size(size)
+        {
+        }
+
+        //! @brief Pointer to the first character. The string is not null-terminated.
+        const char* data() const
+        {
+            return m_data;
+        }
+
+        //! @brief Number of characters.
+        size_t size() const
+        {
+            return m_size;
+        }
+
+        //! @brief This function copies the referenced characters into a std::string.
+        std::string str() const
+        {
+            return std::string(m_data, m_size);
+        }
+
+    private:
+
+        const char* m_data;
+
+        size_t m_size;
+    };
+
+    /*!
+     * @brief This constructor creates a view of a structure serialized in a buffer.
+     * @param cdrBuffer A reference to the buffer that contains the CDR representation.
+     * @param type The descriptor of the serialized structure.
+     * @param endianness The endianness of the CDR representation. The default value is the endianness of the system.
+     * @param cdrType Represents the type of CDR used in the representation. The default value is CORBA CDR.
+     * @exception exception::BadParamException This exception is thrown when the descriptor is not a structure.
+     */
+    CdrView(
+            FastBuffer& cdrBuffer,
+            const TypeDescriptor& type,
+            const Cdr::Endianness endianness = Cdr::DEFAULT_ENDIAN,
+            const Cdr::CdrType cdrType = Cdr::CORBA_CDR);
+
+    /*!
+     * @brief This function reads the encapsulation of the CDR stream.
+     * If the CDR stream contains an encapsulation, then this function should be called before accessing any member.
+     * @return Reference to the eprosima::fastcdr::CdrView object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize a position that exceeds the internal memory size.
+     * @exception exception::BadParamException This exception is thrown when trying to deserialize an invalid value.
+     */
+    CdrView& read_encapsulation();
+
+    /*!
+     * @brief This function template returns the value of a primitive member.
+     * @param index The index of the member.
+     * @return The value of the member.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when the member is outside of the buffer.
+     * @exception exception::BadParamException This exception is thrown when the index is out of range or the member is not a primitive of the requested type.
+     */
+    template<class _T>
+    _T get(
+            size_t index)
+    {
+        const TypeDescriptor& member = m_type.getMember(index);
+
+        if (!member.isPrimitive() || (member.getKind() != TypeKind<_T>::value))
+        {
+            throw exception::BadParamException("CdrView member is not a primitive of the requested type");
+        }
+
+        _T value;
+        seek(index) >> value;
+        return value;
+    }
+
+    /*!
+     * @brief This function template returns the value of a primitive member.
+     * @param name The name of the member.
+     * @return The value of the member.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when the member is outside of the buffer.
+     * @exception exception::BadParamException This exception is thrown when there is no member with that name or it is not a primitive of the requested type.
+     */
+    template<class _T>
+    _T get(
+            const std::string& name)
+    {
+        return get<_T>(m_type.getMemberIndex(name));
+    }
+
+    /*!
+     * @brief This function returns a string member without copying it.
+     * @param index The index of the member.
+     * @return A reference to the characters in the buffer.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when the member is outside of the buffer.
+     * @exception exception::BadParamException This exception is thrown when the index is out of range or the member is not a string.
+     */
+    StringView getString(
+            size_t index);
+
+    /*!
+     * @brief This function returns a string member without copying it.
+     * @param name The name of the member.
+     * @return A reference to the characters in the buffer.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when the member is outside of the buffer.
+     * @exception exception::BadParamException This exception is thrown when there is no member with that name or it is not a string.
+     */
+    StringView getString(
+            const std::string& name)
+    {
+        return getString(m_type.getMemberIndex(name));
+    }
+
+    /*!
+     * @brief This function positions the view at the beginning of a member.
+     * The returned object can be used to deserialize members of any type.
+     * @param index The index of the member.
+     * @return Reference to the eprosima::fastcdr::Cdr object positioned at the member.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when the member is outside of the buffer.
+     * @exception exception::BadParamException This exception is thrown when the index is out of range.
+     */
+    Cdr& seek(
+            size_t index);
+
+private:
+
+    CdrView(
+            const CdrView&) = delete;
+
+    CdrView& operator =(
+            const CdrView&) = delete;
+
+    //! @brief The descriptor of the serialized structure.
+    TypeDescriptor m_type;
+
+    //! @brief The object used to read the buffer.
+    Cdr m_cdr;
+
+    //! @brief The cached state at the beginning of each member accessed so far.
+    std::vector<Cdr::state> m_offsets;
+};
+
+} //namespace fastcdr
+} //namespace eprosima
+
+#endif // _FASTCDR_CDRVIEW_H_
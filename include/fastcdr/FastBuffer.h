@@ -36,6 +36,9 @@ inline uint32_t size_to_uint32(
 
 namespace eprosima {
 namespace fastcdr {
+
+class BufferPool;
+
 /*!
  * @brief This class implements the iterator used to go through a FastBuffer.
  */
@@ -332,6 +335,8 @@ public:
 
 private:
 
+    friend class BufferPool;
+
     FastBuffer(
             const FastBuffer&) = delete;
 
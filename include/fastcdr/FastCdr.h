@@ -21,6 +21,13 @@
 #include <stdint.h>
 #include <string>
 #include <vector>
+#include <map>
+#include <unordered_map>
+#include <set>
+#include <unordered_set>
+#include <deque>
+#include <tuple>
+#include <iterator>
 
 #if !__APPLE__ && !__FreeBSD__ && !__VXWORKS__
 #include <malloc.h>
@@ -367,6 +374,71 @@ public:
         return serialize<_T>(vector_t);
     }
 
+    /*!
+     * @brief This operator template is used to serialize maps.
+     * @param map_t The map that will be serialized in the buffer.
+     * @return Reference to the eprosima::fastcdr::FastCdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize in a position that exceeds the internal memory size.
+     */
+    template<class _K, class _T>
+    inline FastCdr& operator <<(
+            const std::map<_K, _T>& map_t)
+    {
+        return serialize<_K, _T>(map_t);
+    }
+
+    /*!
+     * @brief This operator template is used to serialize unordered maps.
+     * @param map_t The unordered map that will be serialized in the buffer.
+     * @return Reference to the eprosima::fastcdr::FastCdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize in a position that exceeds the internal memory size.
+     */
+    template<class _K, class _T>
+    inline FastCdr& operator <<(
+            const std::unordered_map<_K, _T>& map_t)
+    {
+        return serialize(map_t);
+    }
+
+    /*!
+     * @brief This operator template is used to serialize sets.
+     * @param set_t The set that will be serialized in the buffer.
+     * @return Reference to the eprosima::fastcdr::FastCdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize in a position that exceeds the internal memory size.
+     */
+    template<class _T>
+    inline FastCdr& operator <<(
+            const std::set<_T>& set_t)
+    {
+        return serialize(set_t);
+    }
+
+    /*!
+     * @brief This operator template is used to serialize unordered sets.
+     * @param set_t The unordered set that will be serialized in the buffer.
+     * @return Reference to the eprosima::fastcdr::FastCdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize in a position that exceeds the internal memory size.
+     */
+    template<class _T>
+    inline FastCdr& operator <<(
+            const std::unordered_set<_T>& set_t)
+    {
+        return serialize(set_t);
+    }
+
+    /*!
+     * @brief This operator template is used to serialize deques.
+     * @param deque_t The deque that will be serialized in the buffer.
+     * @return Reference to the eprosima::fastcdr::FastCdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize in a position that exceeds the internal memory size.
+     */
+    template<class _T>
+    inline FastCdr& operator <<(
+            const std::deque<_T>& deque_t)
+    {
+        return serialize(deque_t);
+    }
+
     /*!
      * @brief This operator template is used to serialize non-basic types.
      * @param type_t The object that will be serialized in the buffer.
@@ -618,6 +690,71 @@ public:
         return deserialize<_T>(vector_t);
     }
 
+    /*!
+     * @brief This operator template is used to deserialize maps.
+     * @param map_t The variable that will store the map read from the buffer.
+     * @return Reference to the eprosima::fastcdr::FastCdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize in a position that exceeds the internal memory size.
+     */
+    template<class _K, class _T>
+    inline FastCdr& operator >>(
+            std::map<_K, _T>& map_t)
+    {
+        return deserialize<_K, _T>(map_t);
+    }
+
+    /*!
+     * @brief This operator template is used to deserialize unordered maps.
+     * @param map_t The variable that will store the unordered map read from the buffer.
+     * @return Reference to the eprosima::fastcdr::FastCdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize in a position that exceeds the internal memory size.
+     */
+    template<class _K, class _T>
+    inline FastCdr& operator >>(
+            std::unordered_map<_K, _T>& map_t)
+    {
+        return deserialize(map_t);
+    }
+
+    /*!
+     * @brief This operator template is used to deserialize sets.
+     * @param set_t The variable that will store the set read from the buffer.
+     * @return Reference to the eprosima::fastcdr::FastCdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize in a position that exceeds the internal memory size.
+     */
+    template<class _T>
+    inline FastCdr& operator >>(
+            std::set<_T>& set_t)
+    {
+        return deserialize(set_t);
+    }
+
+    /*!
+     * @brief This operator template is used to deserialize unordered sets.
+     * @param set_t The variable that will store the unordered set read from the buffer.
+     * @return Reference to the eprosima::fastcdr::FastCdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize in a position that exceeds the internal memory size.
+     */
+    template<class _T>
+    inline FastCdr& operator >>(
+            std::unordered_set<_T>& set_t)
+    {
+        return deserialize(set_t);
+    }
+
+    /*!
+     * @brief This operator template is used to deserialize deques.
+     * @param deque_t The variable that will store the deque read from the buffer.
+     * @return Reference to the eprosima::fastcdr::FastCdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize in a position that exceeds the internal memory size.
+     */
+    template<class _T>
+    inline FastCdr& operator >>(
+            std::deque<_T>& deque_t)
+    {
+        return deserialize(deque_t);
+    }
+
     /*!
      * @brief This operator template is used to deserialize non-basic types.
      * @param type_t The variable that will store the object read from the buffer.
@@ -971,6 +1108,72 @@ public:
         return *this;
     }
 
+    /*!
+     * @brief This function template serializes a map.
+     * @param map_t The map that will be serialized in the buffer.
+     * @return Reference to the eprosima::fastcdr::FastCdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize in a position that exceeds the internal memory size.
+     */
+    template<class _K, class _T>
+    FastCdr& serialize(
+            const std::map<_K, _T>& map_t)
+    {
+        return serializeMapLike(map_t);
+    }
+
+    /*!
+     * @brief This function template serializes an unordered map.
+     * The wire format is the same as for std::map, but entries are written in iteration order.
+     * @param map_t The unordered map that will be serialized in the buffer.
+     * @return Reference to the eprosima::fastcdr::FastCdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize in a position that exceeds the internal memory size.
+     */
+    template<class _K, class _T>
+    FastCdr& serialize(
+            const std::unordered_map<_K, _T>& map_t)
+    {
+        return serializeMapLike(map_t);
+    }
+
+    /*!
+     * @brief This function template serializes a set as a sequence.
+     * @param set_t The set that will be serialized in the buffer.
+     * @return Reference to the eprosima::fastcdr::FastCdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize in a position that exceeds the internal memory size.
+     */
+    template<class _T>
+    FastCdr& serialize(
+            const std::set<_T>& set_t)
+    {
+        return serializeElements(set_t);
+    }
+
+    /*!
+     * @brief This function template serializes an unordered set as a sequence.
+     * @param set_t The unordered set that will be serialized in the buffer.
+     * @return Reference to the eprosima::fastcdr::FastCdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize in a position that exceeds the internal memory size.
+     */
+    template<class _T>
+    FastCdr& serialize(
+            const std::unordered_set<_T>& set_t)
+    {
+        return serializeElements(set_t);
+    }
+
+    /*!
+     * @brief This function template serializes a deque as a sequence.
+     * @param deque_t The deque that will be serialized in the buffer.
+     * @return Reference to the eprosima::fastcdr::FastCdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize in a position that exceeds the internal memory size.
+     */
+    template<class _T>
+    FastCdr& serialize(
+            const std::deque<_T>& deque_t)
+    {
+        return serializeElements(deque_t);
+    }
+
 #ifdef _MSC_VER
     /*!
      * @brief This function template serializes a sequence of booleans.
@@ -1232,6 +1435,27 @@ public:
         return *this;
     }
 
+    /*!
+     * @brief This function template serializes an array of key/value pairs.
+     * A std::vector of pairs kept sorted by key is serialized with the same wire format as a std::map.
+     * @param pair_t The array of pairs that will be serialized in the buffer.
+     * @param numElements Number of the elements in the array.
+     * @return Reference to the eprosima::fastcdr::FastCdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize in a position that exceeds the internal memory size.
+     */
+    template<class _K, class _T>
+    FastCdr& serializeArray(
+            const std::pair<_K, _T>* pair_t,
+            size_t numElements)
+    {
+        for (size_t count = 0; count < numElements; ++count)
+        {
+            *this << pair_t[count].first;
+            *this << pair_t[count].second;
+        }
+        return *this;
+    }
+
     /*!
      * @brief This function template serializes an array of non-basic type objects.
      * @param type_t The array of objects that will be serialized in the buffer.
@@ -1635,6 +1859,182 @@ public:
         return *this;
     }
 
+    /*!
+     * @brief This function template deserializes a map.
+     * The map ends up holding exactly the entries read from the buffer. Entries already in the map are reused:
+     * values whose key is received again are deserialized in place, and while keys arrive in ascending order
+     * new entries are inserted with a hint, so a sorted map is loaded in linear time.
+     * @param map_t The variable that will store the map read from the buffer.
+     * @return Reference to the eprosima::fastcdr::FastCdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize in a position that exceeds the internal memory size.
+     */
+    template<class _K, class _T>
+    FastCdr& deserialize(
+            std::map<_K, _T>& map_t)
+    {
+        uint32_t seqLength = 0;
+        state state_before_error(*this);
+
+        *this >> seqLength;
+
+        if ((m_lastPosition - m_currentPosition) < seqLength)
+        {
+            setState(state_before_error);
+            throw eprosima::fastcdr::exception::NotEnoughMemoryException(
+                      eprosima::fastcdr::exception::NotEnoughMemoryException::NOT_ENOUGH_MEMORY_MESSAGE_DEFAULT);
+        }
+
+        try
+        {
+            typename std::map<_K, _T>::key_compare key_comp = map_t.key_comp();
+            // Entries before it_pair were already received. Entries from it_pair on are previous contents.
+            typename std::map<_K, _T>::iterator it_pair = map_t.begin();
+            bool sorted = true;
+
+            for (uint32_t i = 0; i < seqLength; ++i)
+            {
+                _K key;
+                *this >> key;
+
+                if (sorted && it_pair != map_t.begin() && !key_comp(std::prev(it_pair)->first, key))
+                {
+                    // Keys are not in ascending order. Fall back to plain lookups.
+                    map_t.erase(it_pair, map_t.end());
+                    sorted = false;
+                }
+
+                if (!sorted)
+                {
+                    *this >> map_t[std::move(key)];
+                    continue;
+                }
+
+                // Previous entries with a lower key will not be received anymore.
+                bool reused = false;
+                while (it_pair != map_t.end() && key_comp(it_pair->first, key))
+                {
+                    typename std::map<_K, _T>::iterator next = std::next(it_pair);
+#if defined(__cpp_lib_node_extract)
+                    if (next == map_t.end() || key_comp(key, next->first))
+                    {
+                        // Move the node of the last stale entry to the received key.
+                        typename std::map<_K, _T>::node_type node = map_t.extract(it_pair);
+                        node.key() = std::move(key);
+                        it_pair = map_t.insert(next, std::move(node));
+                        reused = true;
+                        break;
+                    }
+#endif // if defined(__cpp_lib_node_extract)
+                    map_t.erase(it_pair);
+                    it_pair = next;
+                }
+
+                if (!reused && (it_pair == map_t.end() || key_comp(key, it_pair->first)))
+                {
+                    it_pair = map_t.emplace_hint(it_pair, std::piecewise_construct,
+                                    std::forward_as_tuple(std::move(key)), std::forward_as_tuple());
+                }
+
+                *this >> it_pair->second;
+                ++it_pair;
+            }
+
+            if (sorted)
+            {
+                map_t.erase(it_pair, map_t.end());
+            }
+        }
+        catch (eprosima::fastcdr::exception::Exception& ex)
+        {
+            setState(state_before_error);
+            ex.raise();
+        }
+
+        return *this;
+    }
+
+    /*!
+     * @brief This function template deserializes an unordered map.
+     * The previous contents of the map are discarded and its buckets are reserved from the length read from the buffer.
+     * @param map_t The variable that will store the unordered map read from the buffer.
+     * @return Reference to the eprosima::fastcdr::FastCdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize in a position that exceeds the internal memory size.
+     */
+    template<class _K, class _T>
+    FastCdr& deserialize(
+            std::unordered_map<_K, _T>& map_t)
+    {
+        return deserializeMapLike(map_t);
+    }
+
+    /*!
+     * @brief This function template deserializes a set from a sequence.
+     * The previous contents of the set are discarded. Elements received in ascending order are inserted in constant time.
+     * @param set_t The variable that will store the set read from the buffer.
+     * @return Reference to the eprosima::fastcdr::FastCdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize in a position that exceeds the internal memory size.
+     */
+    template<class _T>
+    FastCdr& deserialize(
+            std::set<_T>& set_t)
+    {
+        return deserializeSetLike(set_t);
+    }
+
+    /*!
+     * @brief This function template deserializes an unordered set from a sequence.
+     * The previous contents of the set are discarded and its buckets are reserved from the length read from the buffer.
+     * @param set_t The variable that will store the unordered set read from the buffer.
+     * @return Reference to the eprosima::fastcdr::FastCdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize in a position that exceeds the internal memory size.
+     */
+    template<class _T>
+    FastCdr& deserialize(
+            std::unordered_set<_T>& set_t)
+    {
+        return deserializeSetLike(set_t);
+    }
+
+    /*!
+     * @brief This function template deserializes a deque from a sequence.
+     * @param deque_t The variable that will store the deque read from the buffer.
+     * @return Reference to the eprosima::fastcdr::FastCdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize in a position that exceeds the internal memory size.
+     */
+    template<class _T>
+    FastCdr& deserialize(
+            std::deque<_T>& deque_t)
+    {
+        uint32_t seqLength = 0;
+        state state_before_error(*this);
+
+        *this >> seqLength;
+
+        if ((m_lastPosition - m_currentPosition) < seqLength)
+        {
+            setState(state_before_error);
+            throw eprosima::fastcdr::exception::NotEnoughMemoryException(
+                      eprosima::fastcdr::exception::NotEnoughMemoryException::NOT_ENOUGH_MEMORY_MESSAGE_DEFAULT);
+        }
+
+        try
+        {
+            deque_t.resize(seqLength);
+
+            for (auto it = deque_t.begin(); it != deque_t.end(); ++it)
+            {
+                *this >> *it;
+            }
+        }
+        catch (eprosima::fastcdr::exception::Exception& ex)
+        {
+            setState(state_before_error);
+            ex.raise();
+        }
+
+        return *this;
+    }
+
 #ifdef _MSC_VER
     /*!
      * @brief This function template deserializes a sequence of booleans.
@@ -1896,6 +2296,27 @@ public:
         return *this;
     }
 
+    /*!
+     * @brief This function template deserializes an array of key/value pairs.
+     * A std::map serialized in the buffer can be deserialized into a std::vector of pairs, which keeps it sorted by key.
+     * @param pair_t The variable that will store the array of pairs read from the buffer.
+     * @param numElements Number of the elements in the array.
+     * @return Reference to the eprosima::fastcdr::FastCdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize in a position that exceeds the internal memory size.
+     */
+    template<class _K, class _T>
+    FastCdr& deserializeArray(
+            std::pair<_K, _T>* pair_t,
+            size_t numElements)
+    {
+        for (size_t count = 0; count < numElements; ++count)
+        {
+            *this >> pair_t[count].first;
+            *this >> pair_t[count].second;
+        }
+        return *this;
+    }
+
     /*!
      * @brief This function template deserializes an array of non-basic type objects.
      * @param type_t The variable that will store the array of objects read from the buffer.
@@ -2047,6 +2468,173 @@ private:
             std::wstring*& sequence_t,
             size_t& numElements);
 
+    /*!
+     * @brief This function template serializes the elements of a container as a sequence.
+     * @param container_t The container that will be serialized in the buffer.
+     * @return Reference to the eprosima::fastcdr::FastCdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize in a position that exceeds the internal memory size.
+     */
+    template<class _C>
+    FastCdr& serializeElements(
+            const _C& container_t)
+    {
+        state state_before_error(*this);
+
+        *this << static_cast<int32_t>(container_t.size());
+
+        try
+        {
+            for (auto it = container_t.begin(); it != container_t.end(); ++it)
+            {
+                *this << *it;
+            }
+        }
+        catch (eprosima::fastcdr::exception::Exception& ex)
+        {
+            setState(state_before_error);
+            ex.raise();
+        }
+
+        return *this;
+    }
+
+    /*!
+     * @brief This function template serializes the entries of an associative container with the wire format of std::map.
+     * @param map_t The container that will be serialized in the buffer.
+     * @return Reference to the eprosima::fastcdr::FastCdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to serialize in a position that exceeds the internal memory size.
+     */
+    template<class _Map>
+    FastCdr& serializeMapLike(
+            const _Map& map_t)
+    {
+        state state_before_error(*this);
+
+        *this << static_cast<int32_t>(map_t.size());
+
+        try
+        {
+            for (auto it_pair = map_t.begin(); it_pair != map_t.end(); ++it_pair)
+            {
+                *this << it_pair->first;
+                *this << it_pair->second;
+            }
+        }
+        catch (eprosima::fastcdr::exception::Exception& ex)
+        {
+            setState(state_before_error);
+            ex.raise();
+        }
+
+        return *this;
+    }
+
+    /*!
+     * @brief This function template deserializes a map into an associative container, discarding its previous contents.
+     * @param map_t The variable that will store the entries read from the buffer.
+     * @return Reference to the eprosima::fastcdr::FastCdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize in a position that exceeds the internal memory size.
+     */
+    template<class _Map>
+    FastCdr& deserializeMapLike(
+            _Map& map_t)
+    {
+        uint32_t seqLength = 0;
+        state state_before_error(*this);
+
+        *this >> seqLength;
+
+        if ((m_lastPosition - m_currentPosition) < seqLength)
+        {
+            setState(state_before_error);
+            throw eprosima::fastcdr::exception::NotEnoughMemoryException(
+                      eprosima::fastcdr::exception::NotEnoughMemoryException::NOT_ENOUGH_MEMORY_MESSAGE_DEFAULT);
+        }
+
+        try
+        {
+            map_t.clear();
+            reserveBuckets(map_t, seqLength, 0);
+
+            for (uint32_t i = 0; i < seqLength; ++i)
+            {
+                typename _Map::key_type key;
+                *this >> key;
+                *this >> map_t[std::move(key)];
+            }
+        }
+        catch (eprosima::fastcdr::exception::Exception& ex)
+        {
+            setState(state_before_error);
+            ex.raise();
+        }
+
+        return *this;
+    }
+
+    /*!
+     * @brief This function template deserializes a sequence into a set, discarding its previous contents.
+     * Elements are inserted with an end() hint, so elements received in ascending order are inserted in constant time.
+     * @param set_t The variable that will store the elements read from the buffer.
+     * @return Reference to the eprosima::fastcdr::FastCdr object.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when trying to deserialize in a position that exceeds the internal memory size.
+     */
+    template<class _Set>
+    FastCdr& deserializeSetLike(
+            _Set& set_t)
+    {
+        uint32_t seqLength = 0;
+        state state_before_error(*this);
+
+        *this >> seqLength;
+
+        if ((m_lastPosition - m_currentPosition) < seqLength)
+        {
+            setState(state_before_error);
+            throw eprosima::fastcdr::exception::NotEnoughMemoryException(
+                      eprosima::fastcdr::exception::NotEnoughMemoryException::NOT_ENOUGH_MEMORY_MESSAGE_DEFAULT);
+        }
+
+        try
+        {
+            set_t.clear();
+            reserveBuckets(set_t, seqLength, 0);
+
+            for (uint32_t i = 0; i < seqLength; ++i)
+            {
+                typename _Set::value_type value;
+                *this >> value;
+                set_t.emplace_hint(set_t.end(), std::move(value));
+            }
+        }
+        catch (eprosima::fastcdr::exception::Exception& ex)
+        {
+            setState(state_before_error);
+            ex.raise();
+        }
+
+        return *this;
+    }
+
+    //! @brief This function template reserves the buckets of an unordered container for a number of elements.
+    template<class _C>
+    auto reserveBuckets(
+            _C& container_t,
+            uint32_t numElements,
+            int)->decltype(container_t.reserve(numElements), void())
+    {
+        container_t.reserve(numElements);
+    }
+
+    //! @brief This function template does nothing for an ordered container, which has no buckets.
+    template<class _C>
+    void reserveBuckets(
+            _C&,
+            uint32_t,
+            long)
+    {
+    }
+
 #if HAVE_CXX0X
     /*!
      * @brief This function template detects the content type of the STD container array and serializes the array.
@@ -0,0 +1,268 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _FASTCDR_FRAMERING_H_
+#define _FASTCDR_FRAMERING_H_
+
+#include "fastcdr_dll.h"
+#include "Cdr.h"
+#include "exceptions/Exception.h"
+#include <atomic>
+#include <memory>
+
+namespace eprosima {
+namespace fastcdr {
+/*!
+ * @brief This class passes serialized frames from one or several producer threads to one consumer thread through a
+ * lock-free ring of bytes.
+ * A producer reserves a contiguous slot, serializes into it in place, with eprosima::fastcdr::Cdr or
+ * eprosima::fastcdr::FastCdr over a eprosima::fastcdr::FastBuffer, and commits it. A slot never wraps: when it does
+ * not fit before the end of the ring, the bytes up to the end are skipped and the slot starts at the beginning.
+ * The consumer reads the committed frames in place and in order of reservation.
+ * Each slot starts with a 16-byte header, and frames start at multiples of 16 bytes. The header is stamped with the
+ * position of the slot in the stream, so the consumer rejects the headers left by older turns of the ring, and a
+ * released slot does not need to be cleared.
+ * With a single producer, handing a frame over costs a store to commit it and a store to release it. With several,
+ * the reservation takes a compare-and-swap too.
+ * @ingroup FASTCDRAPIREFERENCE
+ */
+class Cdr_DllAPI FrameRing
+{
+public:
+
+    //! @brief A slot of the ring.
+    struct Frame
+    {
+        //! @brief Pointer to the bytes of the slot, or a null pointer if there is no slot.
+        char* data;
+
+        //! @brief The number of bytes of the slot. For a committed frame, its length.
+        size_t size;
+    };
+
+    /*!
+     * @brief Default constructor.
+     * @param capacity The number of bytes of the ring. It is rounded up to a power of two, and at least 64.
+     * @param multipleProducers True if several threads reserve slots at the same time.
+     * @exception exception::BadParamException This exception is thrown when the capacity exceeds 2^31 bytes.
+     */
+    FrameRing(
+            size_t capacity,
+            bool multipleProducers = false);
+
+    //! @brief Default destructor.
+    ~FrameRing();
+
+    /*!
+     * @brief This function returns the number of bytes of the ring.
+     * @return The capacity of the ring.
+     */
+    size_t capacity() const
+    {
+        return m_capacity;
+    }
+
+    /*!
+     * @brief This function reserves a slot. It is called by the producers.
+     * Every reserved slot has to be committed or aborted, as the consumer waits for it.
+     * @param size The maximum number of bytes of the frame. It cannot exceed half the capacity minus 16 bytes.
+     * @return The slot, whose data is aligned to 16 bytes, or a slot with a null pointer if the ring is full.
+     * @exception exception::BadParamException This exception is thrown when the frame is too large for the ring.
+     */
+    Frame reserve(
+            size_t size);
+
+    /*!
+     * @brief This function commits a reserved slot, making its frame visible to the consumer.
+     * @param frame The reserved slot.
+     * @param length The length of the frame. It cannot be greater than the size of the slot.
+     */
+    void commit(
+            const Frame& frame,
+            size_t length);
+
+    /*!
+     * @brief This function discards a reserved slot. The consumer skips it.
+     * @param frame The reserved slot.
+     */
+    void abort(
+            const Frame& frame);
+
+    /*!
+     * @brief This function template serializes a value in a new frame.
+     * If the serialization fails, the slot is aborted.
+     * @param value The value that will be serialized.
+     * @param maxSize The maximum number of bytes of the frame.
+     * @param endianness The endianness of the frame. The default value is the endianness of the system.
+     * @param cdrType The type of CDR of the frame. The default value is DDS CDR, with an encapsulation.
+     * @return False if the ring is full.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when the value exceeds the maximum size.
+     */
+    template<class _T>
+    bool push(
+            const _T& value,
+            size_t maxSize,
+            const Cdr::Endianness endianness = Cdr::DEFAULT_ENDIAN,
+            const Cdr::CdrType cdrType = Cdr::DDS_CDR)
+    {
+        Frame frame = reserve(maxSize);
+
+        if (frame.data == nullptr)
+        {
+            return false;
+        }
+
+        FastBuffer buffer(frame.data, frame.size);
+        Cdr cdr(buffer, endianness, cdrType);
+
+        try
+        {
+            cdr.serialize_encapsulation();
+            cdr << value;
+        }
+        catch (exception::Exception& ex)
+        {
+            abort(frame);
+            ex.raise();
+        }
+
+        commit(frame, cdr.getSerializedDataLength());
+        return true;
+    }
+
+    /*!
+     * @brief This function returns the oldest committed frame without releasing it. It is called by the consumer.
+     * @return The frame, or a frame with a null pointer if the oldest slot is not committed yet.
+     */
+    Frame front();
+
+    /*!
+     * @brief This function releases the frame returned by eprosima::fastcdr::FrameRing::front, so its bytes can be
+     * reserved again.
+     */
+    void pop();
+
+    /*!
+     * @brief This function template deserializes the oldest committed frame and releases it.
+     * The frame is released even if the deserialization fails.
+     * @param value The variable that will store the value read from the frame.
+     * @param endianness The endianness of the frame when it has no encapsulation. The default value is the endianness of the system.
+     * @param cdrType The type of CDR of the frame. The default value is DDS CDR, with an encapsulation.
+     * @return False if there is no committed frame.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when the value exceeds the frame.
+     * @exception exception::BadParamException This exception is thrown when the encapsulation is not valid.
+     */
+    template<class _T>
+    bool pop(
+            _T& value,
+            const Cdr::Endianness endianness = Cdr::DEFAULT_ENDIAN,
+            const Cdr::CdrType cdrType = Cdr::DDS_CDR)
+    {
+        Frame frame = front();
+
+        if (frame.data == nullptr)
+        {
+            return false;
+        }
+
+        FastBuffer buffer(frame.data, frame.size);
+        Cdr cdr(buffer, endianness, cdrType);
+
+        try
+        {
+            cdr.read_encapsulation();
+            cdr >> value;
+        }
+        catch (exception::Exception& ex)
+        {
+            pop();
+            ex.raise();
+        }
+
+        pop();
+        return true;
+    }
+
+private:
+
+    FrameRing(
+            const FrameRing&) = delete;
+
+    FrameRing& operator =(
+            const FrameRing&) = delete;
+
+    /*!
+     * @brief This function returns the stamp of the slot at a position of the ring, the first word of its header.
+     * @param position The position, a multiple of 16.
+     * @return Reference to the stamp.
+     */
+    std::atomic<uint64_t>& stamp(
+            size_t position) const
+    {
+        return m_words[position / sizeof(uint64_t)];
+    }
+
+    /*!
+     * @brief This function returns the sizes of the slot at a position of the ring, the second word of its header.
+     * @param position The position, a multiple of 16.
+     * @return Reference to the sizes.
+     */
+    std::atomic<uint64_t>& sizes(
+            size_t position) const
+    {
+        return m_words[position / sizeof(uint64_t) + 1];
+    }
+
+    /*!
+     * @brief This function publishes the header of a slot.
+     * @param position The position of the slot in the ring.
+     * @param streamPosition The position of the slot in the stream.
+     * @param slot The number of bytes of the slot, header included.
+     * @param length The length of the frame.
+     */
+    void publish(
+            size_t position,
+            size_t streamPosition,
+            size_t slot,
+            uint64_t length);
+
+    //! @brief The ring, as 8-byte words so that the headers can be accessed atomically.
+    std::unique_ptr<std::atomic<uint64_t>[]> m_words;
+
+    //! @brief The ring, as bytes.
+    char* m_buffer;
+
+    //! @brief The number of bytes of the ring, a power of two.
+    size_t m_capacity;
+
+    //! @brief True if several threads reserve slots at the same time.
+    bool m_multipleProducers;
+
+    //! @brief The total number of bytes reserved. With a single producer, only the producer accesses it.
+    std::atomic<size_t> m_head;
+
+    //! @brief The tail last read by the single producer, so it is not read again until the ring seems full.
+    size_t m_cachedTail;
+
+    //! @brief The total number of bytes released by the consumer.
+    std::atomic<size_t> m_tail;
+
+    //! @brief The slot returned by eprosima::fastcdr::FrameRing::front, read again by eprosima::fastcdr::FrameRing::pop.
+    size_t m_frontSlot;
+};
+
+} //namespace fastcdr
+} //namespace eprosima
+
+#endif // _FASTCDR_FRAMERING_H_
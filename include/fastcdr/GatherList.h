@@ -0,0 +1,170 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _FASTCDR_GATHERLIST_H_
+#define _FASTCDR_GATHERLIST_H_
+
+#include "fastcdr_dll.h"
+#include "Cdr.h"
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <sys/uio.h>
+#endif // if !defined(_WIN32)
+
+namespace eprosima {
+namespace fastcdr {
+/*!
+ * @brief This class records the arrays that an eprosima::fastcdr::Cdr object references instead of copying.
+ * When a gather list is set in a Cdr object, arrays of primitives whose size reaches the threshold are not copied
+ * into the buffer. Their alignment is still written in the buffer, and the serialized stream is the sequence of
+ * segments returned by getSegments(), alternating bytes of the buffer and referenced arrays.
+ * The referenced arrays must not be modified or freed until the segments have been sent.
+ * @ingroup FASTCDRAPIREFERENCE
+ */
+class Cdr_DllAPI GatherList
+{
+public:
+
+    //! @brief A contiguous part of the serialized stream.
+    struct Segment
+    {
+        //! @brief Pointer to the first byte of the segment.
+        const char* data;
+
+        //! @brief Number of bytes of the segment.
+        size_t size;
+    };
+
+    /*!
+     * @brief Default constructor.
+     * @param threshold The minimum size in bytes of the arrays that are referenced instead of copied.
+     */
+    GatherList(
+            size_t threshold = 4096);
+
+    /*!
+     * @brief This function returns the minimum size in bytes of the arrays that are referenced instead of copied.
+     * @return The threshold.
+     */
+    size_t getThreshold() const
+    {
+        return m_threshold;
+    }
+
+    /*!
+     * @brief This function sets the minimum size in bytes of the arrays that are referenced instead of copied.
+     * @param threshold The new threshold.
+     */
+    void setThreshold(
+            size_t threshold)
+    {
+        m_threshold = threshold;
+    }
+
+    /*!
+     * @brief This function removes all the referenced arrays.
+     * eprosima::fastcdr::Cdr::reset calls it on the gather list set in the Cdr object.
+     */
+    void clear();
+
+    /*!
+     * @brief This function returns the number of referenced arrays.
+     * @return The number of referenced arrays.
+     */
+    size_t getExternalCount() const
+    {
+        return m_externals.size();
+    }
+
+    /*!
+     * @brief This function returns the number of bytes of the serialized stream, including the referenced arrays.
+     * @param cdr The object that serialized the stream using this gather list.
+     * @return The total number of bytes.
+     */
+    size_t getTotalSize(
+            const Cdr& cdr) const
+    {
+        return cdr.getSerializedDataLength() + m_externalSize;
+    }
+
+    /*!
+     * @brief This function returns the segments of the serialized stream in order.
+     * @param cdr The object that serialized the stream using this gather list.
+     * @return The segments. Pointers to the buffer are invalidated if the buffer is resized.
+     */
+    std::vector<Segment> getSegments(
+            const Cdr& cdr) const;
+
+#if !defined(_WIN32)
+    /*!
+     * @brief This function returns the segments of the serialized stream in order, ready to be used with writev or sendmsg.
+     * @param cdr The object that serialized the stream using this gather list.
+     * @return The segments. Pointers to the buffer are invalidated if the buffer is resized.
+     */
+    std::vector<struct iovec> getIovecs(
+            const Cdr& cdr) const;
+#endif // if !defined(_WIN32)
+
+private:
+
+    friend class Cdr;
+
+    //! @brief An array referenced instead of copied.
+    struct External
+    {
+        //! @brief The position in the buffer where the array would have been copied.
+        size_t offset;
+
+        //! @brief Pointer to the array.
+        const char* data;
+
+        //! @brief Number of bytes of the array.
+        size_t size;
+    };
+
+    /*!
+     * @brief This function records a referenced array.
+     * @param offset The position in the buffer where the array would have been copied.
+     * @param data Pointer to the array.
+     * @param size Number of bytes of the array.
+     */
+    void addExternal(
+            size_t offset,
+            const char* data,
+            size_t size);
+
+    /*!
+     * @brief This function removes the referenced arrays recorded after the first ones.
+     * @param count The number of referenced arrays that are kept.
+     */
+    void truncate(
+            size_t count);
+
+    //! @brief The minimum size in bytes of the arrays that are referenced.
+    size_t m_threshold;
+
+    //! @brief The referenced arrays, in order.
+    std::vector<External> m_externals;
+
+    //! @brief The number of bytes of all the referenced arrays.
+    size_t m_externalSize;
+};
+
+} //namespace fastcdr
+} //namespace eprosima
+
+#endif // _FASTCDR_GATHERLIST_H_
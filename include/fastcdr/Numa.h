@@ -0,0 +1,84 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _FASTCDR_NUMA_H_
+#define _FASTCDR_NUMA_H_
+
+#include "fastcdr_dll.h"
+#include <cstddef>
+
+namespace eprosima {
+namespace fastcdr {
+/*!
+ * @brief This class gives access to the NUMA nodes of the machine, to keep the memory of the buffers on the node of
+ * the threads that serialize into them.
+ * It uses the system calls of Linux directly. On other systems, or when the calls are not allowed, the machine is
+ * seen as a single node and the functions that place memory or threads do nothing.
+ * @ingroup FASTCDRAPIREFERENCE
+ */
+class Cdr_DllAPI Numa
+{
+public:
+
+    //! @brief The value returned when the node of some memory is not known.
+    static const size_t UNKNOWN_NODE;
+
+    /*!
+     * @brief This function returns the number of NUMA nodes.
+     * @return The highest node number plus one, or one if the nodes are not known.
+     */
+    static size_t getNodeCount();
+
+    /*!
+     * @brief This function returns the node of the processor running the calling thread.
+     * @return The node, or zero if it is not known.
+     */
+    static size_t getCurrentNode();
+
+    /*!
+     * @brief This function returns the node that holds the memory of an address.
+     * The page of the address is allocated if it was not yet.
+     * @param address The address.
+     * @return The node, or eprosima::fastcdr::Numa::UNKNOWN_NODE if it is not known.
+     */
+    static size_t getMemoryNode(
+            const void* address);
+
+    /*!
+     * @brief This function places the pages of a memory region on a node.
+     * The pages already allocated are moved, and the ones allocated later are taken from the node while it has free
+     * memory. Only the pages fully inside the region are placed, so the pages of other allocations are not changed.
+     * @param address The beginning of the region.
+     * @param size The number of bytes of the region.
+     * @param node The node.
+     * @return True if the pages were placed on the node.
+     */
+    static bool bindMemory(
+            void* address,
+            size_t size,
+            size_t node);
+
+    /*!
+     * @brief This function restricts the calling thread to the processors of a node.
+     * @param node The node.
+     * @return True if the thread runs on the node from now on.
+     */
+    static bool runOnNode(
+            size_t node);
+};
+
+} //namespace fastcdr
+} //namespace eprosima
+
+#endif // _FASTCDR_NUMA_H_
@@ -0,0 +1,318 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _FASTCDR_RECORDING_H_
+#define _FASTCDR_RECORDING_H_
+
+#include "fastcdr_dll.h"
+#include "Cdr.h"
+#include "CdrSink.h"
+#include "exceptions/Exception.h"
+#include <string>
+
+#if !defined(_WIN32)
+
+namespace eprosima {
+namespace fastcdr {
+/*!
+ * @brief This class writes a recording of timestamped samples.
+ * A recording is made of two files. The data file holds the samples one after the other, each one starting at a
+ * multiple of 8 bytes and with its own encapsulation. The index file, named as the data file plus ".idx", holds an
+ * 8-byte header followed by one entry per sample with its timestamp, offset and length, so a sample can be found by
+ * a binary search. Both files are written through large buffered writes.
+ * @ingroup FASTCDRAPIREFERENCE
+ */
+class Cdr_DllAPI RecordingWriter
+{
+public:
+
+    /*!
+     * @brief Default constructor. The files are created, or truncated if they exist.
+     * @param path The path of the data file.
+     * @param endianness The endianness of the samples and the index. The default value is the endianness of the system.
+     * @param bufferSize The size of the buffer where the samples are serialized before being written. At least
+     * 64 bytes are used.
+     * @exception exception::BadParamException This exception is thrown when the files cannot be created.
+     */
+    RecordingWriter(
+            const std::string& path,
+            const Cdr::Endianness endianness = Cdr::DEFAULT_ENDIAN,
+            size_t bufferSize = 1024 * 1024);
+
+    //! @brief Default destructor. The recording is closed.
+    ~RecordingWriter();
+
+    /*!
+     * @brief This function starts a new sample.
+     * @param timestamp The timestamp of the sample. It cannot be lower than the timestamp of the previous sample.
+     * @return Reference to the eprosima::fastcdr::Cdr object where the sample has to be serialized.
+     * @exception exception::BadParamException This exception is thrown when the timestamp is lower than the previous
+     * one, when the previous sample was not ended or when the recording is closed.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when the data file cannot be written.
+     */
+    Cdr& beginSample(
+            uint64_t timestamp);
+
+    /*!
+     * @brief This function ends the current sample, adding its entry to the index.
+     * @exception exception::BadParamException This exception is thrown when there is no sample in progress.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when the index file cannot be written.
+     */
+    void endSample();
+
+    /*!
+     * @brief This function discards the current sample. It is not added to the index, and the bytes already written
+     * are left unreferenced in the data file.
+     */
+    void abortSample();
+
+    /*!
+     * @brief This function template serializes a sample.
+     * If the serialization fails, the sample is discarded.
+     * @param timestamp The timestamp of the sample. It cannot be lower than the timestamp of the previous sample.
+     * @param sample The sample that will be serialized.
+     * @exception exception::BadParamException This exception is thrown when the timestamp is lower than the previous one.
+     * @exception exception::NotEnoughMemoryException This exception is thrown when the files cannot be written.
+     */
+    template<class _T>
+    void write(
+            uint64_t timestamp,
+            const _T& sample)
+    {
+        Cdr& cdr = beginSample(timestamp);
+
+        try
+        {
+            cdr << sample;
+        }
+        catch (exception::Exception& ex)
+        {
+            abortSample();
+            ex.raise();
+        }
+
+        endSample();
+    }
+
+    /*!
+     * @brief This function returns the number of samples in the recording.
+     * @return The number of ended samples.
+     */
+    size_t size() const
+    {
+        return m_sampleCount;
+    }
+
+    /*!
+     * @brief This function writes the buffered samples and index entries to the files.
+     * @return True if everything was written.
+     */
+    bool flush();
+
+    /*!
+     * @brief This function flushes and closes the files. A sample in progress is discarded.
+     * @return True if everything was written.
+     */
+    bool close();
+
+private:
+
+    RecordingWriter(
+            const RecordingWriter&) = delete;
+
+    RecordingWriter& operator =(
+            const RecordingWriter&) = delete;
+
+    //! @brief This function returns the position of the next byte in the data file.
+    size_t getDataPosition() const
+    {
+        return m_dataCdr.getFlushedBytes() + m_dataCdr.getSerializedDataLength();
+    }
+
+    //! @brief The file descriptor of the data file.
+    int m_dataFd;
+
+    //! @brief The file descriptor of the index file.
+    int m_indexFd;
+
+    //! @brief The sink that writes the data file.
+    FileDescriptorSink m_dataSink;
+
+    //! @brief The sink that writes the index file.
+    FileDescriptorSink m_indexSink;
+
+    //! @brief The window where the samples are serialized.
+    FastBuffer m_dataBuffer;
+
+    //! @brief The window where the index entries are serialized.
+    FastBuffer m_indexBuffer;
+
+    //! @brief The object that serializes the samples.
+    Cdr m_dataCdr;
+
+    //! @brief The object that serializes the index entries.
+    Cdr m_indexCdr;
+
+    //! @brief True while a sample is in progress.
+    bool m_inSample;
+
+    //! @brief The timestamp of the sample in progress.
+    uint64_t m_sampleTimestamp;
+
+    //! @brief The timestamp of the last ended sample.
+    uint64_t m_lastTimestamp;
+
+    //! @brief The position in the data file of the sample in progress.
+    size_t m_sampleOffset;
+
+    //! @brief The number of ended samples.
+    size_t m_sampleCount;
+};
+
+/*!
+ * @brief This class reads a recording written by eprosima::fastcdr::RecordingWriter.
+ * Both files are mapped in memory, so opening the recording does not read the samples, finding a timestamp takes
+ * a binary search over the index and the samples are deserialized in place.
+ * Index entries whose sample is not complete in the data file, as after a crash, are ignored.
+ * @ingroup FASTCDRAPIREFERENCE
+ */
+class Cdr_DllAPI RecordingReader
+{
+public:
+
+    /*!
+     * @brief Default constructor.
+     * @param path The path of the data file.
+     * @exception exception::BadParamException This exception is thrown when the files cannot be opened or the index is not valid.
+     */
+    explicit RecordingReader(
+            const std::string& path);
+
+    //! @brief Default destructor. The files are unmapped.
+    ~RecordingReader();
+
+    /*!
+     * @brief This function returns the number of samples in the recording.
+     * @return The number of samples.
+     */
+    size_t size() const
+    {
+        return m_sampleCount;
+    }
+
+    /*!
+     * @brief This function finds the first sample whose timestamp is not lower than a given one.
+     * @param timestamp The timestamp.
+     * @return The index of the sample, or the number of samples if every timestamp is lower.
+     * @exception exception::BadParamException This exception is thrown when an entry read in the index file references
+     * bytes outside of the data file.
+     */
+    size_t seek(
+            uint64_t timestamp) const;
+
+    /*!
+     * @brief This function returns the timestamp of a sample.
+     * @param index The index of the sample.
+     * @return The timestamp.
+     * @exception exception::BadParamException This exception is thrown when the index is out of range or its entry in
+     * the index file references bytes outside of the data file.
+     */
+    uint64_t getTimestamp(
+            size_t index) const;
+
+    /*!
+     * @brief This function returns the serialized bytes of a sample, including its encapsulation.
+     * @param index The index of the sample.
+     * @return Pointer to the sample in the mapped data file.
+     * @exception exception::BadParamException This exception is thrown when the index is out of range or its entry in
+     * the index file references bytes outside of the data file.
+     */
+    const char* getSampleData(
+            size_t index) const;
+
+    /*!
+     * @brief This function returns the length of a sample, including its encapsulation.
+     * @param index The index of the sample.
+     * @return The length of the sample.
+     * @exception exception::BadParamException This exception is thrown when the index is out of range or its entry in
+     * the index file references bytes outside of the data file.
+     */
+    size_t getSampleSize(
+            size_t index) const;
+
+    /*!
+     * @brief This function returns an object that deserializes a sample in place.
+     * The object is valid until the next call to this function.
+     * @param index The index of the sample.
+     * @return Reference to the eprosima::fastcdr::Cdr object, positioned after the encapsulation.
+     * @exception exception::BadParamException This exception is thrown when the index is out of range, its entry in
+     * the index file references bytes outside of the data file, or the encapsulation is not valid.
+     */
+    Cdr& getSample(
+            size_t index);
+
+private:
+
+    RecordingReader(
+            const RecordingReader&) = delete;
+
+    RecordingReader& operator =(
+            const RecordingReader&) = delete;
+
+    /*!
+     * @brief This function reads an entry of the index.
+     * @param index The index of the entry.
+     * @param timestamp The timestamp of the sample.
+     * @param offset The position of the sample in the data file.
+     * @param length The length of the sample.
+     * @exception exception::BadParamException This exception is thrown when the index is out of range or the entry
+     * references bytes outside of the data file.
+     */
+    void readEntry(
+            size_t index,
+            uint64_t& timestamp,
+            uint64_t& offset,
+            uint64_t& length) const;
+
+    //! @brief The mapped data file. It is mapped read-only, and only deserialized.
+    char* m_data;
+
+    //! @brief The length of the data file.
+    size_t m_dataSize;
+
+    //! @brief The mapped index file.
+    char* m_index;
+
+    //! @brief The length of the index file.
+    size_t m_indexSize;
+
+    //! @brief The endianness of the samples and the index.
+    Cdr::Endianness m_endianness;
+
+    //! @brief The number of complete samples.
+    size_t m_sampleCount;
+
+    //! @brief A buffer over the current sample, without copying it.
+    FastBuffer m_sampleBuffer;
+
+    //! @brief The object that deserializes the current sample.
+    Cdr m_sample;
+};
+
+} //namespace fastcdr
+} //namespace eprosima
+
+#endif // if !defined(_WIN32)
+
+#endif // _FASTCDR_RECORDING_H_
@@ -0,0 +1,254 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _FASTCDR_RESUMABLEDESERIALIZER_H_
+#define _FASTCDR_RESUMABLEDESERIALIZER_H_
+
+#include "fastcdr_dll.h"
+#include "Cdr.h"
+#include "exceptions/BadParamException.h"
+#include "exceptions/NotEnoughMemoryException.h"
+#include <type_traits>
+#include <vector>
+
+namespace eprosima {
+namespace fastcdr {
+/*!
+ * @brief This class deserializes a CDR stream that arrives in chunks, without waiting for the whole stream.
+ * The deserialization is written as a series of steps. A step is run over the bytes received so far: if they are
+ * not enough, the step is rolled back and it returns false, and it has to be called again after feeding the next chunk.
+ * When a step succeeds its bytes are discarded, so only the bytes of the step in progress are kept in memory.
+ * Alignment is computed on the offset in the whole stream.
+ * @ingroup FASTCDRAPIREFERENCE
+ */
+class Cdr_DllAPI ResumableDeserializer
+{
+public:
+
+    /*!
+     * @brief Default constructor.
+     * @param endianness The endianness of the stream. The default value is the endianness of the system.
+     * @param cdrType The type of CDR of the stream. The default value is CORBA CDR.
+     */
+    ResumableDeserializer(
+            const Cdr::Endianness endianness = Cdr::DEFAULT_ENDIAN,
+            const Cdr::CdrType cdrType = Cdr::CORBA_CDR);
+
+    /*!
+     * @brief This function appends the next chunk of the stream. The bytes are copied.
+     * @param data Pointer to the chunk.
+     * @param size Number of bytes of the chunk.
+     */
+    void feed(
+            const char* data,
+            size_t size);
+
+    /*!
+     * @brief This function reads the encapsulation of the stream. It should be the first step if the stream has one.
+     * @return True if the encapsulation was read, false if more bytes are needed.
+     * @exception exception::BadParamException This exception is thrown when the encapsulation is not valid.
+     */
+    bool readEncapsulation();
+
+    /*!
+     * @brief This function template runs a step of the deserialization over the bytes received so far.
+     * The step may be run again from the beginning with more bytes, so it must only assign the values it deserializes.
+     * Every call parses the step from its first byte, so a step whose bytes arrive in n chunks costs n times its
+     * size: long sequences of primitives should be read with deserializeSequence, and other values in small steps.
+     * The bytes kept for a step in progress are counted against the maxTotalAllocation limit.
+     * @param function The step. It receives a reference to an eprosima::fastcdr::Cdr object.
+     * @return True if the step finished, false if more bytes are needed.
+     * @exception exception::BadParamException This exception is thrown when the step deserializes an invalid value,
+     * or when it needs more bytes than the deserialization limits allow.
+     */
+    template<class _Function>
+    bool step(
+            _Function function)
+    {
+        FastBuffer buffer(m_pending.data(), m_pending.size());
+        Cdr cdr(buffer, m_endianness, m_cdrType);
+        cdr.setDeserializationLimits(m_limits);
+
+        try
+        {
+            // The buffer keeps the bytes before the first pending one that are needed to align as in the stream.
+            cdr.jump(m_begin);
+            function(cdr);
+        }
+        catch (exception::NotEnoughMemoryException&)
+        {
+            // All the pending bytes belong to the step, so they only grow until it finishes.
+            if (getPendingBytes() > m_limits.maxTotalAllocation)
+            {
+                throw exception::BadParamException("Bytes kept for a step exceed the deserialization limits");
+            }
+
+            return false;
+        }
+
+        consume(cdr.getSerializedDataLength() - m_begin);
+        return true;
+    }
+
+    /*!
+     * @brief This function template deserializes a value in one step.
+     * @param value The variable that will store the value.
+     * @return True if the value was deserialized, false if more bytes are needed.
+     * @exception exception::BadParamException This exception is thrown when the value is not valid.
+     */
+    template<class _T>
+    bool deserialize(
+            _T& value)
+    {
+        return step([&value](Cdr& cdr)
+                       {
+                           cdr >> value;
+                       });
+    }
+
+    /*!
+     * @brief This function template deserializes a sequence of primitives as its elements arrive.
+     * Each call deserializes the elements received so far, so a long sequence is never deserialized twice.
+     * It has to be called again with the same vector until it returns true, without deserializing anything else in between.
+     * @param vector_t The vector that will store the sequence.
+     * @return True if the whole sequence was deserialized, false if more bytes are needed.
+     * @exception exception::BadParamException This exception is thrown when the length exceeds the deserialization limits.
+     */
+    template<class _T>
+    bool deserializeSequence(
+            std::vector<_T>& vector_t)
+    {
+        static_assert(std::is_arithmetic<_T>::value && !std::is_same<_T, bool>::value &&
+                !std::is_same<_T, long double>::value && !std::is_same<_T, wchar_t>::value,
+                "Only sequences of primitives whose size in memory is their serialized size are supported");
+
+        if (!m_inSequence)
+        {
+            uint32_t length = 0;
+
+            if (!deserialize(length))
+            {
+                return false;
+            }
+
+            if ((length > m_limits.maxSequenceElements) || (length > m_limits.maxTotalAllocation / sizeof(_T)))
+            {
+                throw exception::BadParamException("Sequence length exceeds the deserialization limits");
+            }
+
+            vector_t.resize(length);
+            m_inSequence = true;
+            m_sequenceDone = 0;
+        }
+
+        while (m_sequenceDone < vector_t.size())
+        {
+            // Only the first piece is aligned, the next ones start right after the previous one.
+            size_t align = m_sequenceDone == 0 ? Cdr::alignment(m_begin, sizeof(_T)) : 0;
+            size_t available = m_pending.size() - m_begin;
+
+            if (available < align + sizeof(_T))
+            {
+                return false;
+            }
+
+            size_t count = (available - align) / sizeof(_T);
+            count = count < vector_t.size() - m_sequenceDone ? count : vector_t.size() - m_sequenceDone;
+
+            if (!step([&](Cdr& cdr)
+                    {
+                        cdr.deserializeArray(&vector_t[m_sequenceDone], count);
+                    }))
+            {
+                return false;
+            }
+
+            m_sequenceDone += count;
+        }
+
+        m_inSequence = false;
+        return true;
+    }
+
+    /*!
+     * @brief This function sets the limits checked on the lengths read while deserializing.
+     * @param limits The new limits.
+     */
+    void setDeserializationLimits(
+            const Cdr::DeserializationLimits& limits)
+    {
+        m_limits = limits;
+    }
+
+    /*!
+     * @brief This function returns the number of bytes of the stream deserialized so far.
+     * @return The offset of the next step in the stream.
+     */
+    size_t getConsumedBytes() const
+    {
+        return m_consumed;
+    }
+
+    /*!
+     * @brief This function returns the number of bytes received and not deserialized yet.
+     * @return The number of pending bytes.
+     */
+    size_t getPendingBytes() const
+    {
+        return m_pending.size() - m_begin;
+    }
+
+    /*!
+     * @brief This function discards the pending bytes and starts a new stream with the current endianness.
+     */
+    void reset();
+
+private:
+
+    /*!
+     * @brief This function discards the bytes deserialized by a step.
+     * @param size Number of bytes.
+     */
+    void consume(
+            size_t size);
+
+    //! @brief The endianness of the stream.
+    Cdr::Endianness m_endianness;
+
+    //! @brief The type of CDR of the stream.
+    Cdr::CdrType m_cdrType;
+
+    //! @brief The limits checked on the lengths read while deserializing.
+    Cdr::DeserializationLimits m_limits;
+
+    //! @brief The pending bytes, preceded by less than 8 bytes that keep the alignment of the stream.
+    std::vector<char> m_pending;
+
+    //! @brief The position of the first pending byte. It is congruent modulo 8 with its offset from the alignment origin.
+    size_t m_begin;
+
+    //! @brief The number of bytes of the stream deserialized so far.
+    size_t m_consumed;
+
+    //! @brief Whether a sequence is being deserialized.
+    bool m_inSequence;
+
+    //! @brief The number of elements of the sequence in progress already deserialized.
+    size_t m_sequenceDone;
+};
+
+} //namespace fastcdr
+} //namespace eprosima
+
+#endif // _FASTCDR_RESUMABLEDESERIALIZER_H_
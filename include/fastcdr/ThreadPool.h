@@ -0,0 +1,137 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _FASTCDR_THREADPOOL_H_
+#define _FASTCDR_THREADPOOL_H_
+
+#include "fastcdr_dll.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace eprosima {
+namespace fastcdr {
+/*!
+ * @brief This class keeps a set of worker threads that run the parallel paths of the library.
+ * The thread that calls eprosima::fastcdr::ThreadPool::parallelFor also runs tasks, so a pool without workers
+ * runs everything in the calling thread.
+ * @ingroup FASTCDRAPIREFERENCE
+ */
+class Cdr_DllAPI ThreadPool
+{
+public:
+
+    //! @brief The function that runs a task. It receives the index of the task.
+    typedef std::function<void (size_t)> Task;
+
+    /*!
+     * @brief Default constructor.
+     * @param numThreads The number of worker threads. By default, one less than the number of hardware threads,
+     * as the calling thread also works.
+     */
+    explicit ThreadPool(
+            size_t numThreads = defaultSize());
+
+    //! @brief Default destructor. It waits for the worker threads to finish.
+    ~ThreadPool();
+
+    /*!
+     * @brief This function returns the number of worker threads.
+     * @return The number of worker threads.
+     */
+    size_t size() const
+    {
+        return m_threads.size();
+    }
+
+    /*!
+     * @brief This function runs a number of tasks in parallel and waits for all of them.
+     * Tasks are taken in order by the worker threads and the calling thread as they become free. When called from
+     * inside a task, or when another call is in progress in the same pool, the tasks wait for it or run in the
+     * calling thread instead.
+     * @param numTasks The number of tasks.
+     * @param task The function that runs each task.
+     * @exception Any exception thrown by a task is thrown again once all the tasks have finished. If several tasks
+     * throw, the first one is kept.
+     */
+    void parallelFor(
+            size_t numTasks,
+            const Task& task);
+
+    /*!
+     * @brief This function returns the default number of worker threads.
+     * @return One less than the number of hardware threads, or zero if it is not known.
+     */
+    static size_t defaultSize();
+
+private:
+
+    ThreadPool(
+            const ThreadPool&) = delete;
+
+    ThreadPool& operator =(
+            const ThreadPool&) = delete;
+
+    //! @brief The loop of the worker threads.
+    void run();
+
+    //! @brief This function runs tasks of the current call until there are none left.
+    void work();
+
+    //! @brief The worker threads.
+    std::vector<std::thread> m_threads;
+
+    //! @brief Only one call to parallelFor uses the workers at a time.
+    std::mutex m_callMutex;
+
+    //! @brief Protects the state of the current call.
+    std::mutex m_mutex;
+
+    //! @brief Wakes up the worker threads when there is a new call or the pool is destroyed.
+    std::condition_variable m_wakeUp;
+
+    //! @brief Wakes up the calling thread when the workers leave the current call.
+    std::condition_variable m_finished;
+
+    //! @brief The function of the current call.
+    const Task* m_task;
+
+    //! @brief The number of tasks of the current call.
+    size_t m_numTasks;
+
+    //! @brief The index of the next task to run.
+    std::atomic<size_t> m_nextTask;
+
+    //! @brief Increases with every call, so workers join each call once.
+    size_t m_generation;
+
+    //! @brief The number of workers running tasks of the current call.
+    size_t m_activeWorkers;
+
+    //! @brief The first exception thrown by a task of the current call.
+    std::exception_ptr m_exception;
+
+    //! @brief True when the pool is being destroyed.
+    bool m_stop;
+};
+
+} //namespace fastcdr
+} //namespace eprosima
+
+#endif // _FASTCDR_THREADPOOL_H_
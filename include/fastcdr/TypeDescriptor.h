@@ -0,0 +1,256 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _FASTCDR_TYPEDESCRIPTOR_H_
+#define _FASTCDR_TYPEDESCRIPTOR_H_
+
+#include "fastcdr_dll.h"
+#include <stdint.h>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace eprosima {
+namespace fastcdr {
+/*!
+ * @brief This class describes the layout of a type serialized with eprosima::fastcdr::Cdr.
+ * It is used to locate and skip serialized values without deserializing them.
+ * @ingroup FASTCDRAPIREFERENCE
+ */
+class Cdr_DllAPI TypeDescriptor
+{
+public:
+
+    //! @brief This enumeration represents the kinds of types that can be described.
+    typedef enum
+    {
+        //! @brief A boolean, serialized as one byte.
+        TK_BOOLEAN,
+        //! @brief A character.
+        TK_CHAR,
+        //! @brief An octet.
+        TK_OCTET,
+        //! @brief A 16-bit signed integer.
+        TK_SHORT,
+        //! @brief A 16-bit unsigned integer.
+        TK_USHORT,
+        //! @brief A 32-bit signed integer.
+        TK_LONG,
+        //! @brief A 32-bit unsigned integer.
+        TK_ULONG,
+        //! @brief A 64-bit signed integer.
+        TK_LONGLONG,
+        //! @brief A 64-bit unsigned integer.
+        TK_ULONGLONG,
+        //! @brief A single precision floating point number.
+        TK_FLOAT,
+        //! @brief A double precision floating point number.
+        TK_DOUBLE,
+        //! @brief An extended precision floating point number, serialized as 16 bytes.
+        TK_LONGDOUBLE,
+        //! @brief A wide character, serialized as 4 bytes.
+        TK_WCHAR,
+        //! @brief A string.
+        TK_STRING,
+        //! @brief A wide-string.
+        TK_WSTRING,
+        //! @brief A sequence of elements of the same type.
+        TK_SEQUENCE,
+        //! @brief An array of a fixed number of elements of the same type.
+        TK_ARRAY,
+        //! @brief A structure of named members.
+        TK_STRUCTURE
+    } Kind;
+
+    /*!
+     * @brief This constructor creates the descriptor of a primitive type or a string.
+     * @param kind The kind of the type.
+     * @exception exception::BadParamException This exception is thrown when the kind is a sequence, an array or a structure.
+     */
+    TypeDescriptor(
+            Kind kind);
+
+    /*!
+     * @brief This function creates the descriptor of a sequence.
+     * @param element The descriptor of the elements of the sequence.
+     * @return The descriptor of the sequence.
+     */
+    static TypeDescriptor sequence(
+            const TypeDescriptor& element);
+
+    /*!
+     * @brief This function creates the descriptor of an array.
+     * @param element The descriptor of the elements of the array.
+     * @param length The number of elements of the array.
+     * @return The descriptor of the array.
+     */
+    static TypeDescriptor array(
+            const TypeDescriptor& element,
+            size_t length);
+
+    /*!
+     * @brief This function creates the descriptor of a structure without members.
+     * Members are added with addMember().
+     * @return The descriptor of the structure.
+     */
+    static TypeDescriptor structure();
+
+    /*!
+     * @brief This function adds a member at the end of a structure.
+     * @param name The name of the member.
+     * @param type The descriptor of the member.
+     * @return Reference to this descriptor.
+     * @exception exception::BadParamException This exception is thrown when this descriptor is not a structure.
+     */
+    TypeDescriptor& addMember(
+            const std::string& name,
+            const TypeDescriptor& type);
+
+    /*!
+     * @brief This function returns the kind of the type.
+     * @return The kind of the type.
+     */
+    Kind getKind() const
+    {
+        return m_kind;
+    }
+
+    /*!
+     * @brief This function returns whether the type is a primitive type.
+     * @return True if the type is a primitive type.
+     */
+    bool isPrimitive() const
+    {
+        return m_kind < TK_STRING;
+    }
+
+    /*!
+     * @brief This function returns the number of bytes a primitive type takes in the buffer.
+     * @return The serialized size, or zero if the type is not primitive.
+     */
+    size_t getSerializedSize() const;
+
+    /*!
+     * @brief This function returns the alignment of a primitive type in the buffer.
+     * @return The alignment, or zero if the type is not primitive.
+     */
+    size_t getAlignment() const;
+
+    /*!
+     * @brief This function returns the number of elements of an array.
+     * @return The number of elements.
+     */
+    size_t getLength() const
+    {
+        return m_length;
+    }
+
+    /*!
+     * @brief This function returns the descriptor of the elements of a sequence or an array.
+     * @return The descriptor of the elements.
+     * @exception exception::BadParamException This exception is thrown when the type is not a sequence or an array.
+     */
+    const TypeDescriptor& getElement() const;
+
+    /*!
+     * @brief This function returns the number of members of a structure.
+     * @return The number of members.
+     */
+    size_t getMemberCount() const
+    {
+        return m_members.size();
+    }
+
+    /*!
+     * @brief This function returns the descriptor of a member of a structure.
+     * @param index The index of the member.
+     * @return The descriptor of the member.
+     * @exception exception::BadParamException This exception is thrown when the index is out of range.
+     */
+    const TypeDescriptor& getMember(
+            size_t index) const;
+
+    /*!
+     * @brief This function returns the name of a member of a structure.
+     * @param index The index of the member.
+     * @return The name of the member.
+     * @exception exception::BadParamException This exception is thrown when the index is out of range.
+     */
+    const std::string& getMemberName(
+            size_t index) const;
+
+    /*!
+     * @brief This function returns the index of a member of a structure.
+     * @param name The name of the member.
+     * @return The index of the member.
+     * @exception exception::BadParamException This exception is thrown when there is no member with that name.
+     */
+    size_t getMemberIndex(
+            const std::string& name) const;
+
+private:
+
+    //! @brief A member of a structure.
+    struct Member
+    {
+        //! @brief The name of the member.
+        std::string name;
+
+        //! @brief The descriptor of the member.
+        std::shared_ptr<const TypeDescriptor> type;
+    };
+
+    //! @brief The kind of the type.
+    Kind m_kind;
+
+    //! @brief The number of elements, when the type is an array.
+    size_t m_length;
+
+    //! @brief The descriptor of the elements, when the type is a sequence or an array.
+    std::shared_ptr<const TypeDescriptor> m_element;
+
+    //! @brief The members, when the type is a structure.
+    std::vector<Member> m_members;
+};
+
+/*!
+ * @brief This class template gives the kind of a primitive type as eprosima::fastcdr::Cdr serializes it.
+ * Integers are matched by size and signedness, and both signed and unsigned bytes are octets.
+ * Any other type is given eprosima::fastcdr::TypeDescriptor::TK_STRUCTURE.
+ */
+template<class _T>
+struct TypeKind
+{
+    //! @brief The kind of the type.
+    static const TypeDescriptor::Kind value =
+            std::is_same<_T, bool>::value ? TypeDescriptor::TK_BOOLEAN :
+            std::is_same<_T, char>::value ? TypeDescriptor::TK_CHAR :
+            std::is_same<_T, wchar_t>::value ? TypeDescriptor::TK_WCHAR :
+            std::is_same<_T, float>::value ? TypeDescriptor::TK_FLOAT :
+            std::is_same<_T, double>::value ? TypeDescriptor::TK_DOUBLE :
+            std::is_same<_T, long double>::value ? TypeDescriptor::TK_LONGDOUBLE :
+            !std::is_integral<_T>::value ? TypeDescriptor::TK_STRUCTURE :
+            sizeof(_T) == 1 ? TypeDescriptor::TK_OCTET :
+            sizeof(_T) == 2 ? (std::is_signed<_T>::value ? TypeDescriptor::TK_SHORT : TypeDescriptor::TK_USHORT) :
+            sizeof(_T) == 4 ? (std::is_signed<_T>::value ? TypeDescriptor::TK_LONG : TypeDescriptor::TK_ULONG) :
+            sizeof(_T) == 8 ? (std::is_signed<_T>::value ? TypeDescriptor::TK_LONGLONG : TypeDescriptor::TK_ULONGLONG) :
+            TypeDescriptor::TK_STRUCTURE;
+};
+
+} //namespace fastcdr
+} //namespace eprosima
+
+#endif // _FASTCDR_TYPEDESCRIPTOR_H_
@@ -0,0 +1,122 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastcdr/Arena.h>
+
+#if !__APPLE__ && !__FreeBSD__ && !__VXWORKS__
+#include <malloc.h>
+#else
+#include <stdlib.h>
+#endif // if !__APPLE__ && !__FreeBSD__ && !__VXWORKS__
+
+using namespace eprosima::fastcdr;
+
+Arena::Arena(
+        size_t initialBlockSize)
+    : m_initialBlockSize(initialBlockSize)
+    , m_currentBlock(nullptr)
+    , m_currentPosition(nullptr)
+    , m_lastPosition(nullptr)
+    , m_allocatedBytes(0)
+{
+}
+
+Arena::~Arena()
+{
+    while (m_currentBlock != nullptr)
+    {
+        Block* previous = m_currentBlock->previous;
+        free(m_currentBlock);
+        m_currentBlock = previous;
+    }
+}
+
+void* Arena::allocate(
+        size_t size,
+        size_t alignment)
+{
+    size_t padding = (alignment - (reinterpret_cast<uintptr_t>(m_currentPosition) & (alignment - 1))) &
+            (alignment - 1);
+
+    if (static_cast<size_t>(m_lastPosition - m_currentPosition) < padding + size)
+    {
+        if (size > static_cast<size_t>(-1) - sizeof(Block) - alignment)
+        {
+            throw std::bad_alloc();
+        }
+
+        // Block sizes double, so the number of blocks grows logarithmically with the size of the message.
+        size_t blockSize = m_currentBlock != nullptr ? m_currentBlock->size * 2 : m_initialBlockSize;
+        if (blockSize < sizeof(Block) + alignment + size)
+        {
+            blockSize = sizeof(Block) + alignment + size;
+        }
+
+        Block* block = static_cast<Block*>(malloc(blockSize));
+
+        if (block == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+
+        block->previous = m_currentBlock;
+        block->size = blockSize;
+        m_currentBlock = block;
+        m_currentPosition = reinterpret_cast<char*>(block + 1);
+        m_lastPosition = reinterpret_cast<char*>(block) + blockSize;
+        padding = (alignment - (reinterpret_cast<uintptr_t>(m_currentPosition) & (alignment - 1))) &
+                (alignment - 1);
+    }
+
+    char* returnedValue = m_currentPosition + padding;
+    m_currentPosition = returnedValue + size;
+    m_allocatedBytes += padding + size;
+    return returnedValue;
+}
+
+void Arena::reset()
+{
+    // Keep only the largest block.
+    Block* largest = m_currentBlock;
+
+    for (Block* block = m_currentBlock; block != nullptr; block = block->previous)
+    {
+        if (block->size > largest->size)
+        {
+            largest = block;
+        }
+    }
+
+    while (m_currentBlock != nullptr)
+    {
+        Block* previous = m_currentBlock->previous;
+
+        if (m_currentBlock != largest)
+        {
+            free(m_currentBlock);
+        }
+
+        m_currentBlock = previous;
+    }
+
+    if (largest != nullptr)
+    {
+        largest->previous = nullptr;
+        m_currentBlock = largest;
+        m_currentPosition = reinterpret_cast<char*>(largest + 1);
+        m_lastPosition = reinterpret_cast<char*>(largest) + largest->size;
+    }
+
+    m_allocatedBytes = 0;
+}
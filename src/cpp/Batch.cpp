@@ -0,0 +1,358 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastcdr/Batch.h>
+#include <fastcdr/ThreadPool.h>
+#include <fastcdr/exceptions/BadParamException.h>
+
+#include <limits>
+
+using namespace eprosima::fastcdr;
+using namespace ::exception;
+
+namespace {
+
+// A range of messages is kept in one atomic word, the first index in the low half and the end in the high half, so
+// the owner and the thieves take messages from it with a compare-and-swap.
+uint64_t make_range(
+        uint64_t begin,
+        uint64_t end)
+{
+    return (end << 32) | begin;
+}
+
+uint64_t range_begin(
+        uint64_t range)
+{
+    return range & 0xFFFFFFFF;
+}
+
+uint64_t range_end(
+        uint64_t range)
+{
+    return range >> 32;
+}
+
+bool pop_front(
+        std::atomic<uint64_t>& range,
+        size_t& index)
+{
+    uint64_t current = range.load();
+
+    while (range_begin(current) < range_end(current))
+    {
+        if (range.compare_exchange_weak(current, make_range(range_begin(current) + 1, range_end(current))))
+        {
+            index = range_begin(current);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool steal_back(
+        std::atomic<uint64_t>& range,
+        uint64_t& stolen)
+{
+    uint64_t current = range.load();
+
+    while (range_begin(current) < range_end(current))
+    {
+        uint64_t middle = range_begin(current) + (range_end(current) - range_begin(current)) / 2;
+
+        if (range.compare_exchange_weak(current, make_range(range_begin(current), middle)))
+        {
+            stolen = make_range(middle, range_end(current));
+            return true;
+        }
+    }
+
+    return false;
+}
+
+} // namespace
+
+struct BatchDeserializer::Worker
+{
+    Worker(
+            const Cdr::Endianness endianness,
+            const Cdr::CdrType cdrType)
+        : cdr(buffer, endianness, cdrType)
+        , range(0)
+    {
+    }
+
+    //! @brief A buffer over the current message, without copying it.
+    FastBuffer buffer;
+
+    //! @brief The object that deserializes the messages of this thread.
+    Cdr cdr;
+
+    //! @brief The messages left to this thread.
+    std::atomic<uint64_t> range;
+};
+
+BatchWriter::BatchWriter(
+        FastBuffer& buffer,
+        const Cdr::Endianness endianness,
+        const Cdr::CdrType cdrType)
+    : m_cdr(buffer, endianness, cdrType)
+    , m_endianness(endianness)
+    , m_cdrType(cdrType)
+    , m_inMessage(false)
+    , m_frameOffset(0)
+    , m_lengthOffset(0)
+    , m_messageCount(0)
+{
+}
+
+Cdr& BatchWriter::beginMessage()
+{
+    if (m_inMessage)
+    {
+        throw BadParamException("The previous message of the batch was not ended");
+    }
+
+    m_frameOffset = m_cdr.getSerializedDataLength();
+
+    // The length is aligned from the beginning of the batch.
+    m_cdr.m_alignPosition = m_cdr.m_cdrBuffer.begin();
+    m_cdr.m_lastDataSize = 0;
+
+    try
+    {
+        m_cdr.serialize(static_cast<uint32_t>(0));
+        m_lengthOffset = m_cdr.getSerializedDataLength() - sizeof(uint32_t);
+        m_cdr.resetAlignment();
+        m_cdr.m_lastDataSize = 0;
+
+        if (m_cdrType == Cdr::DDS_CDR)
+        {
+            m_cdr.serialize_encapsulation();
+        }
+    }
+    catch (Exception&)
+    {
+        abortMessage();
+        throw;
+    }
+
+    m_inMessage = true;
+    return m_cdr;
+}
+
+BatchWriter& BatchWriter::endMessage()
+{
+    if (!m_inMessage)
+    {
+        throw BadParamException("There is no message of the batch in progress");
+    }
+
+    size_t length = m_cdr.getSerializedDataLength() - m_lengthOffset - sizeof(uint32_t);
+    FastBuffer lengthBuffer(m_cdr.getBufferPointer() + m_lengthOffset, sizeof(uint32_t));
+    Cdr lengthCdr(lengthBuffer, m_endianness);
+    lengthCdr.serialize(static_cast<uint32_t>(length));
+
+    m_inMessage = false;
+    ++m_messageCount;
+    return *this;
+}
+
+void BatchWriter::abortMessage()
+{
+    m_cdr.m_currentPosition = m_cdr.m_cdrBuffer.begin();
+    m_cdr.m_currentPosition += m_frameOffset;
+    m_cdr.m_alignPosition = m_cdr.m_cdrBuffer.begin();
+    m_cdr.m_lastDataSize = 0;
+    m_inMessage = false;
+}
+
+void BatchWriter::reset()
+{
+    m_cdr.reset();
+    m_inMessage = false;
+    m_frameOffset = 0;
+    m_lengthOffset = 0;
+    m_messageCount = 0;
+}
+
+BatchReader::BatchReader(
+        char* data,
+        size_t size,
+        const Cdr::Endianness endianness,
+        const Cdr::CdrType cdrType)
+    : m_data(data)
+    , m_size(size)
+    , m_offset(0)
+    , m_endianness(endianness)
+    , m_cdrType(cdrType)
+    , m_messageBuffer(data, 0)
+    , m_message(m_messageBuffer, endianness, cdrType)
+{
+}
+
+bool BatchReader::next()
+{
+    size_t offset = (m_offset + sizeof(uint32_t) - 1) & ~(sizeof(uint32_t) - 1);
+
+    if (offset >= m_size)
+    {
+        m_offset = m_size;
+        return false;
+    }
+
+    if (m_size - offset < sizeof(uint32_t))
+    {
+        throw NotEnoughMemoryException(NotEnoughMemoryException::NOT_ENOUGH_MEMORY_MESSAGE_DEFAULT);
+    }
+
+    uint32_t length = 0;
+    FastBuffer lengthBuffer(m_data + offset, sizeof(uint32_t));
+    Cdr lengthCdr(lengthBuffer, m_endianness);
+    lengthCdr.deserialize(length);
+    offset += sizeof(uint32_t);
+
+    if (length > m_size - offset)
+    {
+        throw NotEnoughMemoryException(NotEnoughMemoryException::NOT_ENOUGH_MEMORY_MESSAGE_DEFAULT);
+    }
+
+    m_messageBuffer = FastBuffer(m_data + offset, length);
+    m_message.reset();
+    m_offset = offset + length;
+
+    if (m_cdrType == Cdr::DDS_CDR)
+    {
+        m_message.read_encapsulation();
+    }
+
+    return true;
+}
+
+BatchDeserializer::BatchDeserializer(
+        ThreadPool& pool,
+        const Cdr::Endianness endianness,
+        const Cdr::CdrType cdrType)
+    : m_pool(pool)
+    , m_errorCount(0)
+    , m_cdrType(cdrType)
+{
+    for (size_t count = 0; count <= pool.size(); ++count)
+    {
+        m_workers.emplace_back(new Worker(endianness, cdrType));
+    }
+}
+
+BatchDeserializer::~BatchDeserializer()
+{
+}
+
+void BatchDeserializer::setDeserializationLimits(
+        const Cdr::DeserializationLimits& limits)
+{
+    for (std::unique_ptr<Worker>& worker : m_workers)
+    {
+        worker->cdr.setDeserializationLimits(limits);
+    }
+}
+
+size_t BatchDeserializer::deserialize(
+        const Message* messages,
+        size_t numMessages,
+        const Function& deserializeMessage)
+{
+    if (numMessages > (std::numeric_limits<uint32_t>::max)())
+    {
+        throw BadParamException("Too many messages in the batch");
+    }
+
+    m_errors.assign(numMessages, nullptr);
+    m_errorCount = 0;
+
+    for (size_t index = 0; index < m_workers.size(); ++index)
+    {
+        m_workers[index]->range = make_range(index * numMessages / m_workers.size(),
+                        (index + 1) * numMessages / m_workers.size());
+    }
+
+    m_pool.parallelFor(m_workers.size(), [&](size_t worker)
+            {
+                work(worker, messages, deserializeMessage);
+            });
+
+    return m_errorCount;
+}
+
+const std::exception_ptr& BatchDeserializer::getError(
+        size_t index) const
+{
+    if (index >= m_errors.size())
+    {
+        throw BadParamException("Batch message index out of range");
+    }
+
+    return m_errors[index];
+}
+
+void BatchDeserializer::work(
+        size_t worker,
+        const Message* messages,
+        const Function& deserializeMessage)
+{
+    Worker& self = *m_workers[worker];
+
+    while (true)
+    {
+        size_t index = 0;
+
+        while (pop_front(self.range, index))
+        {
+            self.buffer = FastBuffer(messages[index].data, messages[index].length);
+            self.cdr.reset();
+
+            try
+            {
+                if (m_cdrType == Cdr::DDS_CDR)
+                {
+                    self.cdr.read_encapsulation();
+                }
+
+                deserializeMessage(self.cdr, index);
+            }
+            catch (...)
+            {
+                m_errors[index] = std::current_exception();
+                ++m_errorCount;
+            }
+        }
+
+        // Once the own range is empty, half of the range of another thread is taken. Messages taken by a thief
+        // are not in any range until it stores them in its own, but then that thief deserializes them.
+        uint64_t stolen = 0;
+        bool found = false;
+
+        for (size_t count = 1; !found && (count < m_workers.size()); ++count)
+        {
+            found = steal_back(m_workers[(worker + count) % m_workers.size()]->range, stolen);
+        }
+
+        if (!found)
+        {
+            return;
+        }
+
+        self.range = stolen;
+    }
+}
@@ -0,0 +1,462 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastcdr/BufferPool.h>
+#include <fastcdr/Numa.h>
+#include <fastcdr/exceptions/NotEnoughMemoryException.h>
+
+#include <cstdlib>
+#include <functional>
+#include <thread>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif // if defined(__linux__)
+
+using namespace eprosima::fastcdr;
+using namespace ::exception;
+
+namespace {
+
+//! @brief The smallest class holds buffers of 2^8 bytes.
+const size_t MIN_CLASS_SHIFT = 8;
+
+const size_t MAGAZINE_SIZE = 16;
+
+const size_t SEGMENT_SIZE = 256;
+
+const size_t MAX_SEGMENTS = 4096;
+
+const uint32_t NO_MAGAZINE = 0xFFFFFFFF;
+
+//! @brief Buffers of this size or larger are placed on a NUMA node explicitly. Smaller ones are left to first touch.
+const size_t NUMA_MIN_SIZE = 64 * 1024;
+
+// The stacks of the depot keep the index of the top magazine in the low half and a counter of the changes in the
+// high half, so a magazine popped and pushed again meanwhile does not make a compare-and-swap succeed.
+uint64_t make_top(
+        uint64_t previous,
+        uint32_t index)
+{
+    return (((previous >> 32) + 1) << 32) | index;
+}
+
+uint32_t top_index(
+        uint64_t top)
+{
+    return static_cast<uint32_t>(top & NO_MAGAZINE);
+}
+
+} // namespace
+
+struct BufferPool::Magazine
+{
+    Magazine()
+        : count(0)
+        , next(NO_MAGAZINE)
+    {
+    }
+
+    //! @brief The memory of the buffers.
+    char* blocks[MAGAZINE_SIZE];
+
+    //! @brief The number of buffers.
+    size_t count;
+
+    //! @brief The next magazine in a stack of the depot.
+    std::atomic<uint32_t> next;
+};
+
+struct BufferPool::Cache
+{
+    explicit Cache(
+            size_t numClasses)
+        : busy(false)
+        , loaded(numClasses, NO_MAGAZINE)
+    {
+    }
+
+    //! @brief Set while a thread uses the cache. Other threads go to the depot meanwhile.
+    std::atomic<bool> busy;
+
+    //! @brief The magazine in use for each class.
+    std::vector<uint32_t> loaded;
+};
+
+BufferPool::BufferPool(
+        size_t maxRetainedBytes,
+        size_t maxBufferSize,
+        size_t numCaches)
+    : m_maxRetainedBytes(maxRetainedBytes)
+    , m_numClasses(1)
+    , m_numNodes(Numa::getNodeCount())
+    , m_cachesPerNode(1)
+    , m_retainedBytes(0)
+    , m_segments(new std::atomic<Magazine*>[MAX_SEGMENTS])
+    , m_magazineCount(0)
+{
+    while ((size_t(1) << (MIN_CLASS_SHIFT + m_numClasses - 1)) < maxBufferSize)
+    {
+        ++m_numClasses;
+    }
+
+    for (size_t index = 0; index < MAX_SEGMENTS; ++index)
+    {
+        m_segments[index] = nullptr;
+    }
+
+    m_fullMagazines.reset(new std::atomic<uint64_t>[m_numNodes * m_numClasses]);
+    m_emptyMagazines.reset(new std::atomic<uint64_t>[m_numNodes * m_numClasses]);
+
+    for (size_t index = 0; index < m_numNodes * m_numClasses; ++index)
+    {
+        m_fullMagazines[index] = NO_MAGAZINE;
+        m_emptyMagazines[index] = NO_MAGAZINE;
+    }
+
+    numCaches = numCaches > 0 ? numCaches : std::thread::hardware_concurrency();
+    m_cachesPerNode = (numCaches + m_numNodes - 1) / m_numNodes;
+    m_cachesPerNode = m_cachesPerNode > 0 ? m_cachesPerNode : 1;
+
+    for (size_t index = 0; index < m_numNodes * m_cachesPerNode; ++index)
+    {
+        m_caches.emplace_back(new Cache(m_numClasses));
+    }
+}
+
+BufferPool::~BufferPool()
+{
+    uint32_t count = m_magazineCount.load();
+
+    for (uint32_t index = 0; (index < count) && (index < SEGMENT_SIZE * MAX_SEGMENTS); ++index)
+    {
+        Magazine& magazine = getMagazine(index);
+
+        for (size_t block = 0; block < magazine.count; ++block)
+        {
+            free(magazine.blocks[block]);
+        }
+    }
+
+    for (size_t index = 0; index < MAX_SEGMENTS; ++index)
+    {
+        delete [] m_segments[index].load();
+    }
+}
+
+FastBuffer BufferPool::acquire(
+        size_t size)
+{
+    size_t classIndex = 0;
+
+    while ((classIndex < m_numClasses) && ((size_t(1) << (MIN_CLASS_SHIFT + classIndex)) < size))
+    {
+        ++classIndex;
+    }
+
+    size_t classSize = classIndex < m_numClasses ? size_t(1) << (MIN_CLASS_SHIFT + classIndex) : size;
+    char* block = nullptr;
+    size_t node = 0;
+    Cache& cache = getCache(node);
+
+    if (classIndex < m_numClasses)
+    {
+        if (!cache.busy.exchange(true, std::memory_order_acquire))
+        {
+            uint32_t& loaded = cache.loaded[classIndex];
+            size_t depot = getDepot(node, classIndex);
+
+            // An empty magazine is exchanged for a full one of the depot.
+            if ((loaded == NO_MAGAZINE) || (getMagazine(loaded).count == 0))
+            {
+                uint32_t full = pop(m_fullMagazines[depot]);
+
+                if (full != NO_MAGAZINE)
+                {
+                    if (loaded != NO_MAGAZINE)
+                    {
+                        push(m_emptyMagazines[depot], loaded);
+                    }
+
+                    loaded = full;
+                }
+            }
+
+            if ((loaded != NO_MAGAZINE) && (getMagazine(loaded).count > 0))
+            {
+                Magazine& magazine = getMagazine(loaded);
+                block = magazine.blocks[--magazine.count];
+            }
+
+            cache.busy.store(false, std::memory_order_release);
+        }
+        else
+        {
+            block = takeFromDepot(getDepot(node, classIndex));
+        }
+
+        if (block != nullptr)
+        {
+            m_retainedBytes.fetch_sub(classSize, std::memory_order_relaxed);
+        }
+    }
+
+    if (block == nullptr)
+    {
+        block = reinterpret_cast<char*>(malloc(classSize));
+
+        if (block == nullptr)
+        {
+            throw NotEnoughMemoryException(NotEnoughMemoryException::NOT_ENOUGH_MEMORY_MESSAGE_DEFAULT);
+        }
+
+        // The pages are placed before they are touched, so they stay on this node even if another thread writes first.
+        if ((m_numNodes > 1) && (classSize >= NUMA_MIN_SIZE))
+        {
+            Numa::bindMemory(block, classSize, node);
+        }
+    }
+
+    FastBuffer buffer;
+    buffer.m_buffer = block;
+    buffer.m_bufferSize = classSize;
+    return buffer;
+}
+
+void BufferPool::release(
+        FastBuffer& buffer)
+{
+    if (!buffer.m_internalBuffer || (buffer.m_buffer == nullptr))
+    {
+        return;
+    }
+
+    char* block = buffer.m_buffer;
+    size_t size = buffer.m_bufferSize;
+    buffer.m_buffer = nullptr;
+    buffer.m_bufferSize = 0;
+
+    // A buffer that grew is kept in the largest class it fills.
+    size_t classIndex = 0;
+
+    while ((classIndex + 1 < m_numClasses) && ((size_t(1) << (MIN_CLASS_SHIFT + classIndex + 1)) <= size))
+    {
+        ++classIndex;
+    }
+
+    size_t classSize = size_t(1) << (MIN_CLASS_SHIFT + classIndex);
+
+    if ((size < classSize) || (size >= 2 * classSize))
+    {
+        free(block);
+        return;
+    }
+
+    if (m_retainedBytes.fetch_add(classSize, std::memory_order_relaxed) + classSize > m_maxRetainedBytes)
+    {
+        m_retainedBytes.fetch_sub(classSize, std::memory_order_relaxed);
+        free(block);
+        return;
+    }
+
+    bool kept = false;
+    size_t node = 0;
+    Cache& cache = getCache(node);
+
+    if ((m_numNodes > 1) && (classSize >= NUMA_MIN_SIZE))
+    {
+        size_t memoryNode = Numa::getMemoryNode(block);
+
+        if ((memoryNode < m_numNodes) && (memoryNode != node))
+        {
+            kept = keepInDepot(block, getDepot(memoryNode, classIndex));
+
+            if (!kept)
+            {
+                m_retainedBytes.fetch_sub(classSize, std::memory_order_relaxed);
+                free(block);
+            }
+
+            return;
+        }
+    }
+
+    if (!cache.busy.exchange(true, std::memory_order_acquire))
+    {
+        uint32_t& loaded = cache.loaded[classIndex];
+        size_t depot = getDepot(node, classIndex);
+
+        // A full magazine is exchanged for an empty one of the depot.
+        if ((loaded == NO_MAGAZINE) || (getMagazine(loaded).count == MAGAZINE_SIZE))
+        {
+            uint32_t empty = pop(m_emptyMagazines[depot]);
+            empty = empty != NO_MAGAZINE ? empty : newMagazine();
+
+            if (empty != NO_MAGAZINE)
+            {
+                if (loaded != NO_MAGAZINE)
+                {
+                    push(m_fullMagazines[depot], loaded);
+                }
+
+                loaded = empty;
+            }
+        }
+
+        if ((loaded != NO_MAGAZINE) && (getMagazine(loaded).count < MAGAZINE_SIZE))
+        {
+            Magazine& magazine = getMagazine(loaded);
+            magazine.blocks[magazine.count++] = block;
+            kept = true;
+        }
+
+        cache.busy.store(false, std::memory_order_release);
+    }
+    else
+    {
+        kept = keepInDepot(block, getDepot(node, classIndex));
+    }
+
+    if (!kept)
+    {
+        m_retainedBytes.fetch_sub(classSize, std::memory_order_relaxed);
+        free(block);
+    }
+}
+
+bool BufferPool::keepInDepot(
+        char* block,
+        size_t depot)
+{
+    uint32_t index = pop(m_emptyMagazines[depot]);
+    index = index != NO_MAGAZINE ? index : newMagazine();
+
+    if (index == NO_MAGAZINE)
+    {
+        return false;
+    }
+
+    Magazine& magazine = getMagazine(index);
+    magazine.blocks[0] = block;
+    magazine.count = 1;
+    push(m_fullMagazines[depot], index);
+    return true;
+}
+
+char* BufferPool::takeFromDepot(
+        size_t depot)
+{
+    uint32_t index = pop(m_fullMagazines[depot]);
+
+    if (index == NO_MAGAZINE)
+    {
+        return nullptr;
+    }
+
+    Magazine& magazine = getMagazine(index);
+    char* block = magazine.count > 0 ? magazine.blocks[--magazine.count] : nullptr;
+    push(magazine.count > 0 ? m_fullMagazines[depot] : m_emptyMagazines[depot], index);
+    return block;
+}
+
+BufferPool::Magazine& BufferPool::getMagazine(
+        uint32_t index) const
+{
+    return m_segments[index / SEGMENT_SIZE].load(std::memory_order_acquire)[index % SEGMENT_SIZE];
+}
+
+uint32_t BufferPool::newMagazine()
+{
+    uint32_t index = m_magazineCount.fetch_add(1);
+
+    if (index >= SEGMENT_SIZE * MAX_SEGMENTS)
+    {
+        return NO_MAGAZINE;
+    }
+
+    std::atomic<Magazine*>& segment = m_segments[index / SEGMENT_SIZE];
+
+    if (segment.load(std::memory_order_acquire) == nullptr)
+    {
+        // Threads creating the first magazines of a segment race to create it. The one that loses frees its own.
+        Magazine* expected = nullptr;
+        Magazine* created = new Magazine[SEGMENT_SIZE];
+
+        if (!segment.compare_exchange_strong(expected, created, std::memory_order_acq_rel))
+        {
+            delete [] created;
+        }
+    }
+
+    return index;
+}
+
+void BufferPool::push(
+        std::atomic<uint64_t>& stack,
+        uint32_t index)
+{
+    uint64_t top = stack.load(std::memory_order_relaxed);
+
+    do
+    {
+        getMagazine(index).next.store(top_index(top), std::memory_order_relaxed);
+    }
+    while (!stack.compare_exchange_weak(top, make_top(top, index), std::memory_order_release,
+            std::memory_order_relaxed));
+}
+
+uint32_t BufferPool::pop(
+        std::atomic<uint64_t>& stack)
+{
+    uint64_t top = stack.load(std::memory_order_acquire);
+
+    while (top_index(top) != NO_MAGAZINE)
+    {
+        // The magazine may be popped by another thread meanwhile. Then the counter makes the exchange fail.
+        uint32_t next = getMagazine(top_index(top)).next.load(std::memory_order_relaxed);
+
+        if (stack.compare_exchange_weak(top, make_top(top, next), std::memory_order_acquire,
+                std::memory_order_acquire))
+        {
+            return top_index(top);
+        }
+    }
+
+    return NO_MAGAZINE;
+}
+
+BufferPool::Cache& BufferPool::getCache(
+        size_t& node)
+{
+    node = 0;
+
+    if (m_numNodes > 1)
+    {
+        node = Numa::getCurrentNode();
+        node = node < m_numNodes ? node : 0;
+    }
+
+    size_t first = node * m_cachesPerNode;
+
+#if defined(__linux__)
+    int processor = sched_getcpu();
+
+    if (processor >= 0)
+    {
+        return *m_caches[first + static_cast<size_t>(processor) % m_cachesPerNode];
+    }
+#endif // if defined(__linux__)
+
+    return *m_caches[first + std::hash<std::thread::id>()(std::this_thread::get_id()) % m_cachesPerNode];
+}
@@ -13,8 +13,15 @@
 // limitations under the License.
 
 #include <fastcdr/Cdr.h>
+#include <fastcdr/CdrSink.h>
+#include <fastcdr/GatherList.h>
+#include <fastcdr/ThreadPool.h>
+#include <fastcdr/TypeDescriptor.h>
 #include <fastcdr/exceptions/BadParamException.h>
 
+#include <cstring>
+#include <limits>
+
 using namespace eprosima::fastcdr;
 using namespace ::exception;
 
@@ -25,6 +32,79 @@ const Cdr::Endianness Cdr::DEFAULT_ENDIAN = LITTLE_ENDIANNESS;
 #endif // if FASTCDR_IS_BIG_ENDIAN_TARGET
 
 CONSTEXPR size_t ALIGNMENT_LONG_DOUBLE = 8;
+CONSTEXPR size_t MAX_ALIGNMENT = 8;
+
+//! @brief The number of ranges each thread encodes when serializing in parallel, so faster threads take more.
+CONSTEXPR size_t PARALLEL_RANGES_PER_THREAD = 4;
+
+//! @brief The minimum number of elements of a range encoded in parallel.
+CONSTEXPR size_t PARALLEL_MIN_RANGE_ELEMENTS = 64;
+
+//! @brief The number of bytes of the chunks of an array copied in parallel. They fit in the cache of a core.
+CONSTEXPR size_t PARALLEL_COPY_CHUNK = 256 * 1024;
+
+namespace {
+
+//! @brief Copies elements of a given size reversing the bytes of each one.
+template<size_t _DataSize>
+void swap_copy(
+        char* destination,
+        const char* source,
+        size_t totalSize)
+{
+    for (const char* end = source + totalSize; source < end; source += _DataSize, destination += _DataSize)
+    {
+        for (size_t byte = 0; byte < _DataSize; ++byte)
+        {
+            destination[byte] = source[_DataSize - 1 - byte];
+        }
+    }
+}
+
+//! @brief A range of elements encoded by a thread of the pool.
+struct ParallelRange
+{
+    ParallelRange()
+        : begin(0)
+        , end(0)
+        , residue(0)
+        , size(0)
+        , lastDataSize(0)
+    {
+    }
+
+    //! @brief The index of the first element.
+    size_t begin;
+
+    //! @brief The index after the last element.
+    size_t end;
+
+    //! @brief The expected position modulo 8 of the first element in the stream.
+    size_t residue;
+
+    //! @brief The buffer where the range is encoded.
+    FastBuffer buffer;
+
+    //! @brief The position of each element in the buffer.
+    std::vector<size_t> offsets;
+
+    //! @brief The number of bytes encoded.
+    size_t size;
+
+    //! @brief The last data size after encoding the range.
+    size_t lastDataSize;
+};
+
+//! @brief A part of a range copied into the stream.
+struct ParallelCopy
+{
+    size_t range;
+    size_t source;
+    size_t destination;
+    size_t length;
+};
+
+} // namespace
 
 Cdr::state::state(
         const Cdr& cdr)
@@ -32,6 +112,9 @@ Cdr::state::state(
     , m_alignPosition(cdr.m_alignPosition)
     , m_swapBytes(cdr.m_swapBytes)
     , m_lastDataSize(cdr.m_lastDataSize)
+    , m_flushedBytes(cdr.m_flushedBytes)
+    , m_allocatedBytes(cdr.m_allocatedBytes)
+    , m_externalCount(cdr.m_gatherList != nullptr ? cdr.m_gatherList->getExternalCount() : 0)
 {
 }
 
@@ -41,6 +124,16 @@ Cdr::state::state(
     , m_alignPosition(current_state.m_alignPosition)
     , m_swapBytes(current_state.m_swapBytes)
     , m_lastDataSize(current_state.m_lastDataSize)
+    , m_flushedBytes(current_state.m_flushedBytes)
+    , m_allocatedBytes(current_state.m_allocatedBytes)
+    , m_externalCount(current_state.m_externalCount)
+{
+}
+
+Cdr::DeserializationLimits::DeserializationLimits()
+    : maxSequenceElements((std::numeric_limits<size_t>::max)())
+    , maxStringBytes((std::numeric_limits<size_t>::max)())
+    , maxTotalAllocation((std::numeric_limits<size_t>::max)())
 {
 }
 
@@ -58,6 +151,12 @@ Cdr::Cdr(
     , m_currentPosition(cdrBuffer.begin())
     , m_alignPosition(cdrBuffer.begin())
     , m_lastPosition(cdrBuffer.end())
+    , m_allocatedBytes(0)
+    , m_gatherList(nullptr)
+    , m_sink(nullptr)
+    , m_flushedBytes(0)
+    , m_threadPool(nullptr)
+    , m_parallelThreshold(0)
 {
 }
 
@@ -114,7 +213,7 @@ Cdr& Cdr::read_encapsulation()
     }
     catch (Exception& ex)
     {
-        setState(state_before_error);
+        restoreState(state_before_error);
         ex.raise();
     }
 
@@ -143,7 +242,7 @@ Cdr& Cdr::serialize_encapsulation()
     }
     catch (Exception& ex)
     {
-        setState(state_before_error);
+        restoreState(state_before_error);
         ex.raise();
     }
 
@@ -156,7 +255,7 @@ Cdr& Cdr::serialize_encapsulation()
     }
     catch (Exception& ex)
     {
-        setState(state_before_error);
+        restoreState(state_before_error);
         ex.raise();
     }
 
@@ -204,6 +303,8 @@ bool Cdr::jump(
     if (((m_lastPosition - m_currentPosition) >= numBytes) || resize(numBytes))
     {
         m_currentPosition += numBytes;
+        // The position after the jump may be unaligned for the last data size.
+        m_lastDataSize = 0;
         returnedValue = true;
     }
 
@@ -228,18 +329,317 @@ Cdr::state Cdr::getState()
 void Cdr::setState(
         state& current_state)
 {
+    if (!restoreState(current_state))
+    {
+        throw BadParamException("State belongs to a window already flushed to the sink");
+    }
+}
+
+bool Cdr::restoreState(
+        state& current_state)
+{
+    if (current_state.m_flushedBytes != m_flushedBytes)
+    {
+        return false;
+    }
+
     m_currentPosition >> current_state.m_currentPosition;
     m_alignPosition >> current_state.m_alignPosition;
     m_swapBytes = current_state.m_swapBytes;
     m_lastDataSize = current_state.m_lastDataSize;
+    m_allocatedBytes = current_state.m_allocatedBytes;
+
+    // The arrays referenced after the state are no longer part of the stream.
+    if (m_gatherList != nullptr)
+    {
+        m_gatherList->truncate(current_state.m_externalCount);
+    }
+
+    return true;
 }
 
 void Cdr::reset()
 {
     m_currentPosition = m_cdrBuffer.begin();
     m_alignPosition = m_cdrBuffer.begin();
+    m_lastPosition = m_cdrBuffer.end();
     m_swapBytes = m_endianness == DEFAULT_ENDIAN ? false : true;
     m_lastDataSize = 0;
+    m_allocatedBytes = 0;
+    m_flushedBytes = 0;
+
+    if (m_gatherList != nullptr)
+    {
+        m_gatherList->clear();
+    }
+}
+
+void Cdr::setDeserializationLimits(
+        const DeserializationLimits& limits)
+{
+    m_limits = limits;
+}
+
+const Cdr::DeserializationLimits& Cdr::getDeserializationLimits() const
+{
+    return m_limits;
+}
+
+void Cdr::setGatherList(
+        GatherList* gatherList)
+{
+    m_gatherList = gatherList;
+}
+
+GatherList* Cdr::getGatherList() const
+{
+    return m_gatherList;
+}
+
+void Cdr::setSink(
+        CdrSink* sink)
+{
+    m_sink = sink;
+}
+
+CdrSink* Cdr::getSink() const
+{
+    return m_sink;
+}
+
+void Cdr::setThreadPool(
+        ThreadPool* pool,
+        size_t threshold)
+{
+    m_threadPool = pool;
+    m_parallelThreshold = threshold;
+}
+
+ThreadPool* Cdr::getThreadPool() const
+{
+    return m_threadPool;
+}
+
+bool Cdr::flush()
+{
+    if (m_sink == nullptr)
+    {
+        return false;
+    }
+
+    size_t length = getSerializedDataLength();
+
+    if (length > 0)
+    {
+        if (!m_sink->write(m_cdrBuffer.getBuffer(), length))
+        {
+            return false;
+        }
+
+        // The window starts again at the beginning of the buffer. The alignment origin is placed so that the
+        // distance to it keeps the residue modulo 8 of the whole stream, which is all alignment() depends on.
+        size_t residue = (m_currentPosition - m_alignPosition) & (MAX_ALIGNMENT - 1);
+        m_flushedBytes += length;
+        m_currentPosition = m_cdrBuffer.begin();
+        m_alignPosition = m_cdrBuffer.begin();
+        m_alignPosition += (MAX_ALIGNMENT - residue) & (MAX_ALIGNMENT - 1);
+    }
+
+    return true;
+}
+
+Cdr& Cdr::skip(
+        const TypeDescriptor& type)
+{
+    uint32_t length = 0;
+
+    switch (type.getKind())
+    {
+        case TypeDescriptor::TK_STRING:
+            deserialize(length);
+            skipBytes(sizeof(char), length);
+            break;
+        case TypeDescriptor::TK_WSTRING:
+            deserialize(length);
+            skipElements(TypeDescriptor(TypeDescriptor::TK_WCHAR), length);
+            break;
+        case TypeDescriptor::TK_SEQUENCE:
+            deserialize(length);
+            // Empty sequences are not aligned to their elements.
+            if (length > 0)
+            {
+                skipElements(type.getElement(), length);
+            }
+            break;
+        case TypeDescriptor::TK_ARRAY:
+            skipElements(type.getElement(), type.getLength());
+            break;
+        case TypeDescriptor::TK_STRUCTURE:
+            for (size_t index = 0; index < type.getMemberCount(); ++index)
+            {
+                skip(type.getMember(index));
+            }
+            break;
+        default:
+            skipBytes(type.getAlignment(), type.getSerializedSize());
+            break;
+    }
+
+    return *this;
+}
+
+void Cdr::skipElements(
+        const TypeDescriptor& type,
+        size_t numElements)
+{
+    // Empty arrays are not aligned to their elements, as when they are serialized.
+    if (numElements == 0)
+    {
+        return;
+    }
+
+    if (type.isPrimitive())
+    {
+        // Compared by division so that a corrupted length cannot overflow the byte count.
+        if (numElements > (m_lastPosition - m_currentPosition) / type.getSerializedSize())
+        {
+            throw NotEnoughMemoryException(NotEnoughMemoryException::NOT_ENOUGH_MEMORY_MESSAGE_DEFAULT);
+        }
+
+        skipBytes(type.getAlignment(), numElements * type.getSerializedSize());
+        return;
+    }
+
+    for (size_t count = 0; count < numElements; ++count)
+    {
+        skip(type);
+    }
+}
+
+void Cdr::skipBytes(
+        size_t dataSize,
+        size_t size)
+{
+    size_t align = alignment(dataSize);
+
+    if ((m_lastPosition - m_currentPosition) < align + size)
+    {
+        throw NotEnoughMemoryException(NotEnoughMemoryException::NOT_ENOUGH_MEMORY_MESSAGE_DEFAULT);
+    }
+
+    makeAlign(align);
+    m_currentPosition += size;
+    // The position is now aligned to the skipped values, as after deserializing them.
+    m_lastDataSize = dataSize;
+}
+
+size_t Cdr::getStreamChunkSize() const
+{
+    size_t windowSize = m_cdrBuffer.getBufferSize();
+    return windowSize > 2 * MAX_ALIGNMENT ? windowSize - 2 * MAX_ALIGNMENT : 0;
+}
+
+bool Cdr::gatherArray(
+        const char* data,
+        size_t totalSize,
+        size_t dataSize)
+{
+    // Arrays that need swapping are copied, as their bytes in memory are not the serialized ones.
+    if ((totalSize == 0) || (totalSize < m_gatherList->getThreshold()) || ((dataSize > 1) && m_swapBytes))
+    {
+        return false;
+    }
+
+    size_t align = alignment(dataSize);
+
+    if (((m_lastPosition - m_currentPosition) >= align) || resize(align))
+    {
+        makeAlign(align);
+        m_gatherList->addExternal(getSerializedDataLength(), data, totalSize);
+
+        // The array is not in the buffer, but the next values are aligned as if it was. The alignment origin is
+        // moved so that the distance to it keeps the residue modulo 8 of the serialized stream. Alignments are
+        // powers of two not greater than 8, so this residue is all alignment() depends on.
+        m_alignPosition += (MAX_ALIGNMENT - (totalSize % MAX_ALIGNMENT)) % MAX_ALIGNMENT;
+        m_lastDataSize = dataSize;
+        return true;
+    }
+
+    throw NotEnoughMemoryException(NotEnoughMemoryException::NOT_ENOUGH_MEMORY_MESSAGE_DEFAULT);
+}
+
+bool Cdr::writeArrayInParallel(
+        const char* data,
+        size_t totalSize,
+        size_t dataSize)
+{
+    char* position = m_cdrBuffer.getBuffer() + (m_currentPosition - m_cdrBuffer.begin());
+
+    if (copyInParallel(position, data, totalSize, dataSize))
+    {
+        m_currentPosition += totalSize;
+        return true;
+    }
+
+    return false;
+}
+
+bool Cdr::readArrayInParallel(
+        char* data,
+        size_t totalSize,
+        size_t dataSize)
+{
+    const char* position = m_cdrBuffer.getBuffer() + (m_currentPosition - m_cdrBuffer.begin());
+
+    if (copyInParallel(data, position, totalSize, dataSize))
+    {
+        m_currentPosition += totalSize;
+        return true;
+    }
+
+    return false;
+}
+
+bool Cdr::copyInParallel(
+        char* destination,
+        const char* source,
+        size_t totalSize,
+        size_t dataSize)
+{
+    if ((m_threadPool == nullptr) || (m_threadPool->size() == 0) || (totalSize < m_parallelThreshold) ||
+            (totalSize <= PARALLEL_COPY_CHUNK))
+    {
+        return false;
+    }
+
+    // Chunks are multiples of every element size, so no element is split between two threads.
+    bool swap = m_swapBytes && (dataSize > 1);
+    size_t numChunks = (totalSize + PARALLEL_COPY_CHUNK - 1) / PARALLEL_COPY_CHUNK;
+
+    m_threadPool->parallelFor(numChunks, [&](size_t index)
+            {
+                size_t offset = index * PARALLEL_COPY_CHUNK;
+                size_t size = std::min(PARALLEL_COPY_CHUNK, totalSize - offset);
+
+                if (!swap)
+                {
+                    memcpy(destination + offset, source + offset, size);
+                }
+                else if (dataSize == 2)
+                {
+                    swap_copy<2>(destination + offset, source + offset, size);
+                }
+                else if (dataSize == 4)
+                {
+                    swap_copy<4>(destination + offset, source + offset, size);
+                }
+                else
+                {
+                    swap_copy<8>(destination + offset, source + offset, size);
+                }
+            });
+
+    return true;
 }
 
 bool Cdr::moveAlignmentForward(
@@ -256,9 +656,137 @@ bool Cdr::moveAlignmentForward(
     return returnedValue;
 }
 
+Cdr& Cdr::serializeElementsInParallel(
+        size_t numElements,
+        ThreadPool& pool,
+        const std::function<void (Cdr&, size_t)>& serializeElement)
+{
+    size_t numRanges = std::min((pool.size() + 1) * PARALLEL_RANGES_PER_THREAD,
+                    numElements / PARALLEL_MIN_RANGE_ELEMENTS);
+
+    // The ranges are copied into the buffer, so a sink or a gather list keeps the sequential path.
+    if ((pool.size() == 0) || (numRanges < 2) || (m_sink != nullptr) || (m_gatherList != nullptr))
+    {
+        for (size_t count = 0; count < numElements; ++count)
+        {
+            serializeElement(*this, count);
+        }
+
+        return *this;
+    }
+
+    // Alignments are powers of two not greater than 8, so the position modulo 8 of an element in the stream is all
+    // its encoding depends on. The size of the first element predicts the position of each range.
+    size_t residue = (m_currentPosition - m_alignPosition) & (MAX_ALIGNMENT - 1);
+    size_t elementSize = 0;
+
+    {
+        FastBuffer scratch;
+        Cdr cdr(scratch, static_cast<Endianness>(m_endianness), m_cdrType);
+        cdr.m_swapBytes = m_swapBytes;
+        cdr.m_alignPosition += (MAX_ALIGNMENT - residue) & (MAX_ALIGNMENT - 1);
+        serializeElement(cdr, 0);
+        elementSize = cdr.getSerializedDataLength();
+    }
+
+    std::vector<ParallelRange> ranges(numRanges);
+
+    for (size_t index = 0; index < numRanges; ++index)
+    {
+        ranges[index].begin = index * numElements / numRanges;
+        ranges[index].end = (index + 1) * numElements / numRanges;
+        ranges[index].residue = (residue + ranges[index].begin * elementSize) & (MAX_ALIGNMENT - 1);
+    }
+
+    pool.parallelFor(numRanges, [&](size_t index)
+            {
+                ParallelRange& range = ranges[index];
+                size_t count = range.end - range.begin;
+
+                // The padding is zeroed, so the output does not depend on the threads.
+                size_t estimatedSize = count * (elementSize + elementSize / 2 + MAX_ALIGNMENT);
+                range.buffer.reserve(estimatedSize);
+                memset(range.buffer.getBuffer(), 0, range.buffer.getBufferSize());
+
+                Cdr cdr(range.buffer, static_cast<Endianness>(m_endianness), m_cdrType);
+                cdr.m_swapBytes = m_swapBytes;
+                cdr.m_alignPosition += (MAX_ALIGNMENT - range.residue) & (MAX_ALIGNMENT - 1);
+                range.offsets.reserve(count);
+
+                for (size_t element = range.begin; element < range.end; ++element)
+                {
+                    range.offsets.push_back(cdr.getSerializedDataLength());
+                    serializeElement(cdr, element);
+                }
+
+                range.size = cdr.getSerializedDataLength();
+                range.lastDataSize = cdr.m_lastDataSize;
+            });
+
+    state state_before_error(*this);
+
+    try
+    {
+        std::vector<ParallelCopy> copies;
+        copies.reserve(numRanges);
+
+        for (size_t index = 0; index < numRanges; ++index)
+        {
+            ParallelRange& range = ranges[index];
+
+            // Elements are encoded again until the stream reaches the alignment of one of them in the range. From
+            // there, the range holds the same bytes the stream would.
+            for (size_t element = 0; element < range.offsets.size(); ++element)
+            {
+                size_t offset = range.offsets[element];
+
+                if (((m_currentPosition - m_alignPosition) & (MAX_ALIGNMENT - 1)) ==
+                        ((range.residue + offset) & (MAX_ALIGNMENT - 1)))
+                {
+                    size_t length = range.size - offset;
+
+                    if (((m_lastPosition - m_currentPosition) < length) && !resize(length))
+                    {
+                        throw NotEnoughMemoryException(NotEnoughMemoryException::NOT_ENOUGH_MEMORY_MESSAGE_DEFAULT);
+                    }
+
+                    ParallelCopy copy = {index, offset, getSerializedDataLength(), length};
+                    copies.push_back(copy);
+                    m_currentPosition += length;
+                    m_lastDataSize = range.lastDataSize;
+                    break;
+                }
+
+                serializeElement(*this, range.begin + element);
+            }
+        }
+
+        char* destination = m_cdrBuffer.getBuffer();
+        pool.parallelFor(copies.size(), [&](size_t index)
+                {
+                    const ParallelCopy& copy = copies[index];
+                    memcpy(destination + copy.destination, ranges[copy.range].buffer.getBuffer() + copy.source,
+                    copy.length);
+                });
+    }
+    catch (Exception& ex)
+    {
+        restoreState(state_before_error);
+        ex.raise();
+    }
+
+    return *this;
+}
+
 bool Cdr::resize(
         size_t minSizeInc)
 {
+    // In streaming mode the window does not grow. The bytes already serialized are flushed to make room.
+    if (m_sink != nullptr)
+    {
+        return flush() && ((m_lastPosition - m_currentPosition) >= minSizeInc);
+    }
+
     if (m_cdrBuffer.resize(minSizeInc))
     {
         m_currentPosition << m_cdrBuffer.begin();
@@ -718,7 +1246,12 @@ Cdr& Cdr::serialize(
         Cdr::state state_before_error(*this);
         serialize(length);
 
-        if (((m_lastPosition - m_currentPosition) >= length) || resize(length))
+        if (m_sink != nullptr)
+        {
+            // Strings longer than the window are written in pieces.
+            serializeArray(string_t, length);
+        }
+        else if (((m_lastPosition - m_currentPosition) >= length) || resize(length))
         {
             // Save last datasize.
             m_lastDataSize = sizeof(uint8_t);
@@ -728,7 +1261,7 @@ Cdr& Cdr::serialize(
         }
         else
         {
-            setState(state_before_error);
+            restoreState(state_before_error);
             throw NotEnoughMemoryException(NotEnoughMemoryException::NOT_ENOUGH_MEMORY_MESSAGE_DEFAULT);
         }
     }
@@ -757,7 +1290,12 @@ Cdr& Cdr::serialize(
         Cdr::state state_(*this);
         serialize(size_to_uint32(wstrlen));
 
-        if (((m_lastPosition - m_currentPosition) >= bytesLength) || resize(bytesLength))
+        if (m_sink != nullptr)
+        {
+            // Wide-strings longer than the window are written in pieces.
+            serializeArray(string_t, wstrlen);
+        }
+        else if (((m_lastPosition - m_currentPosition) >= bytesLength) || resize(bytesLength))
         {
             // Save last datasize.
             m_lastDataSize = sizeof(uint32_t);
@@ -787,7 +1325,7 @@ Cdr& Cdr::serialize(
         }
         else
         {
-            setState(state_);
+            restoreState(state_);
             throw NotEnoughMemoryException(NotEnoughMemoryException::NOT_ENOUGH_MEMORY_MESSAGE_DEFAULT);
         }
     }
@@ -845,6 +1383,11 @@ Cdr& Cdr::serializeArray(
         const bool* bool_t,
         size_t numElements)
 {
+    if (serializeArrayInChunks(bool_t, numElements, sizeof(*bool_t)))
+    {
+        return *this;
+    }
+
     size_t totalSize = sizeof(*bool_t) * numElements;
 
     if (((m_lastPosition - m_currentPosition) >= totalSize) || resize(totalSize))
@@ -875,11 +1418,22 @@ Cdr& Cdr::serializeArray(
 {
     size_t totalSize = sizeof(*char_t) * numElements;
 
+    if (((m_gatherList != nullptr) && gatherArray(char_t, totalSize, sizeof(*char_t))) ||
+            serializeArrayInChunks(char_t, numElements, sizeof(*char_t)))
+    {
+        return *this;
+    }
+
     if (((m_lastPosition - m_currentPosition) >= totalSize) || resize(totalSize))
     {
         // Save last datasize.
         m_lastDataSize = sizeof(*char_t);
 
+        if (writeArrayInParallel(char_t, totalSize, sizeof(*char_t)))
+        {
+            return *this;
+        }
+
         m_currentPosition.memcopy(char_t, totalSize);
         m_currentPosition += totalSize;
         return *this;
@@ -897,6 +1451,13 @@ Cdr& Cdr::serializeArray(
         return *this;
     }
 
+    if (((m_gatherList != nullptr) &&
+            gatherArray(reinterpret_cast<const char*>(short_t), sizeof(*short_t) * numElements, sizeof(*short_t))) ||
+            serializeArrayInChunks(short_t, numElements, sizeof(*short_t)))
+    {
+        return *this;
+    }
+
     size_t align = alignment(sizeof(*short_t));
     size_t totalSize = sizeof(*short_t) * numElements;
     size_t sizeAligned = totalSize + align;
@@ -912,6 +1473,11 @@ Cdr& Cdr::serializeArray(
             makeAlign(align);
         }
 
+        if (writeArrayInParallel(reinterpret_cast<const char*>(short_t), totalSize, sizeof(*short_t)))
+        {
+            return *this;
+        }
+
         if (m_swapBytes)
         {
             const char* dst = reinterpret_cast<const char*>(short_t);
@@ -966,6 +1532,13 @@ Cdr& Cdr::serializeArray(
         return *this;
     }
 
+    if (((m_gatherList != nullptr) &&
+            gatherArray(reinterpret_cast<const char*>(long_t), sizeof(*long_t) * numElements, sizeof(*long_t))) ||
+            serializeArrayInChunks(long_t, numElements, sizeof(*long_t)))
+    {
+        return *this;
+    }
+
     size_t align = alignment(sizeof(*long_t));
     size_t totalSize = sizeof(*long_t) * numElements;
     size_t sizeAligned = totalSize + align;
@@ -981,6 +1554,11 @@ Cdr& Cdr::serializeArray(
             makeAlign(align);
         }
 
+        if (writeArrayInParallel(reinterpret_cast<const char*>(long_t), totalSize, sizeof(*long_t)))
+        {
+            return *this;
+        }
+
         if (m_swapBytes)
         {
             const char* dst = reinterpret_cast<const char*>(long_t);
@@ -1075,6 +1653,13 @@ Cdr& Cdr::serializeArray(
         return *this;
     }
 
+    if (((m_gatherList != nullptr) &&
+            gatherArray(reinterpret_cast<const char*>(longlong_t), sizeof(*longlong_t) * numElements, sizeof(*longlong_t))) ||
+            serializeArrayInChunks(longlong_t, numElements, sizeof(*longlong_t)))
+    {
+        return *this;
+    }
+
     size_t align = alignment(sizeof(*longlong_t));
     size_t totalSize = sizeof(*longlong_t) * numElements;
     size_t sizeAligned = totalSize + align;
@@ -1090,6 +1675,11 @@ Cdr& Cdr::serializeArray(
             makeAlign(align);
         }
 
+        if (writeArrayInParallel(reinterpret_cast<const char*>(longlong_t), totalSize, sizeof(*longlong_t)))
+        {
+            return *this;
+        }
+
         if (m_swapBytes)
         {
             const char* dst = reinterpret_cast<const char*>(longlong_t);
@@ -1150,6 +1740,13 @@ Cdr& Cdr::serializeArray(
         return *this;
     }
 
+    if (((m_gatherList != nullptr) &&
+            gatherArray(reinterpret_cast<const char*>(float_t), sizeof(*float_t) * numElements, sizeof(*float_t))) ||
+            serializeArrayInChunks(float_t, numElements, sizeof(*float_t)))
+    {
+        return *this;
+    }
+
     size_t align = alignment(sizeof(*float_t));
     size_t totalSize = sizeof(*float_t) * numElements;
     size_t sizeAligned = totalSize + align;
@@ -1165,6 +1762,11 @@ Cdr& Cdr::serializeArray(
             makeAlign(align);
         }
 
+        if (writeArrayInParallel(reinterpret_cast<const char*>(float_t), totalSize, sizeof(*float_t)))
+        {
+            return *this;
+        }
+
         if (m_swapBytes)
         {
             const char* dst = reinterpret_cast<const char*>(float_t);
@@ -1221,6 +1823,13 @@ Cdr& Cdr::serializeArray(
         return *this;
     }
 
+    if (((m_gatherList != nullptr) &&
+            gatherArray(reinterpret_cast<const char*>(double_t), sizeof(*double_t) * numElements, sizeof(*double_t))) ||
+            serializeArrayInChunks(double_t, numElements, sizeof(*double_t)))
+    {
+        return *this;
+    }
+
     size_t align = alignment(sizeof(*double_t));
     size_t totalSize = sizeof(*double_t) * numElements;
     size_t sizeAligned = totalSize + align;
@@ -1236,6 +1845,11 @@ Cdr& Cdr::serializeArray(
             makeAlign(align);
         }
 
+        if (writeArrayInParallel(reinterpret_cast<const char*>(double_t), totalSize, sizeof(*double_t)))
+        {
+            return *this;
+        }
+
         if (m_swapBytes)
         {
             const char* dst = reinterpret_cast<const char*>(double_t);
@@ -1296,6 +1910,11 @@ Cdr& Cdr::serializeArray(
         return *this;
     }
 
+    if (serializeArrayInChunks(ldouble_t, numElements, 16))
+    {
+        return *this;
+    }
+
     size_t align = alignment(ALIGNMENT_LONG_DOUBLE);
     // Fix for Windows ( long doubles only store 8 bytes )
     size_t totalSize = 16 * numElements; // sizeof(*ldouble_t)
@@ -1872,6 +2491,7 @@ Cdr& Cdr::deserialize(
     Cdr::state state_before_error(*this);
 
     deserialize(length);
+    checkLength(length, m_limits.maxStringBytes, sizeof(char), sizeof(char), state_before_error);
 
     if (length == 0)
     {
@@ -1892,10 +2512,38 @@ Cdr& Cdr::deserialize(
         return *this;
     }
 
-    setState(state_before_error);
+    restoreState(state_before_error);
     throw NotEnoughMemoryException(NotEnoughMemoryException::NOT_ENOUGH_MEMORY_MESSAGE_DEFAULT);
 }
 
+Cdr& Cdr::deserialize(
+        char*& string_t,
+        Arena& arena)
+{
+    uint32_t length = 0;
+    Cdr::state state_before_error(*this);
+
+    deserialize(length);
+    checkLength(length, m_limits.maxStringBytes, sizeof(char), sizeof(char), state_before_error);
+
+    if (length == 0)
+    {
+        string_t = NULL;
+        return *this;
+    }
+
+    // Save last datasize.
+    m_lastDataSize = sizeof(uint8_t);
+
+    // Allocate memory.
+    size_t size = length + ((&m_currentPosition)[length - 1] == '\0' ? 0 : 1);
+    string_t = static_cast<char*>(arena.allocate(size, alignof(char)));
+    memcpy(string_t, &m_currentPosition, length);
+    string_t[size - 1] = '\0';
+    m_currentPosition += length;
+    return *this;
+}
+
 Cdr& Cdr::deserialize(
         wchar_t*& string_t)
 {
@@ -1903,13 +2551,15 @@ Cdr& Cdr::deserialize(
     Cdr::state state_before_error(*this);
 
     deserialize(length);
+    // Wide characters always take 4 bytes in the buffer.
+    checkLength(length, m_limits.maxStringBytes / 4, 4, sizeof(wchar_t), state_before_error);
 
     if (length == 0)
     {
         string_t = NULL;
         return *this;
     }
-    else if ((m_lastPosition - m_currentPosition) >= length)
+    else if ((m_lastPosition - m_currentPosition) >= length * sizeof(uint32_t))
     {
         // Save last datasize.
         m_lastDataSize = 4;
@@ -1931,7 +2581,7 @@ Cdr& Cdr::deserialize(
         return *this;
     }
 
-    setState(state_before_error);
+    restoreState(state_before_error);
     throw NotEnoughMemoryException(NotEnoughMemoryException::NOT_ENOUGH_MEMORY_MESSAGE_DEFAULT);
 }
 
@@ -1977,6 +2627,36 @@ Cdr& Cdr::deserialize(
     return *this;
 }
 
+void Cdr::checkLength(
+        uint32_t length,
+        size_t maxLength,
+        size_t minElementSize,
+        size_t elementAllocationSize,
+        state& state_before_error)
+{
+    if (length > maxLength)
+    {
+        restoreState(state_before_error);
+        throw BadParamException("Length read in Cdr exceeds the configured deserialization limit");
+    }
+
+    // Compared by division so that a corrupted length cannot overflow the byte count.
+    if (length > (m_lastPosition - m_currentPosition) / minElementSize)
+    {
+        restoreState(state_before_error);
+        throw NotEnoughMemoryException(NotEnoughMemoryException::NOT_ENOUGH_MEMORY_MESSAGE_DEFAULT);
+    }
+
+    if ((m_allocatedBytes > m_limits.maxTotalAllocation) ||
+            (length > (m_limits.maxTotalAllocation - m_allocatedBytes) / elementAllocationSize))
+    {
+        restoreState(state_before_error);
+        throw BadParamException("Memory allocated by Cdr exceeds the configured deserialization limit");
+    }
+
+    m_allocatedBytes += length * elementAllocationSize;
+}
+
 const char* Cdr::readString(
         uint32_t& length)
 {
@@ -1984,6 +2664,7 @@ const char* Cdr::readString(
     state state_before_error(*this);
 
     *this >> length;
+    checkLength(length, m_limits.maxStringBytes, sizeof(char), sizeof(char), state_before_error);
 
     if (length == 0)
     {
@@ -2003,7 +2684,7 @@ const char* Cdr::readString(
         return returnedValue;
     }
 
-    setState(state_before_error);
+    restoreState(state_before_error);
     throw eprosima::fastcdr::exception::NotEnoughMemoryException(
               eprosima::fastcdr::exception::NotEnoughMemoryException::NOT_ENOUGH_MEMORY_MESSAGE_DEFAULT);
 }
@@ -2015,6 +2696,8 @@ const std::wstring Cdr::readWString(
     state state_(*this);
 
     *this >> length;
+    // Wide characters always take 4 bytes in the buffer.
+    checkLength(length, m_limits.maxStringBytes / 4, 4, sizeof(wchar_t), state_);
     uint32_t bytesLength = length * 4;
 
     if (bytesLength == 0)
@@ -2036,7 +2719,7 @@ const std::wstring Cdr::readWString(
         return returnedValue;
     }
 
-    setState(state_);
+    restoreState(state_);
     throw eprosima::fastcdr::exception::NotEnoughMemoryException(
               eprosima::fastcdr::exception::NotEnoughMemoryException::NOT_ENOUGH_MEMORY_MESSAGE_DEFAULT);
 }
@@ -2084,6 +2767,11 @@ Cdr& Cdr::deserializeArray(
         // Save last datasize.
         m_lastDataSize = sizeof(*char_t);
 
+        if (readArrayInParallel(char_t, totalSize, sizeof(*char_t)))
+        {
+            return *this;
+        }
+
         m_currentPosition.rmemcopy(char_t, totalSize);
         m_currentPosition += totalSize;
         return *this;
@@ -2116,6 +2804,11 @@ Cdr& Cdr::deserializeArray(
             makeAlign(align);
         }
 
+        if (readArrayInParallel(reinterpret_cast<char*>(short_t), totalSize, sizeof(*short_t)))
+        {
+            return *this;
+        }
+
         if (m_swapBytes)
         {
             char* dst = reinterpret_cast<char*>(short_t);
@@ -2185,6 +2878,11 @@ Cdr& Cdr::deserializeArray(
             makeAlign(align);
         }
 
+        if (readArrayInParallel(reinterpret_cast<char*>(long_t), totalSize, sizeof(*long_t)))
+        {
+            return *this;
+        }
+
         if (m_swapBytes)
         {
             char* dst = reinterpret_cast<char*>(long_t);
@@ -2296,6 +2994,11 @@ Cdr& Cdr::deserializeArray(
             makeAlign(align);
         }
 
+        if (readArrayInParallel(reinterpret_cast<char*>(longlong_t), totalSize, sizeof(*longlong_t)))
+        {
+            return *this;
+        }
+
         if (m_swapBytes)
         {
             char* dst = reinterpret_cast<char*>(longlong_t);
@@ -2371,6 +3074,11 @@ Cdr& Cdr::deserializeArray(
             makeAlign(align);
         }
 
+        if (readArrayInParallel(reinterpret_cast<char*>(float_t), totalSize, sizeof(*float_t)))
+        {
+            return *this;
+        }
+
         if (m_swapBytes)
         {
             char* dst = reinterpret_cast<char*>(float_t);
@@ -2442,6 +3150,11 @@ Cdr& Cdr::deserializeArray(
             makeAlign(align);
         }
 
+        if (readArrayInParallel(reinterpret_cast<char*>(double_t), totalSize, sizeof(*double_t)))
+        {
+            return *this;
+        }
+
         if (m_swapBytes)
         {
             char* dst = reinterpret_cast<char*>(double_t);
@@ -2639,7 +3352,15 @@ Cdr& Cdr::serializeBoolSequence(
 
     size_t totalSize = vector_t.size() * sizeof(bool);
 
-    if (((m_lastPosition - m_currentPosition) >= totalSize) || resize(totalSize))
+    if (m_sink != nullptr)
+    {
+        // Sequences longer than the window are written as they fit.
+        for (size_t count = 0; count < vector_t.size(); ++count)
+        {
+            serialize(vector_t[count]);
+        }
+    }
+    else if (((m_lastPosition - m_currentPosition) >= totalSize) || resize(totalSize))
     {
         // Save last datasize.
         m_lastDataSize = sizeof(bool);
@@ -2658,7 +3379,7 @@ Cdr& Cdr::serializeBoolSequence(
     }
     else
     {
-        setState(state_before_error);
+        restoreState(state_before_error);
         throw NotEnoughMemoryException(NotEnoughMemoryException::NOT_ENOUGH_MEMORY_MESSAGE_DEFAULT);
     }
 
@@ -2672,6 +3393,7 @@ Cdr& Cdr::deserializeBoolSequence(
     state state_before_error(*this);
 
     *this >> seqLength;
+    checkSequenceLength<bool>(seqLength, state_before_error);
 
     size_t totalSize = seqLength * sizeof(bool);
 
@@ -2702,7 +3424,7 @@ Cdr& Cdr::deserializeBoolSequence(
     }
     else
     {
-        setState(state_before_error);
+        restoreState(state_before_error);
         throw NotEnoughMemoryException(NotEnoughMemoryException::NOT_ENOUGH_MEMORY_MESSAGE_DEFAULT);
     }
 
@@ -2717,6 +3439,8 @@ Cdr& Cdr::deserializeStringSequence(
     state state_before_error(*this);
 
     deserialize(seqLength);
+    // Each string takes at least its length in the buffer.
+    checkLength(seqLength, m_limits.maxSequenceElements, sizeof(uint32_t), sizeof(std::string), state_before_error);
 
     try
     {
@@ -2727,7 +3451,7 @@ Cdr& Cdr::deserializeStringSequence(
     {
         delete [] sequence_t;
         sequence_t = NULL;
-        setState(state_before_error);
+        restoreState(state_before_error);
         ex.raise();
     }
 
@@ -2743,6 +3467,9 @@ Cdr& Cdr::deserializeWStringSequence(
     state state_before_error(*this);
 
     deserialize(seqLength);
+    // Each wide-string takes at least its length in the buffer.
+    checkLength(seqLength, m_limits.maxSequenceElements, sizeof(uint32_t), sizeof(std::wstring),
+            state_before_error);
 
     try
     {
@@ -2753,7 +3480,39 @@ Cdr& Cdr::deserializeWStringSequence(
     {
         delete [] sequence_t;
         sequence_t = NULL;
-        setState(state_before_error);
+        restoreState(state_before_error);
+        ex.raise();
+    }
+
+    numElements = seqLength;
+    return *this;
+}
+
+Cdr& Cdr::deserializeStringSequence(
+        char**& sequence_t,
+        size_t& numElements,
+        Arena& arena)
+{
+    uint32_t seqLength = 0;
+    state state_before_error(*this);
+
+    deserialize(seqLength);
+    // Each string takes at least its length in the buffer.
+    checkLength(seqLength, m_limits.maxSequenceElements, sizeof(uint32_t), sizeof(char*), state_before_error);
+
+    try
+    {
+        sequence_t = static_cast<char**>(arena.allocate(seqLength * sizeof(char*), alignof(char*)));
+
+        for (uint32_t count = 0; count < seqLength; ++count)
+        {
+            deserialize(sequence_t[count], arena);
+        }
+    }
+    catch (eprosima::fastcdr::exception::Exception& ex)
+    {
+        sequence_t = NULL;
+        restoreState(state_before_error);
         ex.raise();
     }
 
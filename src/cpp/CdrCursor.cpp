@@ -0,0 +1,54 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastcdr/CdrCursor.h>
+
+using namespace eprosima::fastcdr;
+
+// The buffer of a cursor never owns the bytes, so it never reallocates them, and the cursor only deserializes.
+// That is why the bytes can be taken as mutable.
+
+CdrCursor::CdrCursor(
+        const char* data,
+        size_t size,
+        const Cdr::Endianness endianness,
+        const Cdr::CdrType cdrType)
+    : m_buffer(const_cast<char*>(data), size)
+    , m_cdr(m_buffer, endianness, cdrType)
+{
+}
+
+CdrCursor::CdrCursor(
+        const FastBuffer& cdrBuffer,
+        const Cdr::Endianness endianness,
+        const Cdr::CdrType cdrType)
+    : m_buffer(cdrBuffer.getBuffer(), cdrBuffer.getBufferSize())
+    , m_cdr(m_buffer, endianness, cdrType)
+{
+}
+
+CdrCursor::CdrCursor(
+        const CdrCursor& other)
+    : m_buffer(other.m_buffer.getBuffer(), other.m_buffer.getBufferSize())
+    , m_cdr(m_buffer, other.m_cdr.endianness(), other.m_cdr.m_cdrType)
+{
+    m_cdr.m_plFlag = other.m_cdr.m_plFlag;
+    m_cdr.m_options = other.m_cdr.m_options;
+    m_cdr.m_swapBytes = other.m_cdr.m_swapBytes;
+    m_cdr.m_lastDataSize = other.m_cdr.m_lastDataSize;
+    m_cdr.m_currentPosition = other.m_cdr.m_currentPosition;
+    m_cdr.m_alignPosition = other.m_cdr.m_alignPosition;
+    m_cdr.m_limits = other.m_cdr.m_limits;
+    m_cdr.m_allocatedBytes = other.m_cdr.m_allocatedBytes;
+}
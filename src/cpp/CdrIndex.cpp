@@ -0,0 +1,123 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastcdr/CdrIndex.h>
+
+using namespace eprosima::fastcdr;
+using namespace ::exception;
+
+CdrIndex::CdrIndex()
+    : m_alignOrigin(0)
+{
+}
+
+void CdrIndex::build(
+        Cdr& cdr,
+        const TypeDescriptor& type)
+{
+    size_t numElements = 0;
+    const TypeDescriptor* element = nullptr;
+
+    switch (type.getKind())
+    {
+        case TypeDescriptor::TK_SEQUENCE:
+        {
+            uint32_t length = 0;
+            cdr.deserialize(length);
+
+            // Every element takes at least one byte, so a corrupted length is rejected before the offsets are reserved.
+            if (length > cdr.m_limits.maxSequenceElements)
+            {
+                throw BadParamException("Length read in Cdr exceeds the configured deserialization limit");
+            }
+
+            if (length > cdr.m_lastPosition - cdr.m_currentPosition)
+            {
+                throw NotEnoughMemoryException(NotEnoughMemoryException::NOT_ENOUGH_MEMORY_MESSAGE_DEFAULT);
+            }
+
+            numElements = length;
+            element = &type.getElement();
+            break;
+        }
+        case TypeDescriptor::TK_ARRAY:
+            numElements = type.getLength();
+            element = &type.getElement();
+            break;
+        case TypeDescriptor::TK_STRUCTURE:
+            numElements = type.getMemberCount();
+            break;
+        default:
+            throw BadParamException("CdrIndex needs the TypeDescriptor of a sequence, an array or a structure");
+    }
+
+    m_offsets.clear();
+    m_alignOrigin = cdr.m_alignPosition - cdr.m_cdrBuffer.begin();
+
+    // Empty sequences are not aligned to their elements.
+    if ((element != nullptr) && element->isPrimitive() && (numElements > 0))
+    {
+        // Elements of a primitive type follow each other after the alignment of the first one.
+        if (numElements > (cdr.m_lastPosition - cdr.m_currentPosition) / element->getSerializedSize())
+        {
+            throw NotEnoughMemoryException(NotEnoughMemoryException::NOT_ENOUGH_MEMORY_MESSAGE_DEFAULT);
+        }
+
+        cdr.skipBytes(element->getAlignment(), 0);
+        size_t first = cdr.getSerializedDataLength();
+        cdr.skipBytes(element->getAlignment(), numElements * element->getSerializedSize());
+        m_offsets.resize(numElements);
+
+        for (size_t count = 0; count < numElements; ++count)
+        {
+            m_offsets[count] = first + count * element->getSerializedSize();
+        }
+
+        return;
+    }
+
+    m_offsets.reserve(numElements);
+
+    for (size_t count = 0; count < numElements; ++count)
+    {
+        m_offsets.push_back(cdr.getSerializedDataLength());
+        cdr.skip(element != nullptr ? *element : type.getMember(count));
+    }
+}
+
+size_t CdrIndex::getOffset(
+        size_t index) const
+{
+    if (index >= m_offsets.size())
+    {
+        throw BadParamException("CdrIndex index out of range");
+    }
+
+    return m_offsets[index];
+}
+
+Cdr& CdrIndex::seek(
+        Cdr& cdr,
+        size_t index) const
+{
+    size_t offset = getOffset(index);
+
+    cdr.m_currentPosition = cdr.m_cdrBuffer.begin();
+    cdr.m_currentPosition += offset;
+    cdr.m_alignPosition = cdr.m_cdrBuffer.begin();
+    cdr.m_alignPosition += m_alignOrigin;
+    // The alignment of the value at the new position is not known, so the next value is always aligned.
+    cdr.m_lastDataSize = 0;
+    return cdr;
+}
@@ -0,0 +1,307 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastcdr/CdrPipeline.h>
+
+using namespace eprosima::fastcdr;
+
+namespace {
+
+//! @brief The table of the CRC-32 of each byte, with the reflected polynomial 0xEDB88320.
+struct Crc32Table
+{
+    Crc32Table()
+    {
+        for (uint32_t index = 0; index < 256; ++index)
+        {
+            uint32_t crc = index;
+
+            for (int bit = 0; bit < 8; ++bit)
+            {
+                crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320 : crc >> 1;
+            }
+
+            values[index] = crc;
+        }
+    }
+
+    uint32_t values[256];
+};
+
+const Crc32Table crc32_table;
+
+} // namespace
+
+Crc32Stage::Crc32Stage(
+        bool appendChecksum)
+    : m_appendChecksum(appendChecksum)
+    , m_running(0)
+    , m_checksum(0)
+{
+}
+
+void Crc32Stage::process(
+        std::vector<char>& chunk)
+{
+    m_running = compute(chunk.data(), chunk.size(), m_running);
+}
+
+void Crc32Stage::finish(
+        std::vector<char>& chunk)
+{
+    m_checksum = m_running;
+    m_running = 0;
+
+    if (m_appendChecksum)
+    {
+        chunk.push_back(static_cast<char>(m_checksum >> 24));
+        chunk.push_back(static_cast<char>(m_checksum >> 16));
+        chunk.push_back(static_cast<char>(m_checksum >> 8));
+        chunk.push_back(static_cast<char>(m_checksum));
+    }
+}
+
+uint32_t Crc32Stage::compute(
+        const char* data,
+        size_t size,
+        uint32_t crc)
+{
+    crc = ~crc;
+
+    for (size_t index = 0; index < size; ++index)
+    {
+        crc = crc32_table.values[(crc ^ static_cast<uint8_t>(data[index])) & 0xFF] ^ (crc >> 8);
+    }
+
+    return ~crc;
+}
+
+CdrPipeline::CdrPipeline(
+        const std::vector<PipelineStage*>& stages,
+        CdrSink& output,
+        size_t maxChunks)
+    : m_stages(stages)
+    , m_output(output)
+    , m_done(false)
+    , m_failed(false)
+    , m_stop(false)
+{
+    // With two chunks at least, the serialization fills one while the stages process the other.
+    maxChunks = maxChunks > 1 ? maxChunks : 2;
+
+    for (size_t count = 0; count < maxChunks; ++count)
+    {
+        m_chunks.emplace_back(new Chunk());
+        m_chunks.back()->last = false;
+        m_free.chunks.push_back(m_chunks.back().get());
+    }
+
+    for (size_t count = 0; count <= m_stages.size(); ++count)
+    {
+        m_queues.emplace_back(new Queue());
+    }
+
+    for (size_t index = 0; index < m_stages.size(); ++index)
+    {
+        m_threads.emplace_back(&CdrPipeline::runStage, this, index);
+    }
+
+    m_threads.emplace_back(&CdrPipeline::runOutput, this);
+}
+
+CdrPipeline::~CdrPipeline()
+{
+    m_stop = true;
+
+    for (std::unique_ptr<Queue>& queue : m_queues)
+    {
+        // The lock orders the flag before any waiting thread checks it again.
+        {
+            std::lock_guard<std::mutex> lock(queue->mutex);
+        }
+
+        queue->ready.notify_all();
+    }
+
+    for (std::thread& thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+bool CdrPipeline::write(
+        const char* data,
+        size_t size)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_failed)
+        {
+            return false;
+        }
+    }
+
+    Chunk* chunk = pop(m_free);
+    chunk->data.assign(data, data + size);
+    chunk->last = false;
+    push(*m_queues.front(), chunk);
+    return true;
+}
+
+bool CdrPipeline::finish()
+{
+    Chunk* chunk = pop(m_free);
+    chunk->data.clear();
+    chunk->last = true;
+    push(*m_queues.front(), chunk);
+
+    bool failed = false;
+    std::exception_ptr exception;
+
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_finished.wait(lock, [this]()
+                {
+                    return m_done;
+                });
+
+        failed = m_failed;
+        exception = m_exception;
+        m_done = false;
+        m_failed = false;
+        m_exception = nullptr;
+    }
+
+    if (exception)
+    {
+        std::rethrow_exception(exception);
+    }
+
+    return !failed;
+}
+
+void CdrPipeline::push(
+        Queue& queue,
+        Chunk* chunk)
+{
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.chunks.push_back(chunk);
+    }
+
+    queue.ready.notify_one();
+}
+
+CdrPipeline::Chunk* CdrPipeline::pop(
+        Queue& queue)
+{
+    std::unique_lock<std::mutex> lock(queue.mutex);
+    queue.ready.wait(lock, [&]()
+            {
+                return !queue.chunks.empty() || m_stop;
+            });
+
+    if (m_stop)
+    {
+        return nullptr;
+    }
+
+    Chunk* chunk = queue.chunks.front();
+    queue.chunks.pop_front();
+    return chunk;
+}
+
+void CdrPipeline::runStage(
+        size_t index)
+{
+    PipelineStage& stage = *m_stages[index];
+    Queue& input = *m_queues[index];
+    Queue& next = *m_queues[index + 1];
+
+    while (Chunk* chunk = pop(input))
+    {
+        bool failed = false;
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            failed = m_failed;
+        }
+
+        // After a failure the chunks still flow to the end, so the stream can be finished, but are not processed.
+        // The stages still finish the stream, to be ready for the next one.
+        try
+        {
+            if (!failed && !chunk->data.empty())
+            {
+                stage.process(chunk->data);
+            }
+
+            if (chunk->last)
+            {
+                stage.finish(chunk->data);
+            }
+        }
+        catch (...)
+        {
+            fail(std::current_exception());
+        }
+
+        push(next, chunk);
+    }
+}
+
+void CdrPipeline::runOutput()
+{
+    Queue& input = *m_queues.back();
+
+    while (Chunk* chunk = pop(input))
+    {
+        bool failed = false;
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            failed = m_failed;
+        }
+
+        if (!failed && !chunk->data.empty() && !m_output.write(chunk->data.data(), chunk->data.size()))
+        {
+            fail(nullptr);
+        }
+
+        if (chunk->last)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_done = true;
+            }
+
+            m_finished.notify_all();
+        }
+
+        push(m_free, chunk);
+    }
+}
+
+void CdrPipeline::fail(
+        std::exception_ptr exception)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!m_failed)
+    {
+        m_failed = true;
+        m_exception = exception;
+    }
+}
@@ -0,0 +1,71 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastcdr/CdrSink.h>
+
+#include <utility>
+
+#if !defined(_WIN32)
+#include <errno.h>
+#include <unistd.h>
+#endif // if !defined(_WIN32)
+
+using namespace eprosima::fastcdr;
+
+CallbackSink::CallbackSink(
+        Callback callback)
+    : m_callback(std::move(callback))
+{
+}
+
+bool CallbackSink::write(
+        const char* data,
+        size_t size)
+{
+    return m_callback(data, size);
+}
+
+#if !defined(_WIN32)
+FileDescriptorSink::FileDescriptorSink(
+        int fd)
+    : m_fd(fd)
+{
+}
+
+bool FileDescriptorSink::write(
+        const char* data,
+        size_t size)
+{
+    while (size > 0)
+    {
+        ssize_t written = ::write(m_fd, data, size);
+
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            return false;
+        }
+
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+
+    return true;
+}
+
+#endif // if !defined(_WIN32)
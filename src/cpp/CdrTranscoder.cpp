@@ -0,0 +1,363 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastcdr/CdrTranscoder.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+using namespace eprosima::fastcdr;
+using namespace ::exception;
+
+namespace {
+
+/*!
+ * @brief This function reverses the bytes of a block of primitives of the same size.
+ * The loops have no dependency between elements, so compilers turn them into vector shuffles.
+ */
+void swap_block(
+        char* data,
+        size_t numElements,
+        size_t elementSize)
+{
+    switch (elementSize)
+    {
+#if defined(__GNUC__)
+        case 2:
+            for (size_t count = 0; count < numElements; ++count)
+            {
+                uint16_t value;
+                memcpy(&value, data + count * 2, 2);
+                value = __builtin_bswap16(value);
+                memcpy(data + count * 2, &value, 2);
+            }
+            break;
+        case 4:
+            for (size_t count = 0; count < numElements; ++count)
+            {
+                uint32_t value;
+                memcpy(&value, data + count * 4, 4);
+                value = __builtin_bswap32(value);
+                memcpy(data + count * 4, &value, 4);
+            }
+            break;
+        case 8:
+            for (size_t count = 0; count < numElements; ++count)
+            {
+                uint64_t value;
+                memcpy(&value, data + count * 8, 8);
+                value = __builtin_bswap64(value);
+                memcpy(data + count * 8, &value, 8);
+            }
+            break;
+#endif // if defined(__GNUC__)
+        case 1:
+            break;
+        default:
+            for (size_t count = 0; count < numElements; ++count)
+            {
+                std::reverse(data + count * elementSize, data + (count + 1) * elementSize);
+            }
+            break;
+    }
+}
+
+} // namespace
+
+size_t CdrTranscoder::swapEndianness(
+        char* data,
+        size_t size,
+        const TypeDescriptor& type,
+        const Cdr::Endianness endianness,
+        const Cdr::CdrType cdrType)
+{
+    FastBuffer buffer(data, size);
+    Cdr cdr(buffer, endianness, cdrType);
+
+    if (cdrType == Cdr::DDS_CDR)
+    {
+        cdr.read_encapsulation();
+    }
+
+    swapValue(cdr, type);
+
+    if (cdrType == Cdr::DDS_CDR)
+    {
+        // The second byte of the encapsulation holds the endianness flag.
+        data[1] = static_cast<char>(data[1] ^ Cdr::LITTLE_ENDIANNESS);
+    }
+
+    return cdr.getSerializedDataLength();
+}
+
+size_t CdrTranscoder::swapEndianness(
+        const char* source,
+        char* destination,
+        size_t size,
+        const TypeDescriptor& type,
+        const Cdr::Endianness endianness,
+        const Cdr::CdrType cdrType)
+{
+    memcpy(destination, source, size);
+    return swapEndianness(destination, size, type, endianness, cdrType);
+}
+
+void CdrTranscoder::swapValue(
+        Cdr& cdr,
+        const TypeDescriptor& type)
+{
+    uint32_t length = 0;
+
+    switch (type.getKind())
+    {
+        case TypeDescriptor::TK_STRING:
+            length = swapLength(cdr);
+            cdr.skipBytes(sizeof(char), length);
+            break;
+        case TypeDescriptor::TK_WSTRING:
+            length = swapLength(cdr);
+            swapElements(cdr, TypeDescriptor(TypeDescriptor::TK_WCHAR), length);
+            break;
+        case TypeDescriptor::TK_SEQUENCE:
+            length = swapLength(cdr);
+            // Empty sequences are not aligned to their elements.
+            if (length > 0)
+            {
+                swapElements(cdr, type.getElement(), length);
+            }
+            break;
+        case TypeDescriptor::TK_ARRAY:
+            swapElements(cdr, type.getElement(), type.getLength());
+            break;
+        case TypeDescriptor::TK_STRUCTURE:
+            for (size_t index = 0; index < type.getMemberCount(); ++index)
+            {
+                swapValue(cdr, type.getMember(index));
+            }
+            break;
+        default:
+            swapElements(cdr, type, 1);
+            break;
+    }
+}
+
+void CdrTranscoder::swapElements(
+        Cdr& cdr,
+        const TypeDescriptor& type,
+        size_t numElements)
+{
+    if (type.isPrimitive())
+    {
+        // Primitives follow each other after the alignment of the first one, so they are swapped as one block.
+        cdr.skipElements(type, numElements);
+        size_t size = numElements * type.getSerializedSize();
+        swap_block(cdr.getCurrentPosition() - size, numElements, type.getSerializedSize());
+        return;
+    }
+
+    for (size_t count = 0; count < numElements; ++count)
+    {
+        swapValue(cdr, type);
+    }
+}
+
+uint32_t CdrTranscoder::swapLength(
+        Cdr& cdr)
+{
+    uint32_t length = 0;
+    cdr.deserialize(length);
+    swap_block(cdr.getCurrentPosition() - sizeof(length), 1, sizeof(length));
+    return length;
+}
+
+void CdrTranscoder::toCdr(
+        FastCdr& source,
+        Cdr& destination,
+        const TypeDescriptor& type)
+{
+    uint32_t length = 0;
+
+    switch (type.getKind())
+    {
+        case TypeDescriptor::TK_STRING:
+            source.deserialize(length);
+            destination.serialize(length);
+            toCdrElements(source, destination, TypeDescriptor(TypeDescriptor::TK_CHAR), length);
+            break;
+        case TypeDescriptor::TK_WSTRING:
+            source.deserialize(length);
+            destination.serialize(length);
+            toCdrElements(source, destination, TypeDescriptor(TypeDescriptor::TK_WCHAR), length);
+            break;
+        case TypeDescriptor::TK_SEQUENCE:
+            source.deserialize(length);
+            destination.serialize(length);
+            toCdrElements(source, destination, type.getElement(), length);
+            break;
+        case TypeDescriptor::TK_ARRAY:
+            toCdrElements(source, destination, type.getElement(), type.getLength());
+            break;
+        case TypeDescriptor::TK_STRUCTURE:
+            for (size_t index = 0; index < type.getMemberCount(); ++index)
+            {
+                toCdr(source, destination, type.getMember(index));
+            }
+            break;
+        default:
+            toCdrElements(source, destination, type, 1);
+            break;
+    }
+}
+
+void CdrTranscoder::toFastCdr(
+        Cdr& source,
+        FastCdr& destination,
+        const TypeDescriptor& type)
+{
+    uint32_t length = 0;
+
+    switch (type.getKind())
+    {
+        case TypeDescriptor::TK_STRING:
+            source.deserialize(length);
+            destination.serialize(length);
+            toFastCdrElements(source, destination, TypeDescriptor(TypeDescriptor::TK_CHAR), length);
+            break;
+        case TypeDescriptor::TK_WSTRING:
+            source.deserialize(length);
+            destination.serialize(length);
+            toFastCdrElements(source, destination, TypeDescriptor(TypeDescriptor::TK_WCHAR), length);
+            break;
+        case TypeDescriptor::TK_SEQUENCE:
+            source.deserialize(length);
+            destination.serialize(length);
+            toFastCdrElements(source, destination, type.getElement(), length);
+            break;
+        case TypeDescriptor::TK_ARRAY:
+            toFastCdrElements(source, destination, type.getElement(), type.getLength());
+            break;
+        case TypeDescriptor::TK_STRUCTURE:
+            for (size_t index = 0; index < type.getMemberCount(); ++index)
+            {
+                toFastCdr(source, destination, type.getMember(index));
+            }
+            break;
+        default:
+            toFastCdrElements(source, destination, type, 1);
+            break;
+    }
+}
+
+void CdrTranscoder::toCdrElements(
+        FastCdr& source,
+        Cdr& destination,
+        const TypeDescriptor& type,
+        size_t numElements)
+{
+    if (type.isPrimitive())
+    {
+        // FastCdr has no padding, so the primitives are one contiguous block in the source.
+        size_t elementSize = type.getSerializedSize();
+
+        if (numElements > std::numeric_limits<size_t>::max() / elementSize)
+        {
+            throw NotEnoughMemoryException(NotEnoughMemoryException::NOT_ENOUGH_MEMORY_MESSAGE_DEFAULT);
+        }
+
+        const char* data = source.getCurrentPosition();
+
+        if (!source.jump(numElements * elementSize))
+        {
+            throw NotEnoughMemoryException(NotEnoughMemoryException::NOT_ENOUGH_MEMORY_MESSAGE_DEFAULT);
+        }
+
+        writeAligned(destination, data, numElements, elementSize, type.getAlignment());
+        return;
+    }
+
+    for (size_t count = 0; count < numElements; ++count)
+    {
+        toCdr(source, destination, type);
+    }
+}
+
+void CdrTranscoder::writeAligned(
+        Cdr& destination,
+        const char* data,
+        size_t numElements,
+        size_t elementSize,
+        size_t dataSize)
+{
+    // Empty arrays are not aligned to their elements, as when they are serialized.
+    while (numElements > 0)
+    {
+        size_t align = destination.alignment(dataSize);
+        size_t available = destination.m_lastPosition - destination.m_currentPosition;
+        size_t count = available >= align + elementSize ?
+                std::min(numElements, (available - align) / elementSize) : 0;
+
+        if (count == 0)
+        {
+            // Grows the buffer for the whole block. When streaming to a sink, the block is written in windows.
+            if (!destination.resize(align + numElements * elementSize) && !destination.resize(align + elementSize))
+            {
+                throw NotEnoughMemoryException(NotEnoughMemoryException::NOT_ENOUGH_MEMORY_MESSAGE_DEFAULT);
+            }
+
+            continue;
+        }
+
+        size_t size = count * elementSize;
+        destination.makeAlign(align);
+        destination.m_currentPosition.memcopy(data, size);
+
+        if (destination.m_swapBytes)
+        {
+            swap_block(destination.getCurrentPosition(), count, elementSize);
+        }
+
+        destination.m_currentPosition += size;
+        destination.m_lastDataSize = elementSize;
+        data += size;
+        numElements -= count;
+    }
+}
+
+void CdrTranscoder::toFastCdrElements(
+        Cdr& source,
+        FastCdr& destination,
+        const TypeDescriptor& type,
+        size_t numElements)
+{
+    if (type.isPrimitive())
+    {
+        // Primitives follow each other after the alignment of the first one, so they are copied as one block.
+        source.skipElements(type, numElements);
+        size_t size = numElements * type.getSerializedSize();
+        destination.serializeArray(source.getCurrentPosition() - size, size);
+
+        if (source.m_swapBytes)
+        {
+            swap_block(destination.getCurrentPosition() - size, numElements, type.getSerializedSize());
+        }
+
+        return;
+    }
+
+    for (size_t count = 0; count < numElements; ++count)
+    {
+        toFastCdr(source, destination, type);
+    }
+}
@@ -0,0 +1,78 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastcdr/CdrView.h>
+
+using namespace eprosima::fastcdr;
+using namespace ::exception;
+
+CdrView::CdrView(
+        FastBuffer& cdrBuffer,
+        const TypeDescriptor& type,
+        const Cdr::Endianness endianness,
+        const Cdr::CdrType cdrType)
+    : m_type(type)
+    , m_cdr(cdrBuffer, endianness, cdrType)
+{
+    if (type.getKind() != TypeDescriptor::TK_STRUCTURE)
+    {
+        throw BadParamException("CdrView needs the TypeDescriptor of a structure");
+    }
+
+    m_offsets.push_back(m_cdr.getState());
+}
+
+CdrView& CdrView::read_encapsulation()
+{
+    m_cdr.reset();
+    m_cdr.read_encapsulation();
+    m_offsets.clear();
+    m_offsets.push_back(m_cdr.getState());
+    return *this;
+}
+
+CdrView::StringView CdrView::getString(
+        size_t index)
+{
+    if (m_type.getMember(index).getKind() != TypeDescriptor::TK_STRING)
+    {
+        throw BadParamException("CdrView member is not a string");
+    }
+
+    seek(index);
+    uint32_t length = 0;
+    const char* str = m_cdr.readString(length);
+    return StringView(str, length);
+}
+
+Cdr& CdrView::seek(
+        size_t index)
+{
+    if (index >= m_type.getMemberCount())
+    {
+        throw BadParamException("CdrView member index out of range");
+    }
+
+    // Skip from the last known member up to the requested one, caching every offset found.
+    while (m_offsets.size() <= index)
+    {
+        size_t last = m_offsets.size() - 1;
+        m_cdr.setState(m_offsets[last]);
+        m_cdr.skip(m_type.getMember(last));
+        m_offsets.push_back(m_cdr.getState());
+    }
+
+    m_cdr.setState(m_offsets[index]);
+    return m_cdr;
+}
@@ -0,0 +1,206 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastcdr/FrameRing.h>
+#include <fastcdr/exceptions/BadParamException.h>
+
+using namespace eprosima::fastcdr;
+using namespace ::exception;
+
+namespace {
+
+const size_t HEADER_SIZE = 2 * sizeof(uint64_t);
+
+const size_t MIN_CAPACITY = 64;
+
+const size_t MAX_CAPACITY = size_t(1) << 31;
+
+//! @brief The length of a slot that is skipped by the consumer.
+const uint64_t SKIPPED = 0xFFFFFFFF;
+
+// The stamp of a header is the position of its slot in the stream plus one, so the zeroed ring holds no stamp. The
+// sizes hold the bytes of the slot, header included, in the high half and the length of the frame in the low half.
+uint64_t make_sizes(
+        size_t slot,
+        uint64_t length)
+{
+    uint64_t high = slot;
+    return (high << 32) | length;
+}
+
+// Slots take multiples of the header size, so the bytes skipped at the end of the ring always hold a header.
+size_t slot_size(
+        size_t size)
+{
+    return (HEADER_SIZE + size + HEADER_SIZE - 1) & ~(HEADER_SIZE - 1);
+}
+
+} // namespace
+
+FrameRing::FrameRing(
+        size_t capacity,
+        bool multipleProducers)
+    : m_buffer(nullptr)
+    , m_capacity(MIN_CAPACITY)
+    , m_multipleProducers(multipleProducers)
+    , m_head(0)
+    , m_cachedTail(0)
+    , m_tail(0)
+    , m_frontSlot(0)
+{
+    if (capacity > MAX_CAPACITY)
+    {
+        throw BadParamException("The capacity of the ring is too large");
+    }
+
+    while (m_capacity < capacity)
+    {
+        m_capacity *= 2;
+    }
+
+    m_words.reset(new std::atomic<uint64_t>[m_capacity / sizeof(uint64_t)]);
+    m_buffer = reinterpret_cast<char*>(m_words.get());
+
+    for (size_t position = 0; position < m_capacity; position += sizeof(uint64_t))
+    {
+        m_words[position / sizeof(uint64_t)].store(0, std::memory_order_relaxed);
+    }
+}
+
+FrameRing::~FrameRing()
+{
+}
+
+FrameRing::Frame FrameRing::reserve(
+        size_t size)
+{
+    // A slot of up to half the ring always fits once the ring is empty, even when it has to skip to the start.
+    if (size > m_capacity / 2 - HEADER_SIZE)
+    {
+        throw BadParamException("The frame does not fit in the ring");
+    }
+
+    size_t slot = slot_size(size);
+    size_t head = m_head.load(std::memory_order_relaxed);
+    size_t position = 0;
+    size_t needed = 0;
+
+    while (true)
+    {
+        position = head & (m_capacity - 1);
+        // A slot that does not fit before the end of the ring also takes the bytes up to the end.
+        needed = slot <= m_capacity - position ? slot : m_capacity - position + slot;
+
+        size_t tail = m_multipleProducers ? m_tail.load(std::memory_order_acquire) : m_cachedTail;
+
+        if (needed > m_capacity - (head - tail))
+        {
+            if (m_multipleProducers)
+            {
+                Frame full = {nullptr, 0};
+                return full;
+            }
+
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+
+            if (needed > m_capacity - (head - m_cachedTail))
+            {
+                Frame full = {nullptr, 0};
+                return full;
+            }
+        }
+
+        if (!m_multipleProducers)
+        {
+            m_head.store(head + needed, std::memory_order_relaxed);
+            break;
+        }
+
+        if (m_head.compare_exchange_weak(head, head + needed, std::memory_order_relaxed))
+        {
+            break;
+        }
+    }
+
+    if (needed != slot)
+    {
+        publish(position, head, m_capacity - position, SKIPPED);
+        head += m_capacity - position;
+        position = 0;
+    }
+
+    // The stamp is not published until the commit, so the position in the stream is kept in the sizes meanwhile.
+    sizes(position).store(head, std::memory_order_relaxed);
+    Frame frame = {m_buffer + position + HEADER_SIZE, slot - HEADER_SIZE};
+    return frame;
+}
+
+void FrameRing::commit(
+        const Frame& frame,
+        size_t length)
+{
+    size_t position = static_cast<size_t>(frame.data - m_buffer) - HEADER_SIZE;
+    publish(position, sizes(position).load(std::memory_order_relaxed), frame.size + HEADER_SIZE, length);
+}
+
+void FrameRing::publish(
+        size_t position,
+        size_t streamPosition,
+        size_t slot,
+        uint64_t length)
+{
+    sizes(position).store(make_sizes(slot, length), std::memory_order_relaxed);
+    stamp(position).store(streamPosition + 1, std::memory_order_release);
+}
+
+void FrameRing::abort(
+        const Frame& frame)
+{
+    commit(frame, SKIPPED);
+}
+
+FrameRing::Frame FrameRing::front()
+{
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+
+    while (true)
+    {
+        size_t position = tail & (m_capacity - 1);
+
+        // Until the slot is committed, its position holds the bytes of an older turn, with a lower stamp if any.
+        if (stamp(position).load(std::memory_order_acquire) != tail + 1)
+        {
+            Frame empty = {nullptr, 0};
+            return empty;
+        }
+
+        uint64_t value = sizes(position).load(std::memory_order_relaxed);
+        m_frontSlot = value >> 32;
+
+        if ((value & SKIPPED) != SKIPPED)
+        {
+            Frame frame = {m_buffer + position + HEADER_SIZE, value & SKIPPED};
+            return frame;
+        }
+
+        pop();
+        tail = m_tail.load(std::memory_order_relaxed);
+    }
+}
+
+void FrameRing::pop()
+{
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    m_tail.store(tail + m_frontSlot, std::memory_order_release);
+}
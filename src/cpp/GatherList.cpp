@@ -0,0 +1,104 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastcdr/GatherList.h>
+
+using namespace eprosima::fastcdr;
+
+GatherList::GatherList(
+        size_t threshold)
+    : m_threshold(threshold)
+    , m_externalSize(0)
+{
+}
+
+void GatherList::clear()
+{
+    m_externals.clear();
+    m_externalSize = 0;
+}
+
+void GatherList::addExternal(
+        size_t offset,
+        const char* data,
+        size_t size)
+{
+    External external;
+    external.offset = offset;
+    external.data = data;
+    external.size = size;
+    m_externals.push_back(external);
+    m_externalSize += size;
+}
+
+void GatherList::truncate(
+        size_t count)
+{
+    while (m_externals.size() > count)
+    {
+        m_externalSize -= m_externals.back().size;
+        m_externals.pop_back();
+    }
+}
+
+std::vector<GatherList::Segment> GatherList::getSegments(
+        const Cdr& cdr) const
+{
+    std::vector<Segment> segments;
+    segments.reserve(2 * m_externals.size() + 1);
+
+    const char* buffer = cdr.m_cdrBuffer.getBuffer();
+    size_t start = 0;
+
+    for (const External& external : m_externals)
+    {
+        if (external.offset > start)
+        {
+            Segment segment = {buffer + start, external.offset - start};
+            segments.push_back(segment);
+            start = external.offset;
+        }
+
+        Segment segment = {external.data, external.size};
+        segments.push_back(segment);
+    }
+
+    size_t end = cdr.getSerializedDataLength();
+
+    if (end > start)
+    {
+        Segment segment = {buffer + start, end - start};
+        segments.push_back(segment);
+    }
+
+    return segments;
+}
+
+#if !defined(_WIN32)
+std::vector<struct iovec> GatherList::getIovecs(
+        const Cdr& cdr) const
+{
+    std::vector<Segment> segments = getSegments(cdr);
+    std::vector<struct iovec> iovecs(segments.size());
+
+    for (size_t count = 0; count < segments.size(); ++count)
+    {
+        iovecs[count].iov_base = const_cast<char*>(segments[count].data);
+        iovecs[count].iov_len = segments[count].size;
+    }
+
+    return iovecs;
+}
+
+#endif // if !defined(_WIN32)
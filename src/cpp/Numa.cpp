@@ -0,0 +1,217 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastcdr/Numa.h>
+
+#include <cstdint>
+
+#if defined(__linux__)
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <linux/mempolicy.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif // if defined(__linux__)
+
+using namespace eprosima::fastcdr;
+
+#if defined(__linux__)
+namespace {
+
+// Reads a list of numbers in the format of the files of /sys/devices/system, e.g. "0-3,8".
+std::vector<size_t> read_list(
+        const std::string& path)
+{
+    std::vector<size_t> values;
+    std::ifstream file(path);
+    std::string text;
+
+    if (!std::getline(file, text))
+    {
+        return values;
+    }
+
+    size_t position = 0;
+
+    while (position < text.size())
+    {
+        size_t end = text.find(',', position);
+        end = end != std::string::npos ? end : text.size();
+        std::string range = text.substr(position, end - position);
+        size_t dash = range.find('-');
+
+        try
+        {
+            size_t first = std::stoul(range.substr(0, dash));
+            size_t last = dash != std::string::npos ? std::stoul(range.substr(dash + 1)) : first;
+
+            for (size_t value = first; value <= last; ++value)
+            {
+                values.push_back(value);
+            }
+        }
+        catch (...)
+        {
+            return std::vector<size_t>();
+        }
+
+        position = end + 1;
+    }
+
+    return values;
+}
+
+size_t read_node_count()
+{
+    size_t count = 1;
+
+    for (size_t node : read_list("/sys/devices/system/node/possible"))
+    {
+        count = node + 1 > count ? node + 1 : count;
+    }
+
+    return count;
+}
+
+} // namespace
+#endif // if defined(__linux__)
+
+const size_t Numa::UNKNOWN_NODE = SIZE_MAX;
+
+size_t Numa::getNodeCount()
+{
+#if defined(__linux__)
+    static const size_t count = read_node_count();
+    return count;
+#else
+    return 1;
+#endif // if defined(__linux__)
+}
+
+size_t Numa::getCurrentNode()
+{
+#if defined(__linux__)
+    if (getNodeCount() > 1)
+    {
+        unsigned int processor = 0;
+        unsigned int node = 0;
+
+#if defined(__GLIBC__) && ((__GLIBC__ > 2) || (__GLIBC_MINOR__ >= 29))
+        // The wrapper goes through the vDSO, without entering the kernel.
+        if (getcpu(&processor, &node) == 0)
+#else
+        if (syscall(SYS_getcpu, &processor, &node, nullptr) == 0)
+#endif // if defined(__GLIBC__) && ((__GLIBC__ > 2) || (__GLIBC_MINOR__ >= 29))
+        {
+            return node;
+        }
+    }
+#endif // if defined(__linux__)
+
+    return 0;
+}
+
+size_t Numa::getMemoryNode(
+        const void* address)
+{
+#if defined(__linux__)
+    if (getNodeCount() > 1)
+    {
+        int node = -1;
+
+        if ((syscall(SYS_get_mempolicy, &node, nullptr, 0, address, MPOL_F_NODE | MPOL_F_ADDR) == 0) && (node >= 0))
+        {
+            return static_cast<size_t>(node);
+        }
+
+        return UNKNOWN_NODE;
+    }
+#else
+    static_cast<void>(address);
+#endif // if defined(__linux__)
+
+    return 0;
+}
+
+bool Numa::bindMemory(
+        void* address,
+        size_t size,
+        size_t node)
+{
+    if (node >= getNodeCount())
+    {
+        return false;
+    }
+
+#if defined(__linux__)
+    if (getNodeCount() > 1)
+    {
+        const size_t bitsPerWord = 8 * sizeof(unsigned long);
+        uintptr_t pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+        uintptr_t begin = (reinterpret_cast<uintptr_t>(address) + pageSize - 1) & ~(pageSize - 1);
+        uintptr_t end = (reinterpret_cast<uintptr_t>(address) + size) & ~(pageSize - 1);
+
+        if (end <= begin)
+        {
+            return false;
+        }
+
+        std::vector<unsigned long> mask(node / bitsPerWord + 1, 0);
+        mask[node / bitsPerWord] |= 1UL << (node % bitsPerWord);
+
+        // The kernel reads one bit less than the number given.
+        return syscall(SYS_mbind, begin, end - begin, MPOL_PREFERRED, mask.data(), mask.size() * bitsPerWord + 1,
+                       MPOL_MF_MOVE) == 0;
+    }
+#else
+    static_cast<void>(address);
+    static_cast<void>(size);
+#endif // if defined(__linux__)
+
+    return true;
+}
+
+bool Numa::runOnNode(
+        size_t node)
+{
+    if (node >= getNodeCount())
+    {
+        return false;
+    }
+
+#if defined(__linux__)
+    if (getNodeCount() > 1)
+    {
+        cpu_set_t processors;
+        CPU_ZERO(&processors);
+        bool any = false;
+
+        for (size_t processor : read_list("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist"))
+        {
+            if (processor < CPU_SETSIZE)
+            {
+                CPU_SET(processor, &processors);
+                any = true;
+            }
+        }
+
+        return any && (sched_setaffinity(0, sizeof(processors), &processors) == 0);
+    }
+#endif // if defined(__linux__)
+
+    return true;
+}
@@ -0,0 +1,351 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastcdr/Recording.h>
+
+#if !defined(_WIN32)
+
+#include <fastcdr/exceptions/BadParamException.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace eprosima::fastcdr;
+using namespace ::exception;
+
+namespace {
+
+//! @brief The first bytes of an index file. They are followed by the endianness.
+const char INDEX_MAGIC[7] = {'F', 'C', 'D', 'R', 'I', 'D', 'X'};
+
+const size_t INDEX_HEADER_SIZE = 8;
+
+//! @brief An index entry holds the timestamp, the offset and the length of a sample.
+const size_t INDEX_ENTRY_SIZE = 3 * sizeof(uint64_t);
+
+const size_t INDEX_BUFFER_SIZE = 64 * 1024;
+
+const size_t MIN_BUFFER_SIZE = 64;
+
+const char PADDING[8] = {0};
+
+bool map_file(
+        const std::string& path,
+        char*& data,
+        size_t& size)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    struct stat status;
+    bool returnedValue = (fstat(fd, &status) == 0);
+
+    if (returnedValue)
+    {
+        size = static_cast<size_t>(status.st_size);
+
+        if (size > 0)
+        {
+            void* address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            returnedValue = (address != MAP_FAILED);
+            data = returnedValue ? static_cast<char*>(address) : nullptr;
+        }
+    }
+
+    ::close(fd);
+    return returnedValue;
+}
+
+void unmap_file(
+        char* data,
+        size_t size)
+{
+    if (data != nullptr)
+    {
+        munmap(data, size);
+    }
+}
+
+} // namespace
+
+RecordingWriter::RecordingWriter(
+        const std::string& path,
+        const Cdr::Endianness endianness,
+        size_t bufferSize)
+    : m_dataFd(::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644))
+    , m_indexFd(::open((path + ".idx").c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644))
+    , m_dataSink(m_dataFd)
+    , m_indexSink(m_indexFd)
+    , m_dataCdr(m_dataBuffer, endianness, Cdr::DDS_CDR)
+    , m_indexCdr(m_indexBuffer, endianness, Cdr::CORBA_CDR)
+    , m_inSample(false)
+    , m_sampleTimestamp(0)
+    , m_lastTimestamp(0)
+    , m_sampleOffset(0)
+    , m_sampleCount(0)
+{
+    if ((m_dataFd < 0) || (m_indexFd < 0))
+    {
+        if (m_dataFd >= 0)
+        {
+            ::close(m_dataFd);
+        }
+
+        if (m_indexFd >= 0)
+        {
+            ::close(m_indexFd);
+        }
+
+        throw BadParamException("Cannot create the recording files");
+    }
+
+    // The windows are allocated once, and the Cdr objects read their new end.
+    m_dataBuffer.reserve(std::max(bufferSize, MIN_BUFFER_SIZE));
+    m_indexBuffer.reserve(INDEX_BUFFER_SIZE);
+    m_dataCdr.reset();
+    m_indexCdr.reset();
+    m_dataCdr.setSink(&m_dataSink);
+    m_indexCdr.setSink(&m_indexSink);
+
+    uint8_t endiannessFlag = endianness;
+    m_indexCdr.serializeArray(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    m_indexCdr.serialize(endiannessFlag);
+}
+
+RecordingWriter::~RecordingWriter()
+{
+    close();
+}
+
+Cdr& RecordingWriter::beginSample(
+        uint64_t timestamp)
+{
+    if (m_dataFd < 0)
+    {
+        throw BadParamException("The recording is closed");
+    }
+
+    if (m_inSample)
+    {
+        throw BadParamException("The previous sample of the recording was not ended");
+    }
+
+    if ((m_sampleCount > 0) && (timestamp < m_lastTimestamp))
+    {
+        throw BadParamException("The timestamps of a recording cannot decrease");
+    }
+
+    // Samples start at multiples of 8 bytes, so they are aligned in memory when the file is mapped.
+    m_dataCdr.serializeArray(PADDING, (sizeof(PADDING) - getDataPosition() % sizeof(PADDING)) % sizeof(PADDING));
+    m_sampleOffset = getDataPosition();
+    m_dataCdr.serialize_encapsulation();
+
+    m_sampleTimestamp = timestamp;
+    m_inSample = true;
+    return m_dataCdr;
+}
+
+void RecordingWriter::endSample()
+{
+    if (!m_inSample)
+    {
+        throw BadParamException("There is no sample of the recording in progress");
+    }
+
+    m_inSample = false;
+
+    // The entry is only written once the whole sample is, so the index never references a partial sample.
+    uint64_t offset = m_sampleOffset;
+    uint64_t length = getDataPosition() - m_sampleOffset;
+    m_indexCdr << m_sampleTimestamp << offset << length;
+
+    m_lastTimestamp = m_sampleTimestamp;
+    ++m_sampleCount;
+}
+
+void RecordingWriter::abortSample()
+{
+    m_inSample = false;
+}
+
+bool RecordingWriter::flush()
+{
+    if (m_dataFd < 0)
+    {
+        return false;
+    }
+
+    // The data is written first, so the index written so far references data already in the file.
+    bool returnedValue = m_dataCdr.flush();
+    return m_indexCdr.flush() && returnedValue;
+}
+
+bool RecordingWriter::close()
+{
+    if (m_dataFd < 0)
+    {
+        return true;
+    }
+
+    m_inSample = false;
+    bool returnedValue = flush();
+    ::close(m_dataFd);
+    ::close(m_indexFd);
+    m_dataFd = -1;
+    m_indexFd = -1;
+    return returnedValue;
+}
+
+RecordingReader::RecordingReader(
+        const std::string& path)
+    : m_data(nullptr)
+    , m_dataSize(0)
+    , m_index(nullptr)
+    , m_indexSize(0)
+    , m_endianness(Cdr::DEFAULT_ENDIAN)
+    , m_sampleCount(0)
+    , m_sample(m_sampleBuffer, Cdr::DEFAULT_ENDIAN, Cdr::DDS_CDR)
+{
+    if (!map_file(path, m_data, m_dataSize) || !map_file(path + ".idx", m_index, m_indexSize))
+    {
+        unmap_file(m_data, m_dataSize);
+        throw BadParamException("Cannot open the recording files");
+    }
+
+    if ((m_indexSize < INDEX_HEADER_SIZE) || (memcmp(m_index, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0) ||
+            ((m_index[sizeof(INDEX_MAGIC)] & ~Cdr::LITTLE_ENDIANNESS) != 0))
+    {
+        unmap_file(m_data, m_dataSize);
+        unmap_file(m_index, m_indexSize);
+        throw BadParamException("The recording index is not valid");
+    }
+
+    m_endianness = m_index[sizeof(INDEX_MAGIC)] == Cdr::LITTLE_ENDIANNESS ? Cdr::LITTLE_ENDIANNESS :
+            Cdr::BIG_ENDIANNESS;
+    m_sampleCount = (m_indexSize - INDEX_HEADER_SIZE) / INDEX_ENTRY_SIZE;
+
+    // After a crash, the last entries may reference samples that did not reach the data file.
+    while (m_sampleCount > 0)
+    {
+        uint64_t timestamp = 0, offset = 0, length = 0;
+
+        try
+        {
+            readEntry(m_sampleCount - 1, timestamp, offset, length);
+            break;
+        }
+        catch (BadParamException&)
+        {
+            --m_sampleCount;
+        }
+    }
+}
+
+RecordingReader::~RecordingReader()
+{
+    unmap_file(m_data, m_dataSize);
+    unmap_file(m_index, m_indexSize);
+}
+
+size_t RecordingReader::seek(
+        uint64_t timestamp) const
+{
+    size_t first = 0;
+    size_t last = m_sampleCount;
+
+    while (first < last)
+    {
+        size_t middle = first + (last - first) / 2;
+
+        if (getTimestamp(middle) < timestamp)
+        {
+            first = middle + 1;
+        }
+        else
+        {
+            last = middle;
+        }
+    }
+
+    return first;
+}
+
+uint64_t RecordingReader::getTimestamp(
+        size_t index) const
+{
+    uint64_t timestamp = 0, offset = 0, length = 0;
+    readEntry(index, timestamp, offset, length);
+    return timestamp;
+}
+
+const char* RecordingReader::getSampleData(
+        size_t index) const
+{
+    uint64_t timestamp = 0, offset = 0, length = 0;
+    readEntry(index, timestamp, offset, length);
+    return m_data + offset;
+}
+
+size_t RecordingReader::getSampleSize(
+        size_t index) const
+{
+    uint64_t timestamp = 0, offset = 0, length = 0;
+    readEntry(index, timestamp, offset, length);
+    return length;
+}
+
+Cdr& RecordingReader::getSample(
+        size_t index)
+{
+    uint64_t timestamp = 0, offset = 0, length = 0;
+    readEntry(index, timestamp, offset, length);
+
+    m_sampleBuffer = FastBuffer(m_data + offset, length);
+    m_sample.reset();
+    m_sample.read_encapsulation();
+    return m_sample;
+}
+
+void RecordingReader::readEntry(
+        size_t index,
+        uint64_t& timestamp,
+        uint64_t& offset,
+        uint64_t& length) const
+{
+    if (index >= m_sampleCount)
+    {
+        throw BadParamException("Recording sample index out of range");
+    }
+
+    FastBuffer entry(m_index + INDEX_HEADER_SIZE + index * INDEX_ENTRY_SIZE, INDEX_ENTRY_SIZE);
+    Cdr cdr(entry, m_endianness, Cdr::CORBA_CDR);
+    cdr >> timestamp >> offset >> length;
+
+    // A corrupted entry must not reference bytes outside of the mapped data file.
+    if ((offset > m_dataSize) || (length > m_dataSize - offset))
+    {
+        throw BadParamException("Recording index entry is outside of the data file");
+    }
+}
+
+#endif // if !defined(_WIN32)
@@ -0,0 +1,86 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastcdr/ResumableDeserializer.h>
+
+using namespace eprosima::fastcdr;
+
+CONSTEXPR size_t MAX_ALIGNMENT = 8;
+
+ResumableDeserializer::ResumableDeserializer(
+        const Cdr::Endianness endianness,
+        const Cdr::CdrType cdrType)
+    : m_endianness(endianness)
+    , m_cdrType(cdrType)
+    , m_begin(0)
+    , m_consumed(0)
+    , m_inSequence(false)
+    , m_sequenceDone(0)
+{
+}
+
+void ResumableDeserializer::feed(
+        const char* data,
+        size_t size)
+{
+    m_pending.insert(m_pending.end(), data, data + size);
+}
+
+bool ResumableDeserializer::readEncapsulation()
+{
+    Cdr::Endianness endianness = m_endianness;
+
+    if (!step([&endianness](Cdr& cdr)
+            {
+                cdr.read_encapsulation();
+                endianness = cdr.endianness();
+            }))
+    {
+        return false;
+    }
+
+    m_endianness = endianness;
+
+    // The alignment restarts after the encapsulation, so the first pending byte is moved to a multiple of 8.
+    size_t padding = (MAX_ALIGNMENT - (m_begin % MAX_ALIGNMENT)) % MAX_ALIGNMENT;
+    m_pending.insert(m_pending.begin(), padding, 0);
+    m_begin += padding;
+    return true;
+}
+
+void ResumableDeserializer::reset()
+{
+    m_pending.clear();
+    m_begin = 0;
+    m_consumed = 0;
+    m_inSequence = false;
+    m_sequenceDone = 0;
+}
+
+void ResumableDeserializer::consume(
+        size_t size)
+{
+    m_begin += size;
+    m_consumed += size;
+
+    // Deserialized bytes are discarded in multiples of 8, so the pending ones keep their alignment. They are only
+    // moved once they are at least half of the buffer, to move each byte a bounded number of times.
+    size_t discard = m_begin - (m_begin % MAX_ALIGNMENT);
+
+    if ((discard > 0) && (2 * m_begin >= m_pending.size()))
+    {
+        m_pending.erase(m_pending.begin(), m_pending.begin() + static_cast<std::ptrdiff_t>(discard));
+        m_begin -= discard;
+    }
+}
@@ -0,0 +1,173 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastcdr/ThreadPool.h>
+
+using namespace eprosima::fastcdr;
+
+namespace {
+
+//! @brief The pool whose task the current thread is running, if any.
+thread_local const ThreadPool* current_pool = nullptr;
+
+} // namespace
+
+ThreadPool::ThreadPool(
+        size_t numThreads)
+    : m_task(nullptr)
+    , m_numTasks(0)
+    , m_nextTask(0)
+    , m_generation(0)
+    , m_activeWorkers(0)
+    , m_stop(false)
+{
+    m_threads.reserve(numThreads);
+
+    for (size_t count = 0; count < numThreads; ++count)
+    {
+        m_threads.emplace_back(&ThreadPool::run, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+
+    m_wakeUp.notify_all();
+
+    for (std::thread& thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+size_t ThreadPool::defaultSize()
+{
+    size_t hardwareThreads = std::thread::hardware_concurrency();
+    return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+}
+
+void ThreadPool::parallelFor(
+        size_t numTasks,
+        const Task& task)
+{
+    // A task that uses the pool again runs its tasks itself, as the workers may all be waiting for it.
+    if ((current_pool == this) || m_threads.empty() || (numTasks < 2))
+    {
+        for (size_t index = 0; index < numTasks; ++index)
+        {
+            task(index);
+        }
+
+        return;
+    }
+
+    std::lock_guard<std::mutex> callLock(m_callMutex);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_task = &task;
+        m_numTasks = numTasks;
+        m_nextTask = 0;
+        m_exception = nullptr;
+        ++m_generation;
+    }
+
+    m_wakeUp.notify_all();
+
+    const ThreadPool* previousPool = current_pool;
+    current_pool = this;
+    work();
+    current_pool = previousPool;
+
+    std::exception_ptr exception;
+
+    {
+        // The workers may still hold the task, so the call does not return until all of them have left it.
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_finished.wait(lock, [this]()
+                {
+                    return m_activeWorkers == 0;
+                });
+        m_task = nullptr;
+        exception = m_exception;
+        m_exception = nullptr;
+    }
+
+    if (exception)
+    {
+        std::rethrow_exception(exception);
+    }
+}
+
+void ThreadPool::run()
+{
+    current_pool = this;
+    size_t generation = 0;
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (true)
+    {
+        m_wakeUp.wait(lock, [this, generation]()
+                {
+                    return m_stop || ((m_task != nullptr) && (m_generation != generation));
+                });
+
+        if (m_stop)
+        {
+            return;
+        }
+
+        generation = m_generation;
+        ++m_activeWorkers;
+        lock.unlock();
+        work();
+        lock.lock();
+
+        if (--m_activeWorkers == 0)
+        {
+            m_finished.notify_one();
+        }
+    }
+}
+
+void ThreadPool::work()
+{
+    while (true)
+    {
+        size_t index = m_nextTask.fetch_add(1);
+
+        if (index >= m_numTasks)
+        {
+            return;
+        }
+
+        try
+        {
+            (*m_task)(index);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (!m_exception)
+            {
+                m_exception = std::current_exception();
+            }
+        }
+    }
+}
@@ -0,0 +1,152 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastcdr/TypeDescriptor.h>
+#include <fastcdr/exceptions/BadParamException.h>
+
+using namespace eprosima::fastcdr;
+using namespace ::exception;
+
+TypeDescriptor::TypeDescriptor(
+        Kind kind)
+    : m_kind(kind)
+    , m_length(0)
+{
+    if (kind > TK_WSTRING)
+    {
+        throw BadParamException("TypeDescriptor of a sequence, array or structure must be created with its factory");
+    }
+}
+
+TypeDescriptor TypeDescriptor::sequence(
+        const TypeDescriptor& element)
+{
+    TypeDescriptor returnedValue(TK_OCTET);
+    returnedValue.m_kind = TK_SEQUENCE;
+    returnedValue.m_element = std::make_shared<const TypeDescriptor>(element);
+    return returnedValue;
+}
+
+TypeDescriptor TypeDescriptor::array(
+        const TypeDescriptor& element,
+        size_t length)
+{
+    TypeDescriptor returnedValue(TK_OCTET);
+    returnedValue.m_kind = TK_ARRAY;
+    returnedValue.m_length = length;
+    returnedValue.m_element = std::make_shared<const TypeDescriptor>(element);
+    return returnedValue;
+}
+
+TypeDescriptor TypeDescriptor::structure()
+{
+    TypeDescriptor returnedValue(TK_OCTET);
+    returnedValue.m_kind = TK_STRUCTURE;
+    return returnedValue;
+}
+
+TypeDescriptor& TypeDescriptor::addMember(
+        const std::string& name,
+        const TypeDescriptor& type)
+{
+    if (m_kind != TK_STRUCTURE)
+    {
+        throw BadParamException("Members can only be added to a TypeDescriptor of a structure");
+    }
+
+    Member member;
+    member.name = name;
+    member.type = std::make_shared<const TypeDescriptor>(type);
+    m_members.push_back(member);
+    return *this;
+}
+
+size_t TypeDescriptor::getSerializedSize() const
+{
+    switch (m_kind)
+    {
+        case TK_BOOLEAN:
+        case TK_CHAR:
+        case TK_OCTET:
+            return 1;
+        case TK_SHORT:
+        case TK_USHORT:
+            return 2;
+        case TK_LONG:
+        case TK_ULONG:
+        case TK_FLOAT:
+        case TK_WCHAR:
+            return 4;
+        case TK_LONGLONG:
+        case TK_ULONGLONG:
+        case TK_DOUBLE:
+            return 8;
+        case TK_LONGDOUBLE:
+            return 16;
+        default:
+            return 0;
+    }
+}
+
+size_t TypeDescriptor::getAlignment() const
+{
+    // Long doubles take 16 bytes but are aligned to 8.
+    return m_kind == TK_LONGDOUBLE ? 8 : getSerializedSize();
+}
+
+const TypeDescriptor& TypeDescriptor::getElement() const
+{
+    if (!m_element)
+    {
+        throw BadParamException("TypeDescriptor is not a sequence or an array");
+    }
+
+    return *m_element;
+}
+
+const TypeDescriptor& TypeDescriptor::getMember(
+        size_t index) const
+{
+    if (index >= m_members.size())
+    {
+        throw BadParamException("TypeDescriptor member index out of range");
+    }
+
+    return *m_members[index].type;
+}
+
+const std::string& TypeDescriptor::getMemberName(
+        size_t index) const
+{
+    if (index >= m_members.size())
+    {
+        throw BadParamException("TypeDescriptor member index out of range");
+    }
+
+    return m_members[index].name;
+}
+
+size_t TypeDescriptor::getMemberIndex(
+        const std::string& name) const
+{
+    for (size_t index = 0; index < m_members.size(); ++index)
+    {
+        if (m_members[index].name == name)
+        {
+            return index;
+        }
+    }
+
+    throw BadParamException("TypeDescriptor has no member with that name");
+}
@@ -0,0 +1,147 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastcdr/Cdr.h>
+#include <fastcdr/Arena.h>
+
+#include <gtest/gtest.h>
+
+using namespace eprosima::fastcdr;
+using namespace ::exception;
+
+typedef std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>> ArenaString;
+
+TEST(ArenaTests, AlignmentAndReset)
+{
+    Arena arena(64);
+
+    char* octet = static_cast<char*>(arena.allocate(1, 1));
+    double* doubles = static_cast<double*>(arena.allocate(3 * sizeof(double), alignof(double)));
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(doubles) % alignof(double));
+    EXPECT_NE(static_cast<void*>(octet), static_cast<void*>(doubles));
+
+    // Larger than the initial block.
+    void* big = arena.allocate(1000, 16);
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(big) % 16);
+    EXPECT_LE(1000u + 3 * sizeof(double) + 1, arena.getAllocatedBytes());
+
+    // The largest block is kept and reused.
+    arena.reset();
+    EXPECT_EQ(0u, arena.getAllocatedBytes());
+    void* reused = arena.allocate(1000, 16);
+    EXPECT_EQ(big, reused);
+}
+
+TEST(ArenaTests, AllocatorContainers)
+{
+    char buffer[256] = {0};
+    FastBuffer cdrbuffer(buffer, sizeof(buffer));
+
+    std::vector<int32_t> vector_value = {1, 2, 3, 4, 5};
+
+    Cdr cdr_ser(cdrbuffer);
+    cdr_ser << vector_value << std::string("a string");
+
+    Arena arena;
+    ArenaAllocator<char> allocator(arena);
+    std::vector<int32_t, ArenaAllocator<int32_t>> vector_result(allocator);
+    ArenaString string_result(allocator);
+
+    Cdr cdr_des(cdrbuffer);
+    cdr_des >> vector_result >> string_result;
+
+    ASSERT_EQ(vector_value.size(), vector_result.size());
+    EXPECT_TRUE(std::equal(vector_value.begin(), vector_value.end(), vector_result.begin()));
+    EXPECT_EQ("a string", std::string(string_result.c_str()));
+    EXPECT_LT(0u, arena.getAllocatedBytes());
+
+    // Serializing the arena containers gives the same bytes.
+    char out_buffer[256] = {0};
+    FastBuffer out_cdrbuffer(out_buffer, sizeof(out_buffer));
+    Cdr cdr_out(out_cdrbuffer);
+    cdr_out << vector_result << string_result;
+    ASSERT_EQ(cdr_ser.getSerializedDataLength(), cdr_out.getSerializedDataLength());
+    EXPECT_EQ(0, memcmp(buffer, out_buffer, cdr_ser.getSerializedDataLength()));
+}
+
+TEST(ArenaTests, RawSequences)
+{
+    char buffer[256] = {0};
+    FastBuffer cdrbuffer(buffer, sizeof(buffer));
+
+    int64_t longlong_seq[3] = {-1, 2, -3};
+    std::string string_seq[2] = {"first", ""};
+
+    Cdr cdr_ser(cdrbuffer);
+    cdr_ser.serializeSequence(longlong_seq, 3);
+    cdr_ser.serializeSequence(string_seq, 2);
+    cdr_ser << "c string";
+
+    Arena arena;
+    int64_t* longlong_result = nullptr;
+    size_t longlong_length = 0;
+    char** string_result = nullptr;
+    size_t string_length = 0;
+    char* c_string_result = nullptr;
+
+    Cdr cdr_des(cdrbuffer);
+    cdr_des.deserializeSequence(longlong_result, longlong_length, arena);
+    cdr_des.deserializeStringSequence(string_result, string_length, arena);
+    cdr_des.deserialize(c_string_result, arena);
+
+    ASSERT_EQ(3u, longlong_length);
+    EXPECT_EQ(0, memcmp(longlong_seq, longlong_result, sizeof(longlong_seq)));
+    ASSERT_EQ(2u, string_length);
+    EXPECT_STREQ("first", string_result[0]);
+    EXPECT_STREQ("", string_result[1]);
+    EXPECT_STREQ("c string", c_string_result);
+    EXPECT_EQ(cdr_ser.getSerializedDataLength(), cdr_des.getSerializedDataLength());
+
+    // Nothing is allocated when the length is corrupted.
+    cdr_des.reset();
+    arena.reset();
+    char corrupted[8] = {0x7F, 0x7F, 0x7F, 0x7F, 0, 0, 0, 0};
+    FastBuffer corrupted_cdrbuffer(corrupted, sizeof(corrupted));
+    Cdr corrupted_des(corrupted_cdrbuffer, Cdr::BIG_ENDIANNESS);
+    EXPECT_THROW(corrupted_des.deserializeSequence(longlong_result, longlong_length, arena),
+            NotEnoughMemoryException);
+    EXPECT_THROW(corrupted_des.deserializeStringSequence(string_result, string_length, arena),
+            NotEnoughMemoryException);
+    EXPECT_EQ(0u, arena.getAllocatedBytes());
+}
+
+#if defined(__cpp_lib_memory_resource)
+TEST(ArenaTests, PmrContainers)
+{
+    char buffer[256] = {0};
+    FastBuffer cdrbuffer(buffer, sizeof(buffer));
+
+    Cdr cdr_ser(cdrbuffer);
+    cdr_ser << std::vector<uint16_t>{1, 2, 3} << std::vector<std::string>{"x", "yy"};
+
+    Arena arena;
+    ArenaMemoryResource resource(arena);
+    std::pmr::vector<uint16_t> ushort_result(&resource);
+    std::pmr::vector<std::pmr::string> strings_result(&resource);
+
+    Cdr cdr_des(cdrbuffer);
+    cdr_des >> ushort_result >> strings_result;
+
+    EXPECT_EQ(3u, ushort_result.size());
+    ASSERT_EQ(2u, strings_result.size());
+    EXPECT_EQ("yy", strings_result[1]);
+    EXPECT_LT(0u, arena.getAllocatedBytes());
+}
+
+#endif // if defined(__cpp_lib_memory_resource)
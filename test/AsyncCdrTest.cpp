@@ -0,0 +1,455 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastcdr/AsyncCdr.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <memory>
+
+using namespace eprosima::fastcdr;
+using namespace ::exception;
+
+// Resumes the coroutines waiting on the sinks and sources one at a time, as a single-threaded event loop would.
+class EventLoop
+{
+public:
+
+    struct Wait
+    {
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        void await_suspend(
+                std::coroutine_handle<> handle)
+        {
+            loop.m_ready.push_back(handle);
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+
+        EventLoop& loop;
+    };
+
+    Wait wait()
+    {
+        return Wait{*this};
+    }
+
+    void run()
+    {
+        while (!m_ready.empty())
+        {
+            std::coroutine_handle<> handle = m_ready.front();
+            m_ready.pop_front();
+            handle.resume();
+        }
+    }
+
+private:
+
+    std::deque<std::coroutine_handle<>> m_ready;
+};
+
+// A socket that is never writable right away.
+class LoopSink : public AsyncSink
+{
+public:
+
+    explicit LoopSink(
+            EventLoop& loop)
+        : m_loop(loop)
+    {
+    }
+
+    AsyncTask<bool> write(
+            const char* data,
+            size_t size) override
+    {
+        co_await m_loop.wait();
+
+        if (m_fail)
+        {
+            co_return false;
+        }
+
+        m_bytes.insert(m_bytes.end(), data, data + size);
+        m_maxWrite = std::max(m_maxWrite, size);
+        co_return true;
+    }
+
+    EventLoop& m_loop;
+    std::vector<char> m_bytes;
+    size_t m_maxWrite = 0;
+    bool m_fail = false;
+};
+
+// A socket that receives a few bytes at a time.
+class LoopSource : public AsyncSource
+{
+public:
+
+    LoopSource(
+            EventLoop& loop,
+            const std::vector<char>& bytes,
+            size_t chunkSize)
+        : m_loop(loop)
+        , m_bytes(bytes)
+        , m_chunkSize(chunkSize)
+    {
+    }
+
+    AsyncTask<size_t> read(
+            char* data,
+            size_t size) override
+    {
+        co_await m_loop.wait();
+
+        size_t count = std::min({size, m_chunkSize, m_bytes.size() - m_offset});
+        memcpy(data, m_bytes.data() + m_offset, count);
+        m_offset += count;
+        co_return count;
+    }
+
+    EventLoop& m_loop;
+    const std::vector<char>& m_bytes;
+    size_t m_chunkSize;
+    size_t m_offset = 0;
+};
+
+struct Envelope
+{
+    void serialize(
+            Cdr& cdr) const
+    {
+        cdr << flag << id << topic;
+    }
+
+    void deserialize(
+            Cdr& cdr)
+    {
+        cdr >> flag >> id >> topic;
+    }
+
+    bool operator ==(
+            const Envelope& other) const
+    {
+        return (flag == other.flag) && (id == other.id) && (topic == other.topic);
+    }
+
+    uint8_t flag = 0;
+    uint64_t id = 0;
+    std::string topic;
+};
+
+struct Transfer
+{
+    Envelope header;
+    std::vector<double> samples;
+    std::vector<Envelope> attachments;
+    std::string trailer;
+};
+
+static Transfer make_transfer(
+        size_t index)
+{
+    Transfer transfer;
+    transfer.header.flag = static_cast<uint8_t>(index);
+    transfer.header.id = index * 1000003;
+    transfer.header.topic = std::string(index % 17, 't');
+    transfer.samples.resize(1000 + index * 37);
+
+    for (size_t count = 0; count < transfer.samples.size(); ++count)
+    {
+        transfer.samples[count] = static_cast<double>(count + index) / 7;
+    }
+
+    transfer.attachments.resize(index % 40);
+
+    for (size_t count = 0; count < transfer.attachments.size(); ++count)
+    {
+        transfer.attachments[count].flag = static_cast<uint8_t>(count);
+        transfer.attachments[count].id = count;
+        transfer.attachments[count].topic = std::string(count % 5, 'a');
+    }
+
+    transfer.trailer = "end";
+    return transfer;
+}
+
+static std::vector<char> serialize_transfer(
+        const Transfer& transfer,
+        Cdr::Endianness endianness)
+{
+    // The padding is not written, so the buffer starts zeroed as the windows of the serializer.
+    std::vector<char> bytes(1024 * 1024, 0);
+    FastBuffer buffer(bytes.data(), bytes.size());
+    Cdr cdr(buffer, endianness, Cdr::DDS_CDR);
+    cdr.serialize_encapsulation();
+    cdr << transfer.header << transfer.samples << transfer.attachments << transfer.trailer;
+    bytes.resize(cdr.getSerializedDataLength());
+    return bytes;
+}
+
+static AsyncTask<> send_transfer(
+        AsyncSerializer& serializer,
+        const Transfer& transfer)
+{
+    co_await serializer.serializeEncapsulation();
+    co_await serializer.serialize(transfer.header);
+    co_await serializer.serializeSequence(transfer.samples);
+    co_await serializer.serializeSequence(transfer.attachments);
+    co_await serializer.serialize(transfer.trailer);
+    co_await serializer.flush();
+}
+
+static AsyncTask<Transfer> receive_transfer(
+        AsyncDeserializer& deserializer)
+{
+    Transfer transfer;
+    co_await deserializer.readEncapsulation();
+    co_await deserializer.deserialize(transfer.header);
+    co_await deserializer.deserializeSequence(transfer.samples);
+    co_await deserializer.deserializeSequence(transfer.attachments);
+    co_await deserializer.deserialize(transfer.trailer);
+    co_return transfer;
+}
+
+TEST(AsyncCdrTests, SameBytesAsCdr)
+{
+    EventLoop loop;
+    Transfer transfer = make_transfer(25);
+
+    for (Cdr::Endianness endianness : {Cdr::BIG_ENDIANNESS, Cdr::LITTLE_ENDIANNESS})
+    {
+        for (size_t windowSize : {64u, 100u, 1024u})
+        {
+            LoopSink sink(loop);
+            AsyncSerializer serializer(sink, windowSize, endianness);
+            AsyncTask<> task = send_transfer(serializer, transfer);
+            task.start();
+            loop.run();
+
+            ASSERT_TRUE(task.done());
+            task.get();
+            EXPECT_EQ(serialize_transfer(transfer, endianness), sink.m_bytes);
+            EXPECT_EQ(sink.m_bytes.size(), serializer.getSerializedDataLength());
+            EXPECT_LE(sink.m_maxWrite, windowSize);
+        }
+    }
+}
+
+TEST(AsyncCdrTests, ManyMessagesOnOneThread)
+{
+    const size_t numMessages = 300;
+    EventLoop loop;
+    std::vector<Transfer> transfers;
+    std::vector<std::unique_ptr<LoopSink>> sinks;
+    std::vector<std::unique_ptr<AsyncSerializer>> serializers;
+    std::vector<AsyncTask<>> sends;
+
+    for (size_t index = 0; index < numMessages; ++index)
+    {
+        transfers.push_back(make_transfer(index));
+    }
+
+    // Every message is in flight at the same time, each one with a window of 512 bytes.
+    for (size_t index = 0; index < numMessages; ++index)
+    {
+        sinks.emplace_back(new LoopSink(loop));
+        serializers.emplace_back(new AsyncSerializer(*sinks.back(), 512, Cdr::BIG_ENDIANNESS));
+        sends.push_back(send_transfer(*serializers.back(), transfers[index]));
+        sends.back().start();
+    }
+
+    loop.run();
+
+    for (size_t index = 0; index < numMessages; ++index)
+    {
+        ASSERT_TRUE(sends[index].done());
+        sends[index].get();
+        ASSERT_EQ(serialize_transfer(transfers[index], Cdr::BIG_ENDIANNESS), sinks[index]->m_bytes);
+    }
+
+    std::vector<std::unique_ptr<LoopSource>> sources;
+    std::vector<std::unique_ptr<AsyncDeserializer>> deserializers;
+    std::vector<AsyncTask<Transfer>> receives;
+
+    for (size_t index = 0; index < numMessages; ++index)
+    {
+        sources.emplace_back(new LoopSource(loop, sinks[index]->m_bytes, 1 + index % 97));
+        deserializers.emplace_back(new AsyncDeserializer(*sources.back(), 256));
+        receives.push_back(receive_transfer(*deserializers.back()));
+        receives.back().start();
+    }
+
+    loop.run();
+
+    for (size_t index = 0; index < numMessages; ++index)
+    {
+        ASSERT_TRUE(receives[index].done());
+        Transfer transfer = receives[index].get();
+        EXPECT_EQ(transfers[index].header, transfer.header);
+        EXPECT_EQ(transfers[index].samples, transfer.samples);
+        EXPECT_EQ(transfers[index].attachments, transfer.attachments);
+        EXPECT_EQ(transfers[index].trailer, transfer.trailer);
+        EXPECT_EQ(sinks[index]->m_bytes.size(), deserializers[index]->getConsumedBytes());
+    }
+}
+
+TEST(AsyncCdrTests, Errors)
+{
+    EventLoop loop;
+
+    // A value larger than the window.
+    {
+        LoopSink sink(loop);
+        AsyncSerializer serializer(sink, 64);
+        std::string large(100, 'x');
+        AsyncTask<> task = serializer.serialize(large);
+        task.start();
+        loop.run();
+        ASSERT_TRUE(task.done());
+        EXPECT_THROW(task.get(), NotEnoughMemoryException);
+    }
+
+    // A sink that fails.
+    {
+        LoopSink sink(loop);
+        sink.m_fail = true;
+        AsyncSerializer serializer(sink, 64);
+        std::vector<uint32_t> values(100, 3);
+        AsyncTask<> task = serializer.serializeSequence(values);
+        task.start();
+        loop.run();
+        ASSERT_TRUE(task.done());
+        EXPECT_THROW(task.get(), NotEnoughMemoryException);
+    }
+
+    // A stream that ends too early.
+    {
+        Transfer transfer = make_transfer(3);
+        std::vector<char> bytes = serialize_transfer(transfer, Cdr::DEFAULT_ENDIAN);
+        bytes.resize(bytes.size() / 2);
+        LoopSource source(loop, bytes, 64);
+        AsyncDeserializer deserializer(source);
+        AsyncTask<Transfer> task = receive_transfer(deserializer);
+        task.start();
+        loop.run();
+        ASSERT_TRUE(task.done());
+        EXPECT_THROW(task.get(), NotEnoughMemoryException);
+    }
+
+    // A sequence longer than the limits.
+    {
+        std::vector<Envelope> envelopes(10);
+        FastBuffer buffer;
+        Cdr cdr(buffer);
+        cdr << envelopes;
+        std::vector<char> bytes(buffer.getBuffer(), buffer.getBuffer() + cdr.getSerializedDataLength());
+
+        LoopSource source(loop, bytes, 64);
+        AsyncDeserializer deserializer(source, 64, Cdr::DEFAULT_ENDIAN, Cdr::CORBA_CDR);
+        Cdr::DeserializationLimits limits;
+        limits.maxSequenceElements = 5;
+        deserializer.setDeserializationLimits(limits);
+        std::vector<Envelope> result;
+        AsyncTask<> task = deserializer.deserializeSequence(result);
+        task.start();
+        loop.run();
+        ASSERT_TRUE(task.done());
+        EXPECT_THROW(task.get(), BadParamException);
+    }
+
+    // A corrupted sequence length, within the limits of the elements but not of the memory.
+    {
+        std::vector<char> bytes(64, 0);
+        memset(bytes.data(), 0xFF, 4);
+
+        LoopSource source(loop, bytes, 64);
+        AsyncDeserializer deserializer(source, 64, Cdr::DEFAULT_ENDIAN, Cdr::CORBA_CDR);
+        Cdr::DeserializationLimits limits;
+        limits.maxTotalAllocation = 1024 * 1024;
+        deserializer.setDeserializationLimits(limits);
+        std::vector<Envelope> result;
+        AsyncTask<> task = deserializer.deserializeSequence(result);
+        task.start();
+        loop.run();
+        ASSERT_TRUE(task.done());
+        EXPECT_THROW(task.get(), BadParamException);
+    }
+
+    // Without limits, a corrupted sequence length fails when the stream ends.
+    {
+        std::vector<char> bytes(64, 0);
+        memset(bytes.data(), 0xFF, 4);
+
+        LoopSource source(loop, bytes, 64);
+        AsyncDeserializer deserializer(source, 64, Cdr::DEFAULT_ENDIAN, Cdr::CORBA_CDR);
+        std::vector<Envelope> result;
+        AsyncTask<> task = deserializer.deserializeSequence(result);
+        task.start();
+        loop.run();
+        ASSERT_TRUE(task.done());
+        EXPECT_THROW(task.get(), NotEnoughMemoryException);
+    }
+}
+
+TEST(AsyncCdrTests, SequenceOfLongDouble)
+{
+    EventLoop loop;
+    std::vector<long double> values(20);
+
+    for (size_t count = 0; count < values.size(); ++count)
+    {
+        values[count] = static_cast<long double>(count) / 3;
+    }
+
+    // Each element is written as a single value, so they all have to fit in the window.
+    LoopSink sink(loop);
+    AsyncSerializer serializer(sink, 64, Cdr::DEFAULT_ENDIAN, Cdr::CORBA_CDR);
+    AsyncTask<> send = serializer.serializeSequence(values);
+    send.start();
+    loop.run();
+    ASSERT_TRUE(send.done());
+    send.get();
+    AsyncTask<> flush = serializer.flush();
+    flush.start();
+    loop.run();
+    ASSERT_TRUE(flush.done());
+    flush.get();
+
+    // The bytes are not compared, as the padding of a long double in memory is undefined.
+    FastBuffer buffer;
+    Cdr cdr(buffer, Cdr::DEFAULT_ENDIAN, Cdr::CORBA_CDR);
+    cdr << values;
+    EXPECT_EQ(cdr.getSerializedDataLength(), sink.m_bytes.size());
+
+    LoopSource source(loop, sink.m_bytes, 7);
+    AsyncDeserializer deserializer(source, 64, Cdr::DEFAULT_ENDIAN, Cdr::CORBA_CDR);
+    std::vector<long double> result;
+    AsyncTask<> receive = deserializer.deserializeSequence(result);
+    receive.start();
+    loop.run();
+    ASSERT_TRUE(receive.done());
+    receive.get();
+    EXPECT_EQ(values, result);
+}
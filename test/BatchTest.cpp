@@ -0,0 +1,269 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastcdr/Batch.h>
+#include <fastcdr/ThreadPool.h>
+#include <fastcdr/exceptions/BadParamException.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+
+using namespace eprosima::fastcdr;
+using namespace ::exception;
+
+struct Message
+{
+    void serialize(
+            Cdr& cdr) const
+    {
+        cdr << id << name << values;
+    }
+
+    void deserialize(
+            Cdr& cdr)
+    {
+        cdr >> id >> name >> values;
+    }
+
+    bool operator ==(
+            const Message& other) const
+    {
+        return id == other.id && name == other.name && values == other.values;
+    }
+
+    uint8_t id = 0;
+    std::string name;
+    std::vector<double> values;
+};
+
+static std::vector<Message> make_samples()
+{
+    std::vector<Message> samples(200);
+
+    for (size_t count = 0; count < samples.size(); ++count)
+    {
+        samples[count].id = static_cast<uint8_t>(count);
+        samples[count].name = std::string(count % 7, 's');
+        samples[count].values.assign(count % 3, static_cast<double>(count));
+    }
+
+    return samples;
+}
+
+static void round_trip(
+        Cdr::Endianness endianness,
+        Cdr::CdrType cdrType)
+{
+    std::vector<Message> samples = make_samples();
+    FastBuffer cdrbuffer;
+    BatchWriter writer(cdrbuffer, endianness, cdrType);
+
+    for (const Message& sample : samples)
+    {
+        writer.add(sample);
+    }
+
+    ASSERT_EQ(samples.size(), writer.getMessageCount());
+
+    BatchReader reader(cdrbuffer.getBuffer(), writer.getSerializedDataLength(), endianness, cdrType);
+    size_t count = 0;
+
+    while (reader.next())
+    {
+        ASSERT_LT(count, samples.size());
+
+        // The message is read in place.
+        EXPECT_GE(reader.getMessageData(), cdrbuffer.getBuffer());
+        EXPECT_LE(reader.getMessageData() + reader.getMessageSize(),
+                cdrbuffer.getBuffer() + writer.getSerializedDataLength());
+
+        Message sample;
+        reader.getMessage() >> sample;
+        EXPECT_EQ(samples[count], sample);
+        EXPECT_EQ(reader.getMessageSize(), reader.getMessage().getSerializedDataLength());
+        ++count;
+    }
+
+    EXPECT_EQ(samples.size(), count);
+}
+
+TEST(BatchTests, RoundTrip)
+{
+    round_trip(Cdr::LITTLE_ENDIANNESS, Cdr::DDS_CDR);
+    round_trip(Cdr::BIG_ENDIANNESS, Cdr::DDS_CDR);
+    round_trip(Cdr::LITTLE_ENDIANNESS, Cdr::CORBA_CDR);
+    round_trip(Cdr::BIG_ENDIANNESS, Cdr::CORBA_CDR);
+}
+
+TEST(BatchTests, MessagesAreAlignedAlone)
+{
+    FastBuffer cdrbuffer;
+    BatchWriter writer(cdrbuffer);
+    writer.add(static_cast<uint8_t>(1));
+    writer.beginMessage() << 2.5;
+    writer.endMessage();
+
+    // A double alone after the encapsulation needs no padding.
+    BatchReader reader(cdrbuffer.getBuffer(), writer.getSerializedDataLength());
+    ASSERT_TRUE(reader.next());
+    ASSERT_TRUE(reader.next());
+    EXPECT_EQ(12u, reader.getMessageSize());
+
+    double value = 0;
+    reader.getMessage() >> value;
+    EXPECT_EQ(2.5, value);
+    EXPECT_FALSE(reader.next());
+}
+
+TEST(BatchTests, RollbackOnFailure)
+{
+    char buffer[64] = {0};
+    FastBuffer cdrbuffer(buffer, sizeof(buffer));
+    BatchWriter writer(cdrbuffer, Cdr::DEFAULT_ENDIAN, Cdr::CORBA_CDR);
+    writer.add(std::string("first"));
+    size_t length = writer.getSerializedDataLength();
+
+    EXPECT_THROW(writer.add(std::string(100, 'x')), NotEnoughMemoryException);
+    EXPECT_EQ(1u, writer.getMessageCount());
+    EXPECT_EQ(length, writer.getSerializedDataLength());
+
+    writer.add(std::string("second"));
+    EXPECT_THROW(writer.endMessage(), BadParamException);
+
+    writer.beginMessage();
+    EXPECT_THROW(writer.beginMessage(), BadParamException);
+    writer.abortMessage();
+    EXPECT_EQ(2u, writer.getMessageCount());
+
+    BatchReader reader(buffer, writer.getSerializedDataLength(), Cdr::DEFAULT_ENDIAN, Cdr::CORBA_CDR);
+    std::string value;
+    ASSERT_TRUE(reader.next());
+    reader.getMessage() >> value;
+    EXPECT_EQ("first", value);
+    ASSERT_TRUE(reader.next());
+    reader.getMessage() >> value;
+    EXPECT_EQ("second", value);
+    EXPECT_FALSE(reader.next());
+}
+
+TEST(BatchTests, Truncated)
+{
+    std::vector<Message> samples = make_samples();
+    FastBuffer cdrbuffer;
+    BatchWriter writer(cdrbuffer);
+    writer.add(samples[10]).add(samples[20]);
+
+    BatchReader reader(cdrbuffer.getBuffer(), writer.getSerializedDataLength() - 1);
+    ASSERT_TRUE(reader.next());
+    EXPECT_THROW(reader.next(), NotEnoughMemoryException);
+
+    // A message cannot read beyond its own frame.
+    BatchReader overrun(cdrbuffer.getBuffer(), writer.getSerializedDataLength());
+    ASSERT_TRUE(overrun.next());
+    Message sample;
+    overrun.getMessage() >> sample;
+    EXPECT_THROW(overrun.getMessage() >> sample, NotEnoughMemoryException);
+}
+
+TEST(BatchTests, ParallelDeserialization)
+{
+    ThreadPool pool(3);
+    std::vector<Message> samples = make_samples();
+    std::vector<std::vector<char>> storage;
+
+    for (size_t count = 0; count < 2000; ++count)
+    {
+        // Each message has its own encapsulation, so their endianness may differ.
+        FastBuffer cdrbuffer;
+        Cdr cdr(cdrbuffer, count % 2 ? Cdr::BIG_ENDIANNESS : Cdr::LITTLE_ENDIANNESS, Cdr::DDS_CDR);
+        cdr.serialize_encapsulation();
+        cdr << samples[count % samples.size()];
+        storage.emplace_back(cdrbuffer.getBuffer(), cdrbuffer.getBuffer() + cdr.getSerializedDataLength());
+    }
+
+    std::vector<BatchDeserializer::Message> messages;
+
+    for (std::vector<char>& data : storage)
+    {
+        BatchDeserializer::Message message = {data.data(), data.size()};
+        messages.push_back(message);
+    }
+
+    messages[7].length = 3;
+    messages[1500].length -= 1;
+
+    BatchDeserializer deserializer(pool);
+    std::vector<Message> results(messages.size());
+    EXPECT_EQ(2u, deserializer.deserialize(messages.data(), messages.size(), results.data()));
+
+    for (size_t count = 0; count < messages.size(); ++count)
+    {
+        if ((count == 7) || (count == 1500))
+        {
+            ASSERT_TRUE(deserializer.getError(count) != nullptr);
+            EXPECT_THROW(std::rethrow_exception(deserializer.getError(count)), NotEnoughMemoryException);
+        }
+        else
+        {
+            EXPECT_TRUE(deserializer.getError(count) == nullptr);
+            EXPECT_EQ(samples[count % samples.size()], results[count]);
+        }
+    }
+
+    // The same object deserializes the next batch, with the errors of the function kept per message.
+    std::atomic<size_t> calls(0);
+    EXPECT_EQ(20u, deserializer.deserialize(messages.data() + 10, 1000, [&](Cdr& cdr, size_t index)
+            {
+                ++calls;
+                if (index % 50 == 0)
+                {
+                    throw BadParamException("Rejected message");
+                }
+                Message sample;
+                cdr >> sample;
+            }));
+    EXPECT_EQ(1000u, calls);
+    EXPECT_THROW(std::rethrow_exception(deserializer.getError(50)), BadParamException);
+    EXPECT_TRUE(deserializer.getError(51) == nullptr);
+    EXPECT_THROW(deserializer.getError(1000), BadParamException);
+
+    Cdr::DeserializationLimits limits;
+    limits.maxStringBytes = 3;
+    deserializer.setDeserializationLimits(limits);
+    EXPECT_EQ(0u, deserializer.deserialize(messages.data(), 0, results.data()));
+    EXPECT_LT(0u, deserializer.deserialize(messages.data(), 700, results.data()));
+
+    // The limits apply to each message as to a sequential deserialization.
+    for (size_t count = 0; count < 700; ++count)
+    {
+        FastBuffer cdrbuffer(messages[count].data, messages[count].length);
+        Cdr cdr(cdrbuffer, Cdr::DEFAULT_ENDIAN, Cdr::DDS_CDR);
+        cdr.setDeserializationLimits(limits);
+        bool failed = false;
+
+        try
+        {
+            Message sample;
+            cdr.read_encapsulation();
+            cdr >> sample;
+        }
+        catch (eprosima::fastcdr::exception::Exception&)
+        {
+            failed = true;
+        }
+
+        EXPECT_EQ(failed, deserializer.getError(count) != nullptr);
+    }
+}
@@ -0,0 +1,216 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastcdr/BufferPool.h>
+#include <fastcdr/Cdr.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+using namespace eprosima::fastcdr;
+
+TEST(BufferPoolTests, SizeClasses)
+{
+    BufferPool pool(1024 * 1024, 4096, 1);
+
+    FastBuffer small = pool.acquire(100);
+    EXPECT_EQ(256u, small.getBufferSize());
+    FastBuffer medium = pool.acquire(1000);
+    EXPECT_EQ(1024u, medium.getBufferSize());
+    FastBuffer exact = pool.acquire(4096);
+    EXPECT_EQ(4096u, exact.getBufferSize());
+
+    // Requests larger than the largest class are allocated directly and not kept.
+    FastBuffer large = pool.acquire(10000);
+    EXPECT_EQ(10000u, large.getBufferSize());
+    pool.release(large);
+    EXPECT_EQ(0u, pool.getRetainedBytes());
+
+    pool.release(small);
+    pool.release(medium);
+    pool.release(exact);
+    EXPECT_EQ(256u + 1024u + 4096u, pool.getRetainedBytes());
+    EXPECT_EQ(0u, small.getBufferSize());
+    EXPECT_TRUE(small.getBuffer() == nullptr);
+}
+
+TEST(BufferPoolTests, ReusesReleasedMemory)
+{
+    BufferPool pool(1024 * 1024, 4096, 1);
+
+    FastBuffer buffer = pool.acquire(300);
+    char* memory = buffer.getBuffer();
+    pool.release(buffer);
+
+    FastBuffer again = pool.acquire(512);
+    EXPECT_EQ(memory, again.getBuffer());
+    EXPECT_EQ(0u, pool.getRetainedBytes());
+
+    // Buffers that do not own their memory are not taken.
+    char external[64];
+    FastBuffer borrowed(external, sizeof(external));
+    pool.release(borrowed);
+    EXPECT_EQ(external, borrowed.getBuffer());
+    EXPECT_EQ(0u, pool.getRetainedBytes());
+
+    pool.release(again);
+}
+
+TEST(BufferPoolTests, BoundsRetainedMemory)
+{
+    BufferPool pool(4 * 1024, 4096, 1);
+    std::vector<FastBuffer> buffers(40);
+
+    for (FastBuffer& buffer : buffers)
+    {
+        buffer = pool.acquire(1024);
+    }
+
+    for (FastBuffer& buffer : buffers)
+    {
+        pool.release(buffer);
+    }
+
+    EXPECT_EQ(4u * 1024u, pool.getRetainedBytes());
+
+    for (FastBuffer& buffer : buffers)
+    {
+        buffer = pool.acquire(1024);
+    }
+
+    EXPECT_EQ(0u, pool.getRetainedBytes());
+
+    for (FastBuffer& buffer : buffers)
+    {
+        pool.release(buffer);
+    }
+}
+
+TEST(BufferPoolTests, KeepsGrownBuffers)
+{
+    BufferPool pool(1024 * 1024, 64 * 1024, 1);
+
+    FastBuffer buffer = pool.acquire(256);
+    Cdr cdr(buffer);
+    std::vector<uint32_t> values(1000, 7);
+    cdr << values;
+    ASSERT_GT(buffer.getBufferSize(), 4000u);
+
+    // The buffer grew, so it is kept in the largest class it fills.
+    size_t size = buffer.getBufferSize();
+    pool.release(buffer);
+    size_t retained = pool.getRetainedBytes();
+    EXPECT_LE(retained, size);
+    EXPECT_GT(2 * retained, size);
+
+    FastBuffer again = pool.acquire(retained);
+    EXPECT_EQ(0u, pool.getRetainedBytes());
+    Cdr reader(again);
+    reader << values;
+    reader.reset();
+
+    std::vector<uint32_t> read;
+    reader >> read;
+    EXPECT_EQ(values, read);
+    pool.release(again);
+}
+
+TEST(BufferPoolTests, ReleasedByOtherThreads)
+{
+    const size_t numThreads = 8;
+    const size_t numBuffers = 2000;
+    BufferPool pool(256 * 1024, 4096, 4);
+    std::vector<std::vector<FastBuffer>> handoff(numThreads);
+    std::atomic<size_t> ready(0);
+    std::vector<std::thread> threads;
+
+    for (size_t index = 0; index < numThreads; ++index)
+    {
+        threads.emplace_back([&, index]()
+                {
+                    // Each thread acquires buffers and writes its index in them.
+                    for (size_t count = 0; count < numBuffers; ++count)
+                    {
+                        FastBuffer buffer = pool.acquire(64 << (count % 6));
+                        memset(buffer.getBuffer(), static_cast<int>(index), buffer.getBufferSize());
+
+                        if (count % 2)
+                        {
+                            handoff[index].push_back(std::move(buffer));
+                        }
+                        else
+                        {
+                            pool.release(buffer);
+                        }
+                    }
+
+                    ready.fetch_add(1);
+
+                    while (ready.load() < numThreads)
+                    {
+                        std::this_thread::yield();
+                    }
+
+                    // Then releases the buffers of the next thread.
+                    for (FastBuffer& buffer : handoff[(index + 1) % numThreads])
+                    {
+                        for (size_t byte = 0; byte < buffer.getBufferSize(); ++byte)
+                        {
+                            ASSERT_EQ(static_cast<char>((index + 1) % numThreads), buffer.getBuffer()[byte]);
+                        }
+
+                        pool.release(buffer);
+                    }
+                });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_LE(pool.getRetainedBytes(), 256u * 1024u);
+}
+
+TEST(BufferPoolTests, SharedCache)
+{
+    // Both threads use the only cache, so one of them often finds it busy and goes to the depot.
+    BufferPool pool(1024 * 1024, 4096, 1);
+    std::vector<std::thread> threads;
+
+    for (size_t index = 0; index < 2; ++index)
+    {
+        threads.emplace_back([&]()
+                {
+                    for (size_t count = 0; count < 20000; ++count)
+                    {
+                        FastBuffer first = pool.acquire(1024);
+                        FastBuffer second = pool.acquire(1024);
+                        pool.release(first);
+                        pool.release(second);
+                    }
+                });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_GT(pool.getRetainedBytes(), 0u);
+    EXPECT_LE(pool.getRetainedBytes(), 1024u * 1024u);
+}
@@ -0,0 +1,207 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastcdr/CdrCursor.h>
+#include <fastcdr/exceptions/NotEnoughMemoryException.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <thread>
+
+using namespace eprosima::fastcdr;
+using namespace ::exception;
+
+struct Broadcast
+{
+    void serialize(
+            Cdr& cdr) const
+    {
+        cdr << sequence << source << values << tags << flag;
+    }
+
+    void deserialize(
+            Cdr& cdr)
+    {
+        cdr >> sequence >> source >> values >> tags >> flag;
+    }
+
+    bool operator ==(
+            const Broadcast& other) const
+    {
+        return (sequence == other.sequence) && (source == other.source) && (values == other.values) &&
+               (tags == other.tags) && (flag == other.flag);
+    }
+
+    uint64_t sequence = 0;
+    std::string source;
+    std::vector<double> values;
+    std::vector<std::string> tags;
+    bool flag = false;
+};
+
+static Broadcast make_broadcast()
+{
+    Broadcast broadcast;
+    broadcast.sequence = 0x0102030405060708;
+    broadcast.source = "sensor";
+    broadcast.values.resize(1000);
+
+    for (size_t index = 0; index < broadcast.values.size(); ++index)
+    {
+        broadcast.values[index] = static_cast<double>(index) / 3;
+    }
+
+    for (size_t index = 0; index < 20; ++index)
+    {
+        broadcast.tags.push_back(std::string(index, 't'));
+    }
+
+    broadcast.flag = true;
+    return broadcast;
+}
+
+// The opposite endianness, so the cursors have to swap the bytes.
+static const Cdr::Endianness swapped_endianness =
+        Cdr::DEFAULT_ENDIAN == Cdr::BIG_ENDIANNESS ? Cdr::LITTLE_ENDIANNESS : Cdr::BIG_ENDIANNESS;
+
+static std::vector<char> serialize_broadcast(
+        const Broadcast& broadcast)
+{
+    FastBuffer buffer;
+    Cdr cdr(buffer, swapped_endianness, Cdr::DDS_CDR);
+    cdr.serialize_encapsulation();
+    cdr << broadcast;
+    return std::vector<char>(buffer.getBuffer(), buffer.getBuffer() + cdr.getSerializedDataLength());
+}
+
+TEST(CdrCursorTests, ManyThreadsOnOneBuffer)
+{
+    const size_t numThreads = 8;
+    const size_t iterations = 200;
+    const Broadcast expected = make_broadcast();
+    const std::vector<char> bytes = serialize_broadcast(expected);
+    const std::vector<char> original = bytes;
+    std::atomic<size_t> matches(0);
+    std::vector<std::thread> threads;
+
+    for (size_t count = 0; count < numThreads; ++count)
+    {
+        threads.emplace_back([&]()
+                {
+                    for (size_t iteration = 0; iteration < iterations; ++iteration)
+                    {
+                        CdrCursor cursor(bytes.data(), bytes.size(), Cdr::DEFAULT_ENDIAN, Cdr::DDS_CDR);
+                        Broadcast broadcast;
+                        cursor.read_encapsulation() >> broadcast;
+
+                        if ((broadcast == expected) && (cursor.getPosition() == bytes.size()))
+                        {
+                            ++matches;
+                        }
+                    }
+                });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(numThreads * iterations, matches.load());
+    EXPECT_EQ(original, bytes);
+}
+
+TEST(CdrCursorTests, Copies)
+{
+    const Broadcast expected = make_broadcast();
+    std::vector<char> bytes = serialize_broadcast(expected);
+    FastBuffer buffer(bytes.data(), bytes.size());
+
+    // The header is read once, and each thread goes on from a copy of the cursor.
+    CdrCursor header(static_cast<const FastBuffer&>(buffer), Cdr::DEFAULT_ENDIAN, Cdr::DDS_CDR);
+    uint64_t sequence = 0;
+    header.read_encapsulation() >> sequence;
+    EXPECT_EQ(expected.sequence, sequence);
+    EXPECT_EQ(swapped_endianness, header.endianness());
+
+    std::vector<Broadcast> results(4);
+    std::vector<std::thread> threads;
+
+    for (size_t index = 0; index < results.size(); ++index)
+    {
+        threads.emplace_back([&, index]()
+                {
+                    CdrCursor cursor(header);
+                    results[index].sequence = sequence;
+                    cursor >> results[index].source >> results[index].values;
+                    cursor.deserialize(results[index].tags).deserialize(results[index].flag);
+                });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (const Broadcast& result : results)
+    {
+        EXPECT_EQ(expected, result);
+    }
+
+    // The copied cursor is independent from the original one.
+    std::string source;
+    header >> source;
+    EXPECT_EQ(expected.source, source);
+
+    // A state can be shared by cursors over the same bytes.
+    Cdr::state values = header.getState();
+    CdrCursor other(bytes.data(), bytes.size(), Cdr::DEFAULT_ENDIAN, Cdr::DDS_CDR);
+    other.read_encapsulation();
+    other.setState(values);
+    uint32_t length = 0;
+    std::vector<double> firstValues(10);
+    other >> length;
+    other.deserializeArray(firstValues.data(), firstValues.size());
+    EXPECT_EQ(expected.values.size(), length);
+    EXPECT_EQ(std::vector<double>(expected.values.begin(), expected.values.begin() + 10), firstValues);
+}
+
+TEST(CdrCursorTests, InPlaceAndErrors)
+{
+    std::vector<char> bytes = serialize_broadcast(make_broadcast());
+    CdrCursor cursor(bytes.data(), bytes.size(), Cdr::DEFAULT_ENDIAN, Cdr::DDS_CDR);
+    uint64_t sequence = 0;
+    uint32_t length = 0;
+    cursor.read_encapsulation() >> sequence >> length;
+
+    // The characters of the string are read in place.
+    EXPECT_EQ(0, strncmp("sensor", cursor.getCurrentPosition(), length));
+    EXPECT_EQ(bytes.data() + cursor.getPosition(), cursor.getCurrentPosition());
+    ASSERT_TRUE(cursor.jump(length));
+
+    EXPECT_FALSE(cursor.jump(bytes.size()));
+
+    Cdr::DeserializationLimits limits;
+    limits.maxSequenceElements = 100;
+    cursor.setDeserializationLimits(limits);
+    std::vector<double> values;
+    EXPECT_THROW(cursor >> values, BadParamException);
+
+    CdrCursor truncated(bytes.data(), bytes.size() / 2, Cdr::DEFAULT_ENDIAN, Cdr::DDS_CDR);
+    Broadcast broadcast;
+    EXPECT_THROW(truncated.read_encapsulation() >> broadcast, NotEnoughMemoryException);
+}
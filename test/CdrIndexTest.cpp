@@ -0,0 +1,183 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastcdr/CdrIndex.h>
+#include <fastcdr/exceptions/BadParamException.h>
+
+#include <gtest/gtest.h>
+
+using namespace eprosima::fastcdr;
+using namespace ::exception;
+
+struct LogEntry
+{
+    void serialize(
+            Cdr& cdr) const
+    {
+        cdr << flag << name << values << stamp;
+    }
+
+    void deserialize(
+            Cdr& cdr)
+    {
+        cdr >> flag >> name >> values >> stamp;
+    }
+
+    bool operator ==(
+            const LogEntry& other) const
+    {
+        return flag == other.flag && name == other.name && values == other.values && stamp == other.stamp;
+    }
+
+    uint8_t flag = 0;
+    std::string name;
+    std::vector<double> values;
+    uint64_t stamp = 0;
+};
+
+static TypeDescriptor log_entry_type()
+{
+    TypeDescriptor type = TypeDescriptor::structure();
+    type.addMember("flag", TypeDescriptor(TypeDescriptor::TK_OCTET))
+            .addMember("name", TypeDescriptor(TypeDescriptor::TK_STRING))
+            .addMember("values", TypeDescriptor::sequence(TypeDescriptor(TypeDescriptor::TK_DOUBLE)))
+            .addMember("stamp", TypeDescriptor(TypeDescriptor::TK_ULONGLONG));
+    return type;
+}
+
+static std::vector<LogEntry> make_log()
+{
+    std::vector<LogEntry> log(1000);
+
+    for (size_t count = 0; count < log.size(); ++count)
+    {
+        log[count].flag = static_cast<uint8_t>(count);
+        log[count].name = std::string(count % 13, 'n');
+        log[count].values.assign(count % 5, static_cast<double>(count));
+        log[count].stamp = count * 1000;
+    }
+
+    return log;
+}
+
+TEST(CdrIndexTests, SequenceOfStructures)
+{
+    std::vector<LogEntry> log = make_log();
+    FastBuffer cdrbuffer;
+    Cdr cdr_ser(cdrbuffer, Cdr::BIG_ENDIANNESS, Cdr::DDS_CDR);
+    cdr_ser.serialize_encapsulation();
+    cdr_ser << static_cast<uint8_t>(1) << log << static_cast<uint16_t>(2);
+
+    Cdr cdr_des(cdrbuffer, Cdr::DEFAULT_ENDIAN, Cdr::DDS_CDR);
+    cdr_des.read_encapsulation();
+    uint8_t header = 0;
+    cdr_des >> header;
+
+    CdrIndex index;
+    index.build(cdr_des, TypeDescriptor::sequence(log_entry_type()));
+    ASSERT_EQ(log.size(), index.size());
+
+    // The Cdr object is left after the sequence.
+    uint16_t trailer = 0;
+    cdr_des >> trailer;
+    EXPECT_EQ(2u, trailer);
+
+    for (size_t position : {999u, 0u, 500u, 13u, 998u, 1u})
+    {
+        LogEntry entry;
+        index.seek(cdr_des, position) >> entry;
+        EXPECT_EQ(log[position], entry);
+    }
+
+    EXPECT_THROW(index.seek(cdr_des, 1000), BadParamException);
+}
+
+TEST(CdrIndexTests, SequenceOfPrimitives)
+{
+    std::vector<uint16_t> values = {1, 2, 3, 4, 5};
+    FastBuffer cdrbuffer;
+    Cdr cdr_ser(cdrbuffer);
+    cdr_ser << static_cast<uint8_t>(1) << values << static_cast<uint8_t>(2);
+
+    Cdr cdr_des(cdrbuffer);
+    uint8_t header = 0;
+    cdr_des >> header;
+
+    CdrIndex index;
+    index.build(cdr_des, TypeDescriptor::sequence(TypeDescriptor(TypeDescriptor::TK_USHORT)));
+    ASSERT_EQ(values.size(), index.size());
+    EXPECT_EQ(8u, index.getOffset(0));
+    EXPECT_EQ(16u, index.getOffset(4));
+
+    uint8_t trailer = 0;
+    cdr_des >> trailer;
+    EXPECT_EQ(2u, trailer);
+
+    uint16_t value = 0;
+    index.seek(cdr_des, 3) >> value;
+    EXPECT_EQ(4u, value);
+}
+
+TEST(CdrIndexTests, Structure)
+{
+    LogEntry entry;
+    entry.flag = 7;
+    entry.name = "entry";
+    entry.values = {1.5, 2.5};
+    entry.stamp = 99;
+
+    FastBuffer cdrbuffer;
+    Cdr cdr_ser(cdrbuffer);
+    cdr_ser << entry;
+
+    Cdr cdr_des(cdrbuffer);
+    CdrIndex index;
+    index.build(cdr_des, log_entry_type());
+    ASSERT_EQ(4u, index.size());
+
+    uint64_t stamp = 0;
+    std::string name;
+    index.seek(cdr_des, 3) >> stamp;
+    index.seek(cdr_des, 1) >> name;
+    EXPECT_EQ(99u, stamp);
+    EXPECT_EQ("entry", name);
+}
+
+TEST(CdrIndexTests, Errors)
+{
+    std::vector<LogEntry> log = make_log();
+    FastBuffer cdrbuffer;
+    Cdr cdr_ser(cdrbuffer);
+    cdr_ser << log;
+
+    CdrIndex index;
+    Cdr cdr_des(cdrbuffer);
+    EXPECT_THROW(index.build(cdr_des, TypeDescriptor(TypeDescriptor::TK_LONG)), BadParamException);
+
+    FastBuffer truncated(cdrbuffer.getBuffer(), cdr_ser.getSerializedDataLength() / 2);
+    Cdr cdr_truncated(truncated);
+    EXPECT_THROW(index.build(cdr_truncated, TypeDescriptor::sequence(log_entry_type())), NotEnoughMemoryException);
+
+    // A corrupted length is rejected before any memory is reserved for it.
+    char corrupted[] = {'\xFF', '\xFF', '\xFF', '\xFF'};
+    FastBuffer corrupted_buffer(corrupted, sizeof(corrupted));
+    Cdr cdr_corrupted(corrupted_buffer);
+    EXPECT_THROW(index.build(cdr_corrupted, TypeDescriptor::sequence(log_entry_type())), NotEnoughMemoryException);
+
+    Cdr::DeserializationLimits limits;
+    limits.maxSequenceElements = 100;
+    Cdr cdr_limited(corrupted_buffer);
+    cdr_limited.setDeserializationLimits(limits);
+    EXPECT_THROW(index.build(cdr_limited, TypeDescriptor::sequence(log_entry_type())), BadParamException);
+}
@@ -0,0 +1,288 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastcdr/CdrPipeline.h>
+#include <fastcdr/Cdr.h>
+#include <fastcdr/exceptions/BadParamException.h>
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+using namespace eprosima::fastcdr;
+using namespace ::exception;
+
+struct Capture
+{
+    void serialize(
+            Cdr& cdr) const
+    {
+        cdr << id << samples << label;
+    }
+
+    void deserialize(
+            Cdr& cdr)
+    {
+        cdr >> id >> samples >> label;
+    }
+
+    uint32_t id = 0;
+    std::vector<uint8_t> samples;
+    std::string label;
+};
+
+static Capture make_capture(
+        uint32_t id)
+{
+    Capture capture;
+    capture.id = id;
+    capture.samples.resize(50000 + id);
+
+    // Long runs of the same value, so the run-length stage compresses them.
+    for (size_t index = 0; index < capture.samples.size(); ++index)
+    {
+        capture.samples[index] = static_cast<uint8_t>(index / 100);
+    }
+
+    capture.label = std::string(id % 50, 'c');
+    return capture;
+}
+
+// Stands in for a compressor: each chunk becomes pairs of a run length and a byte.
+class RunLengthStage : public PipelineStage
+{
+public:
+
+    void process(
+            std::vector<char>& chunk) override
+    {
+        m_output.clear();
+
+        for (size_t index = 0; index < chunk.size();)
+        {
+            size_t run = 1;
+
+            while ((index + run < chunk.size()) && (run < 255) && (chunk[index + run] == chunk[index]))
+            {
+                ++run;
+            }
+
+            m_output.push_back(static_cast<char>(run));
+            m_output.push_back(chunk[index]);
+            index += run;
+        }
+
+        chunk.swap(m_output);
+    }
+
+    static std::vector<char> decode(
+            const std::vector<char>& data)
+    {
+        std::vector<char> result;
+
+        for (size_t index = 0; index + 1 < data.size(); index += 2)
+        {
+            result.insert(result.end(), static_cast<uint8_t>(data[index]), data[index + 1]);
+        }
+
+        return result;
+    }
+
+private:
+
+    std::vector<char> m_output;
+};
+
+// Stands in for a cipher: the bytes are mixed with a key stream that depends on their position in the stream.
+class KeyStreamStage : public PipelineStage
+{
+public:
+
+    void process(
+            std::vector<char>& chunk) override
+    {
+        for (char& byte : chunk)
+        {
+            byte = static_cast<char>(byte ^ key(m_position++));
+        }
+    }
+
+    void finish(
+            std::vector<char>&) override
+    {
+        m_position = 0;
+    }
+
+    static char key(
+            size_t position)
+    {
+        return static_cast<char>((position * 131 + 7) >> 3);
+    }
+
+    static void apply(
+            std::vector<char>& data)
+    {
+        for (size_t position = 0; position < data.size(); ++position)
+        {
+            data[position] = static_cast<char>(data[position] ^ key(position));
+        }
+    }
+
+private:
+
+    size_t m_position = 0;
+};
+
+// Fails on the chunk that holds a given byte of the stream.
+class FailingStage : public PipelineStage
+{
+public:
+
+    void process(
+            std::vector<char>& chunk) override
+    {
+        m_position += chunk.size();
+
+        if (m_position > 10000)
+        {
+            throw BadParamException("Invalid chunk");
+        }
+    }
+
+    void finish(
+            std::vector<char>&) override
+    {
+        m_position = 0;
+    }
+
+private:
+
+    size_t m_position = 0;
+};
+
+static void serialize_capture(
+        const Capture& capture,
+        CdrPipeline& pipeline,
+        size_t windowSize)
+{
+    std::vector<char> window(windowSize);
+    FastBuffer buffer(window.data(), window.size());
+    Cdr cdr(buffer, Cdr::DEFAULT_ENDIAN, Cdr::DDS_CDR);
+    cdr.setSink(&pipeline);
+    cdr.serialize_encapsulation();
+    cdr << capture;
+    ASSERT_TRUE(cdr.flush());
+}
+
+static void expect_capture(
+        const Capture& expected,
+        std::vector<char> data)
+{
+    FastBuffer buffer(data.data(), data.size());
+    Cdr cdr(buffer, Cdr::DEFAULT_ENDIAN, Cdr::DDS_CDR);
+    cdr.read_encapsulation();
+    Capture capture;
+    cdr >> capture;
+    EXPECT_EQ(expected.id, capture.id);
+    EXPECT_EQ(expected.samples, capture.samples);
+    EXPECT_EQ(expected.label, capture.label);
+    EXPECT_EQ(data.size(), cdr.getSerializedDataLength());
+}
+
+TEST(CdrPipelineTests, Crc32)
+{
+    const char check[] = "123456789";
+    EXPECT_EQ(0xCBF43926u, Crc32Stage::compute(check, 9));
+    EXPECT_EQ(0xCBF43926u, Crc32Stage::compute(check + 4, 5, Crc32Stage::compute(check, 4)));
+    EXPECT_EQ(0u, Crc32Stage::compute(check, 0));
+}
+
+TEST(CdrPipelineTests, StagesInOrder)
+{
+    Crc32Stage checksum(true);
+    RunLengthStage compression;
+    KeyStreamStage cipher;
+    std::vector<char> output;
+    CallbackSink sink([&output](const char* data, size_t size)
+            {
+                output.insert(output.end(), data, data + size);
+                return true;
+            });
+    CdrPipeline pipeline({&checksum, &compression, &cipher}, sink, 3);
+
+    // The pipeline is used for several streams, with windows that do not divide the elements.
+    for (uint32_t id = 0; id < 3; ++id)
+    {
+        Capture capture = make_capture(id * 17);
+        output.clear();
+        serialize_capture(capture, pipeline, 1000 + id * 333);
+        ASSERT_TRUE(pipeline.finish());
+
+        KeyStreamStage::apply(output);
+        std::vector<char> data = RunLengthStage::decode(output);
+        ASSERT_GE(data.size(), 4u);
+        EXPECT_LT(output.size(), data.size() / 4);
+
+        // The checksum follows the stream, and was compressed and ciphered with it.
+        uint32_t crc = Crc32Stage::compute(data.data(), data.size() - 4);
+        EXPECT_EQ(crc, checksum.getChecksum());
+        EXPECT_EQ(static_cast<char>(crc >> 24), data[data.size() - 4]);
+        EXPECT_EQ(static_cast<char>(crc), data[data.size() - 1]);
+
+        data.resize(data.size() - 4);
+        expect_capture(capture, data);
+    }
+}
+
+TEST(CdrPipelineTests, Errors)
+{
+    FailingStage failing;
+    Crc32Stage checksum;
+    bool sinkFails = false;
+    std::vector<char> output;
+    CallbackSink sink([&](const char* data, size_t size)
+            {
+                output.insert(output.end(), data, data + size);
+                return !sinkFails;
+            });
+    CdrPipeline pipeline({&checksum, &failing}, sink, 2);
+
+    // Once a stage fails, the serialization cannot flush more windows, and finishing the stream throws.
+    {
+        std::vector<char> window(512);
+        FastBuffer buffer(window.data(), window.size());
+        Cdr cdr(buffer);
+        cdr.setSink(&pipeline);
+        EXPECT_THROW(
+            for (uint32_t value = 0; value < 100000; ++value)
+            {
+                cdr << value;
+            }, NotEnoughMemoryException);
+        EXPECT_THROW(pipeline.finish(), BadParamException);
+    }
+
+    // A failing sink.
+    std::vector<char> small(5000, 'x');
+    sinkFails = true;
+    EXPECT_TRUE(pipeline.write(small.data(), small.size()));
+    EXPECT_FALSE(pipeline.finish());
+
+    // The pipeline is usable again after a failed stream.
+    sinkFails = false;
+    output.clear();
+    EXPECT_TRUE(pipeline.write(small.data(), small.size()));
+    EXPECT_TRUE(pipeline.finish());
+    EXPECT_EQ(small, output);
+    EXPECT_EQ(Crc32Stage::compute(small.data(), small.size()), checksum.getChecksum());
+}
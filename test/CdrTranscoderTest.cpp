@@ -0,0 +1,260 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastcdr/CdrTranscoder.h>
+#include <fastcdr/exceptions/BadParamException.h>
+
+#include <gtest/gtest.h>
+
+using namespace eprosima::fastcdr;
+using namespace ::exception;
+
+// Serialized the same way by Cdr and FastCdr.
+struct Reading
+{
+    template<class _Cdr>
+    void serialize(
+            _Cdr& cdr) const
+    {
+        cdr << flag << id << name << samples << counts << shorts << total << label << empty;
+    }
+
+    template<class _Cdr>
+    void deserialize(
+            _Cdr& cdr)
+    {
+        cdr >> flag >> id >> name >> samples >> counts >> shorts >> total >> label >> empty;
+    }
+
+    bool operator ==(
+            const Reading& other) const
+    {
+        return flag == other.flag && id == other.id && name == other.name && samples == other.samples &&
+               counts == other.counts && shorts == other.shorts && total == other.total && label == other.label &&
+               empty == other.empty;
+    }
+
+    bool flag = true;
+    int32_t id = -42;
+    std::string name = "sensor";
+    std::vector<double> samples = {1.5, -2.25, 1e10};
+    std::vector<std::string> counts = {"a", "", "ccc"};
+    std::array<int16_t, 5> shorts = {{1, -2, 3, -4, 5}};
+    uint64_t total = 0x0102030405060708ull;
+    std::wstring label = L"wide";
+    std::vector<float> empty;
+};
+
+static TypeDescriptor reading_type()
+{
+    TypeDescriptor type = TypeDescriptor::structure();
+    type.addMember("flag", TypeDescriptor(TypeDescriptor::TK_BOOLEAN))
+            .addMember("id", TypeDescriptor(TypeDescriptor::TK_LONG))
+            .addMember("name", TypeDescriptor(TypeDescriptor::TK_STRING))
+            .addMember("samples", TypeDescriptor::sequence(TypeDescriptor(TypeDescriptor::TK_DOUBLE)))
+            .addMember("counts", TypeDescriptor::sequence(TypeDescriptor(TypeDescriptor::TK_STRING)))
+            .addMember("shorts", TypeDescriptor::array(TypeDescriptor(TypeDescriptor::TK_SHORT), 5))
+            .addMember("total", TypeDescriptor(TypeDescriptor::TK_ULONGLONG))
+            .addMember("label", TypeDescriptor(TypeDescriptor::TK_WSTRING))
+            .addMember("empty", TypeDescriptor::sequence(TypeDescriptor(TypeDescriptor::TK_FLOAT)));
+    return type;
+}
+
+static size_t serialize_reading(
+        std::vector<char>& buffer,
+        const std::vector<Reading>& readings,
+        Cdr::Endianness endianness,
+        Cdr::CdrType cdrType)
+{
+    buffer.assign(4096, 0);
+    FastBuffer cdrbuffer(buffer.data(), buffer.size());
+    Cdr cdr(cdrbuffer, endianness, cdrType);
+
+    if (cdrType == Cdr::DDS_CDR)
+    {
+        cdr.serialize_encapsulation();
+    }
+
+    cdr << readings;
+    return cdr.getSerializedDataLength();
+}
+
+TEST(CdrTranscoderTests, InPlace)
+{
+    std::vector<Reading> readings(3);
+    readings[1].samples.clear();
+    readings[2].name = "other";
+    TypeDescriptor type = TypeDescriptor::sequence(reading_type());
+
+    std::vector<char> big;
+    std::vector<char> little;
+    size_t length = serialize_reading(big, readings, Cdr::BIG_ENDIANNESS, Cdr::DDS_CDR);
+    ASSERT_EQ(length, serialize_reading(little, readings, Cdr::LITTLE_ENDIANNESS, Cdr::DDS_CDR));
+
+    EXPECT_EQ(length, CdrTranscoder::swapEndianness(big.data(), big.size(), type));
+    EXPECT_EQ(little, big);
+
+    // And back.
+    EXPECT_EQ(length, CdrTranscoder::swapEndianness(big.data(), big.size(), type));
+    FastBuffer cdrbuffer(big.data(), big.size());
+    Cdr cdr(cdrbuffer, Cdr::LITTLE_ENDIANNESS, Cdr::DDS_CDR);
+    cdr.read_encapsulation();
+    EXPECT_EQ(Cdr::BIG_ENDIANNESS, cdr.endianness());
+
+    std::vector<Reading> result;
+    cdr >> result;
+    EXPECT_EQ(readings, result);
+}
+
+TEST(CdrTranscoderTests, IntoOutputBuffer)
+{
+    std::vector<Reading> readings(2);
+    TypeDescriptor type = TypeDescriptor::sequence(reading_type());
+
+    std::vector<char> source;
+    std::vector<char> expected;
+    size_t length = serialize_reading(source, readings, Cdr::LITTLE_ENDIANNESS, Cdr::CORBA_CDR);
+    serialize_reading(expected, readings, Cdr::BIG_ENDIANNESS, Cdr::CORBA_CDR);
+    std::vector<char> original = source;
+
+    std::vector<char> destination(source.size());
+    EXPECT_EQ(length, CdrTranscoder::swapEndianness(source.data(), destination.data(), source.size(), type,
+            Cdr::LITTLE_ENDIANNESS, Cdr::CORBA_CDR));
+    EXPECT_EQ(expected, destination);
+    EXPECT_EQ(original, source);
+}
+
+TEST(CdrTranscoderTests, LongDouble)
+{
+    // The unused bytes of a long double are not defined, so the value is compared instead of the bytes.
+    std::vector<char> buffer(64, 0);
+    FastBuffer cdrbuffer(buffer.data(), buffer.size());
+    Cdr cdr_ser(cdrbuffer, Cdr::BIG_ENDIANNESS, Cdr::CORBA_CDR);
+    cdr_ser << static_cast<uint8_t>(1) << 3.25L;
+
+    TypeDescriptor type = TypeDescriptor::structure();
+    type.addMember("flag", TypeDescriptor(TypeDescriptor::TK_OCTET))
+            .addMember("value", TypeDescriptor(TypeDescriptor::TK_LONGDOUBLE));
+    EXPECT_EQ(24u, CdrTranscoder::swapEndianness(buffer.data(), buffer.size(), type, Cdr::BIG_ENDIANNESS,
+            Cdr::CORBA_CDR));
+
+    Cdr cdr_des(cdrbuffer, Cdr::LITTLE_ENDIANNESS, Cdr::CORBA_CDR);
+    uint8_t flag = 0;
+    long double value = 0;
+    cdr_des >> flag >> value;
+    EXPECT_EQ(3.25L, value);
+}
+
+TEST(CdrTranscoderTests, FastCdrToCdr)
+{
+    std::vector<Reading> readings(3);
+    readings[0].samples.assign(1000, 0.25);
+    readings[2].label.clear();
+    TypeDescriptor type = TypeDescriptor::sequence(reading_type());
+
+    std::vector<char> fast(16384, 0);
+    FastBuffer fastbuffer(fast.data(), fast.size());
+    FastCdr fast_ser(fastbuffer);
+    fast_ser << readings;
+
+    for (Cdr::Endianness endianness : {Cdr::BIG_ENDIANNESS, Cdr::LITTLE_ENDIANNESS})
+    {
+        std::vector<char> expected(32768, 0);
+        FastBuffer expectedbuffer(expected.data(), expected.size());
+        Cdr cdr_expected(expectedbuffer, endianness, Cdr::DDS_CDR);
+        cdr_expected.serialize_encapsulation();
+        cdr_expected << readings;
+
+        std::vector<char> output(32768, 0);
+        FastBuffer outputbuffer(output.data(), output.size());
+        Cdr cdr_output(outputbuffer, endianness, Cdr::DDS_CDR);
+        cdr_output.serialize_encapsulation();
+
+        FastCdr fast_des(fastbuffer);
+        CdrTranscoder::toCdr(fast_des, cdr_output, type);
+        EXPECT_EQ(fast_ser.getSerializedDataLength(), fast_des.getSerializedDataLength());
+        EXPECT_EQ(cdr_expected.getSerializedDataLength(), cdr_output.getSerializedDataLength());
+        EXPECT_EQ(expected, output);
+
+        // And back.
+        std::vector<char> back(16384, 0);
+        FastBuffer backbuffer(back.data(), back.size());
+        FastCdr fast_back(backbuffer);
+        Cdr cdr_des(outputbuffer, Cdr::DEFAULT_ENDIAN, Cdr::DDS_CDR);
+        cdr_des.read_encapsulation();
+        CdrTranscoder::toFastCdr(cdr_des, fast_back, type);
+        EXPECT_EQ(cdr_output.getSerializedDataLength(), cdr_des.getSerializedDataLength());
+        EXPECT_EQ(fast, back);
+    }
+}
+
+TEST(CdrTranscoderTests, FastCdrToGrowingCdr)
+{
+    std::vector<int32_t> values(10000);
+
+    for (size_t count = 0; count < values.size(); ++count)
+    {
+        values[count] = static_cast<int32_t>(count);
+    }
+
+    FastBuffer fastbuffer;
+    FastCdr fast_ser(fastbuffer);
+    fast_ser << static_cast<uint8_t>(7) << values;
+
+    TypeDescriptor type = TypeDescriptor::structure();
+    type.addMember("flag", TypeDescriptor(TypeDescriptor::TK_OCTET))
+            .addMember("values", TypeDescriptor::sequence(TypeDescriptor(TypeDescriptor::TK_LONG)));
+
+    FastBuffer cdrbuffer;
+    Cdr cdr_output(cdrbuffer, Cdr::BIG_ENDIANNESS, Cdr::CORBA_CDR);
+    FastCdr fast_des(fastbuffer);
+    CdrTranscoder::toCdr(fast_des, cdr_output, type);
+
+    Cdr cdr_des(cdrbuffer, Cdr::BIG_ENDIANNESS, Cdr::CORBA_CDR);
+    uint8_t flag = 0;
+    std::vector<int32_t> result;
+    cdr_des >> flag >> result;
+    EXPECT_EQ(7u, flag);
+    EXPECT_EQ(values, result);
+}
+
+TEST(CdrTranscoderTests, Errors)
+{
+    std::vector<Reading> readings(2);
+    TypeDescriptor type = TypeDescriptor::sequence(reading_type());
+
+    std::vector<char> buffer;
+    size_t length = serialize_reading(buffer, readings, Cdr::BIG_ENDIANNESS, Cdr::DDS_CDR);
+    EXPECT_THROW(CdrTranscoder::swapEndianness(buffer.data(), length - 1, type), NotEnoughMemoryException);
+
+    buffer[0] = 1;
+    EXPECT_THROW(CdrTranscoder::swapEndianness(buffer.data(), length, type), BadParamException);
+
+    std::vector<char> fast(4096, 0);
+    FastBuffer fastbuffer(fast.data(), fast.size());
+    FastCdr fast_ser(fastbuffer);
+    fast_ser << readings;
+
+    FastBuffer truncated(fast.data(), fast_ser.getSerializedDataLength() - 1);
+    FastCdr fast_des(truncated);
+    FastBuffer cdrbuffer;
+    Cdr cdr_output(cdrbuffer);
+    EXPECT_THROW(CdrTranscoder::toCdr(fast_des, cdr_output, type), NotEnoughMemoryException);
+
+    char small[16];
+    FastBuffer smallbuffer(small, sizeof(small));
+    Cdr cdr_small(smallbuffer);
+    FastCdr fast_again(fastbuffer);
+    EXPECT_THROW(CdrTranscoder::toCdr(fast_again, cdr_small, type), NotEnoughMemoryException);
+}
@@ -0,0 +1,170 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastcdr/CdrView.h>
+#include <fastcdr/exceptions/BadParamException.h>
+
+#include <gtest/gtest.h>
+
+using namespace eprosima::fastcdr;
+using namespace ::exception;
+
+static TypeDescriptor message_type()
+{
+    TypeDescriptor nested = TypeDescriptor::structure();
+    nested.addMember("a", TypeDescriptor(TypeDescriptor::TK_USHORT))
+            .addMember("s", TypeDescriptor(TypeDescriptor::TK_STRING));
+
+    TypeDescriptor type = TypeDescriptor::structure();
+    type.addMember("flag", TypeDescriptor(TypeDescriptor::TK_OCTET))
+            .addMember("name", TypeDescriptor(TypeDescriptor::TK_STRING))
+            .addMember("value", TypeDescriptor(TypeDescriptor::TK_DOUBLE))
+            .addMember("samples", TypeDescriptor::sequence(TypeDescriptor(TypeDescriptor::TK_SHORT)))
+            .addMember("empty", TypeDescriptor::sequence(TypeDescriptor(TypeDescriptor::TK_DOUBLE)))
+            .addMember("nested", TypeDescriptor::array(nested, 2))
+            .addMember("wname", TypeDescriptor(TypeDescriptor::TK_WSTRING))
+            .addMember("tags", TypeDescriptor::sequence(TypeDescriptor(TypeDescriptor::TK_STRING)))
+            .addMember("id", TypeDescriptor(TypeDescriptor::TK_LONG))
+            .addMember("precise", TypeDescriptor(TypeDescriptor::TK_LONGDOUBLE))
+            .addMember("letter", TypeDescriptor(TypeDescriptor::TK_CHAR))
+            .addMember("last", TypeDescriptor(TypeDescriptor::TK_LONGLONG));
+    return type;
+}
+
+static void serialize_message(
+        Cdr& cdr)
+{
+    std::vector<int16_t> samples = {1, -2, 3};
+    std::vector<double> empty;
+    std::vector<std::string> tags = {"a", "bcd", ""};
+
+    cdr << static_cast<uint8_t>(7) << std::string("view") << 3.5 << samples << empty;
+    cdr << static_cast<uint16_t>(11) << std::string("first") << static_cast<uint16_t>(12) << std::string("second");
+    int32_t id = -42;
+    int64_t last = 0x0102030405060708;
+    cdr << std::wstring(L"wide") << tags << id << 2.25L << 'x' << last;
+}
+
+static void check_message(
+        FastBuffer& cdrbuffer,
+        Cdr::Endianness endianness)
+{
+    CdrView view(cdrbuffer, message_type(), endianness);
+
+    // Members are read out of order, so that some are located from the cache and some by skipping.
+    EXPECT_EQ(-42, view.get<int32_t>("id"));
+    EXPECT_EQ(3.5, view.get<double>(2));
+    EXPECT_EQ(7u, view.get<uint8_t>("flag"));
+    EXPECT_EQ(0x0102030405060708, view.get<int64_t>("last"));
+    EXPECT_EQ('x', view.get<char>("letter"));
+    EXPECT_EQ(2.25L, view.get<long double>("precise"));
+
+    CdrView::StringView name = view.getString("name");
+    EXPECT_EQ(std::string("view"), name.str());
+    EXPECT_GE(name.data(), cdrbuffer.getBuffer());
+    EXPECT_LT(name.data(), cdrbuffer.getBuffer() + cdrbuffer.getBufferSize());
+
+    std::vector<std::string> tags;
+    view.seek(7) >> tags;
+    EXPECT_EQ((std::vector<std::string>{"a", "bcd", ""}), tags);
+
+    std::vector<int16_t> samples;
+    view.seek(3) >> samples;
+    EXPECT_EQ((std::vector<int16_t>{1, -2, 3}), samples);
+
+    std::wstring wname;
+    view.seek(6) >> wname;
+    EXPECT_EQ(std::wstring(L"wide"), wname);
+}
+
+TEST(CdrViewTests, OutOfOrderAccess)
+{
+    char buffer[256] = {0};
+    FastBuffer cdrbuffer(buffer, sizeof(buffer));
+    Cdr cdr_ser(cdrbuffer);
+    serialize_message(cdr_ser);
+
+    check_message(cdrbuffer, Cdr::DEFAULT_ENDIAN);
+}
+
+TEST(CdrViewTests, OutOfOrderAccessOtherEndianness)
+{
+    Cdr::Endianness endianness = Cdr::DEFAULT_ENDIAN == Cdr::BIG_ENDIANNESS ?
+            Cdr::LITTLE_ENDIANNESS : Cdr::BIG_ENDIANNESS;
+    char buffer[256] = {0};
+    FastBuffer cdrbuffer(buffer, sizeof(buffer));
+    Cdr cdr_ser(cdrbuffer, endianness);
+    serialize_message(cdr_ser);
+
+    check_message(cdrbuffer, endianness);
+}
+
+TEST(CdrViewTests, Encapsulation)
+{
+    char buffer[256] = {0};
+    FastBuffer cdrbuffer(buffer, sizeof(buffer));
+    Cdr cdr_ser(cdrbuffer, Cdr::BIG_ENDIANNESS, Cdr::DDS_CDR);
+    cdr_ser.serialize_encapsulation();
+    serialize_message(cdr_ser);
+
+    CdrView view(cdrbuffer, message_type(), Cdr::DEFAULT_ENDIAN, Cdr::DDS_CDR);
+    view.read_encapsulation();
+    EXPECT_EQ(-42, view.get<int32_t>("id"));
+    EXPECT_EQ(std::string("view"), view.getString(1).str());
+}
+
+TEST(CdrViewTests, WrongAccess)
+{
+    char buffer[256] = {0};
+    FastBuffer cdrbuffer(buffer, sizeof(buffer));
+    Cdr cdr_ser(cdrbuffer);
+    serialize_message(cdr_ser);
+
+    CdrView view(cdrbuffer, message_type());
+    EXPECT_THROW(view.get<int64_t>("id"), BadParamException);
+    // Members of the requested size but of another kind.
+    EXPECT_THROW(view.get<uint32_t>("id"), BadParamException);
+    EXPECT_THROW(view.get<float>("id"), BadParamException);
+    EXPECT_THROW(view.get<int64_t>("value"), BadParamException);
+    EXPECT_THROW(view.get<char>("flag"), BadParamException);
+    EXPECT_THROW(view.get<int32_t>("samples"), BadParamException);
+    EXPECT_THROW(view.get<int32_t>("missing"), BadParamException);
+    EXPECT_THROW(view.get<int32_t>(12), BadParamException);
+    EXPECT_THROW(view.getString("wname"), BadParamException);
+    EXPECT_THROW(view.seek(12), BadParamException);
+    EXPECT_THROW(CdrView(cdrbuffer, TypeDescriptor(TypeDescriptor::TK_LONG)), BadParamException);
+    EXPECT_THROW(TypeDescriptor(TypeDescriptor::TK_STRUCTURE), BadParamException);
+}
+
+TEST(CdrViewTests, TruncatedBuffer)
+{
+    char buffer[256] = {0};
+    FastBuffer cdrbuffer(buffer, sizeof(buffer));
+    Cdr cdr_ser(cdrbuffer);
+    serialize_message(cdr_ser);
+
+    // The view only sees the beginning of the message, up to the middle of the nested array.
+    FastBuffer truncated(buffer, 48);
+    CdrView view(truncated, message_type());
+    EXPECT_EQ(3.5, view.get<double>("value"));
+    EXPECT_THROW(view.get<int32_t>("id"), NotEnoughMemoryException);
+    EXPECT_EQ(7u, view.get<uint8_t>("flag"));
+
+    // A corrupted sequence length cannot make the view skip outside the buffer.
+    FastBuffer corrupted_buffer(buffer, sizeof(buffer));
+    Cdr cdr_corrupt(corrupted_buffer);
+    cdr_corrupt << static_cast<uint8_t>(7) << std::string("view") << 3.5 << 0xFFFFFFFFu;
+    CdrView corrupted(corrupted_buffer, message_type());
+    EXPECT_THROW(corrupted.get<int32_t>("id"), NotEnoughMemoryException);
+}
@@ -0,0 +1,173 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastcdr/Cdr.h>
+#include <fastcdr/FastCdr.h>
+
+#include <gtest/gtest.h>
+
+using namespace eprosima::fastcdr;
+using namespace ::exception;
+
+static const std::map<int32_t, std::string> map_value = {
+    {1, "one"}, {2, "two"}, {3, "three"}, {5, "five"}
+};
+
+template<class _Cdr>
+static void check_containers()
+{
+    char buffer[1024] = {0};
+    FastBuffer cdrbuffer(buffer, sizeof(buffer));
+
+    std::unordered_map<int32_t, std::string> unordered_map_value(map_value.begin(), map_value.end());
+    std::set<uint16_t> set_value = {7, 3, 11};
+    std::unordered_set<std::string> unordered_set_value = {"a", "bb", "ccc"};
+    std::deque<double> deque_value = {1.5, 2.5, 3.5};
+    std::vector<std::pair<int32_t, std::string>> flat_map_value(map_value.begin(), map_value.end());
+
+    _Cdr cdr_ser(cdrbuffer);
+    cdr_ser << unordered_map_value << set_value << unordered_set_value << deque_value << flat_map_value;
+
+    std::unordered_map<int32_t, std::string> unordered_map_result = {{9, "stale"}};
+    std::set<uint16_t> set_result = {1};
+    std::unordered_set<std::string> unordered_set_result = {"stale"};
+    std::deque<double> deque_result = {9.5, 9.5, 9.5, 9.5};
+    std::vector<std::pair<int32_t, std::string>> flat_map_result;
+
+    _Cdr cdr_des(cdrbuffer);
+    cdr_des >> unordered_map_result >> set_result >> unordered_set_result >> deque_result >> flat_map_result;
+
+    EXPECT_EQ(unordered_map_value, unordered_map_result);
+    EXPECT_EQ(set_value, set_result);
+    EXPECT_EQ(unordered_set_value, unordered_set_result);
+    EXPECT_EQ(deque_value, deque_result);
+    EXPECT_EQ(flat_map_value, flat_map_result);
+    EXPECT_EQ(cdr_ser.getSerializedDataLength(), cdr_des.getSerializedDataLength());
+}
+
+template<class _Cdr>
+static void check_flat_map_wire_compatible()
+{
+    char map_buffer[256] = {0};
+    char flat_buffer[256] = {0};
+    FastBuffer map_cdrbuffer(map_buffer, sizeof(map_buffer));
+    FastBuffer flat_cdrbuffer(flat_buffer, sizeof(flat_buffer));
+    std::vector<std::pair<int32_t, std::string>> flat_map_value(map_value.begin(), map_value.end());
+
+    _Cdr map_ser(map_cdrbuffer);
+    map_ser << map_value;
+    _Cdr flat_ser(flat_cdrbuffer);
+    flat_ser << flat_map_value;
+
+    ASSERT_EQ(map_ser.getSerializedDataLength(), flat_ser.getSerializedDataLength());
+    EXPECT_EQ(0, memcmp(map_buffer, flat_buffer, map_ser.getSerializedDataLength()));
+
+    std::map<int32_t, std::string> map_result;
+    _Cdr map_des(flat_cdrbuffer);
+    map_des >> map_result;
+    EXPECT_EQ(map_value, map_result);
+}
+
+template<class _Cdr>
+static void check_map_replaces_contents()
+{
+    char buffer[512] = {0};
+    FastBuffer cdrbuffer(buffer, sizeof(buffer));
+
+    std::vector<std::pair<int32_t, std::string>> unsorted_value = {
+        {4, "four"}, {2, "two"}, {6, "six"}, {2, "again"}
+    };
+
+    _Cdr cdr_ser(cdrbuffer);
+    cdr_ser << map_value << unsorted_value;
+
+    // Stale keys are removed and entries received again keep their node.
+    std::map<int32_t, std::string> map_result = {{0, "zero"}, {2, "stale"}, {4, "four"}, {9, "nine"}};
+    const std::string* reused_value = &map_result[2];
+    std::map<int32_t, std::string> unsorted_result = {{1, "one"}, {6, "stale"}};
+
+    _Cdr cdr_des(cdrbuffer);
+    cdr_des >> map_result >> unsorted_result;
+
+    EXPECT_EQ(map_value, map_result);
+    EXPECT_EQ(reused_value, &map_result[2]);
+
+    std::map<int32_t, std::string> unsorted_expected = {{2, "again"}, {4, "four"}, {6, "six"}};
+    EXPECT_EQ(unsorted_expected, unsorted_result);
+    EXPECT_EQ(cdr_ser.getSerializedDataLength(), cdr_des.getSerializedDataLength());
+}
+
+template<class _Cdr>
+static void check_not_enough_memory()
+{
+    // Length announces more elements than bytes remaining in the buffer.
+    char buffer[8] = {0};
+    FastBuffer cdrbuffer(buffer, sizeof(buffer));
+    _Cdr cdr_ser(cdrbuffer);
+    cdr_ser << static_cast<uint32_t>(1000);
+
+    std::unordered_map<int32_t, int32_t> unordered_map_result;
+    std::set<int32_t> set_result;
+    std::unordered_set<int32_t> unordered_set_result;
+    std::deque<int32_t> deque_result;
+    std::map<int32_t, int32_t> map_result;
+
+    _Cdr cdr_des(cdrbuffer);
+    EXPECT_THROW(cdr_des >> unordered_map_result, NotEnoughMemoryException);
+    EXPECT_THROW(cdr_des >> set_result, NotEnoughMemoryException);
+    EXPECT_THROW(cdr_des >> unordered_set_result, NotEnoughMemoryException);
+    EXPECT_THROW(cdr_des >> deque_result, NotEnoughMemoryException);
+    EXPECT_THROW(cdr_des >> map_result, NotEnoughMemoryException);
+    EXPECT_EQ(0u, cdr_des.getSerializedDataLength());
+}
+
+TEST(CDRContainersTests, Containers)
+{
+    check_containers<Cdr>();
+}
+
+TEST(CDRContainersTests, FlatMapWireCompatible)
+{
+    check_flat_map_wire_compatible<Cdr>();
+}
+
+TEST(CDRContainersTests, MapReplacesContents)
+{
+    check_map_replaces_contents<Cdr>();
+}
+
+TEST(CDRContainersTests, NotEnoughMemory)
+{
+    check_not_enough_memory<Cdr>();
+}
+
+TEST(FastCDRContainersTests, Containers)
+{
+    check_containers<FastCdr>();
+}
+
+TEST(FastCDRContainersTests, FlatMapWireCompatible)
+{
+    check_flat_map_wire_compatible<FastCdr>();
+}
+
+TEST(FastCDRContainersTests, MapReplacesContents)
+{
+    check_map_replaces_contents<FastCdr>();
+}
+
+TEST(FastCDRContainersTests, NotEnoughMemory)
+{
+    check_not_enough_memory<FastCdr>();
+}
@@ -0,0 +1,161 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastcdr/Cdr.h>
+#include <fastcdr/exceptions/BadParamException.h>
+
+#include <gtest/gtest.h>
+
+using namespace eprosima::fastcdr;
+using namespace ::exception;
+
+static const Cdr::Endianness other_endianness =
+        Cdr::DEFAULT_ENDIAN == Cdr::BIG_ENDIANNESS ? Cdr::LITTLE_ENDIANNESS : Cdr::BIG_ENDIANNESS;
+
+static void serialize_prefix(
+        Cdr& cdr,
+        size_t prefix)
+{
+    for (size_t count = 0; count < prefix; ++count)
+    {
+        cdr << static_cast<uint8_t>(count);
+    }
+}
+
+static void check_same_bytes(
+        Cdr::Endianness endianness)
+{
+    for (size_t prefix = 0; prefix < 8; ++prefix)
+    {
+        char expected_buffer[64] = {0};
+        char fields_buffer[64] = {0};
+
+        FastBuffer expected_fastbuffer(expected_buffer, sizeof(expected_buffer));
+        Cdr expected(expected_fastbuffer, endianness);
+        serialize_prefix(expected, prefix);
+        expected << static_cast<uint8_t>(1) << -2 << static_cast<uint16_t>(3) <<
+            4.5 << true << static_cast<int64_t>(-6) << 'c' << 7.5f;
+        expected << static_cast<int16_t>(8);
+
+        FastBuffer fields_fastbuffer(fields_buffer, sizeof(fields_buffer));
+        Cdr fields(fields_fastbuffer, endianness);
+        serialize_prefix(fields, prefix);
+        fields.serialize_fields(static_cast<uint8_t>(1), -2, static_cast<uint16_t>(3),
+                4.5, true, static_cast<int64_t>(-6), 'c', 7.5f);
+        fields << static_cast<int16_t>(8);
+
+        ASSERT_EQ(expected.getSerializedDataLength(), fields.getSerializedDataLength());
+        EXPECT_EQ(0, memcmp(expected_buffer, fields_buffer, expected.getSerializedDataLength()));
+
+        Cdr reader(fields_fastbuffer, endianness);
+        uint8_t prefix_value = 0;
+        for (size_t count = 0; count < prefix; ++count)
+        {
+            reader >> prefix_value;
+        }
+
+        uint8_t octet_value = 0;
+        int32_t long_value = 0;
+        uint16_t ushort_value = 0;
+        double double_value = 0;
+        bool bool_value = false;
+        int64_t longlong_value = 0;
+        char char_value = 0;
+        float float_value = 0;
+        int16_t short_value = 0;
+        reader.deserialize_fields(octet_value, long_value, ushort_value, double_value, bool_value,
+                longlong_value, char_value, float_value);
+        reader >> short_value;
+
+        EXPECT_EQ(1, octet_value);
+        EXPECT_EQ(-2, long_value);
+        EXPECT_EQ(3, ushort_value);
+        EXPECT_EQ(4.5, double_value);
+        EXPECT_TRUE(bool_value);
+        EXPECT_EQ(-6, longlong_value);
+        EXPECT_EQ('c', char_value);
+        EXPECT_EQ(7.5f, float_value);
+        EXPECT_EQ(8, short_value);
+        EXPECT_EQ(fields.getSerializedDataLength(), reader.getSerializedDataLength());
+    }
+}
+
+TEST(CDRFixedFieldsTests, SameBytesAsFieldByField)
+{
+    check_same_bytes(Cdr::DEFAULT_ENDIAN);
+}
+
+TEST(CDRFixedFieldsTests, SameBytesAsFieldByFieldSwapping)
+{
+    check_same_bytes(other_endianness);
+}
+
+TEST(CDRFixedFieldsTests, ResizeBuffer)
+{
+    FastBuffer cdrbuffer;
+    Cdr cdr(cdrbuffer);
+
+    for (int32_t count = 0; count < 100; ++count)
+    {
+        cdr.serialize_fields(static_cast<uint8_t>(count), count, static_cast<double>(count));
+    }
+
+    Cdr reader(cdrbuffer);
+
+    for (int32_t count = 0; count < 100; ++count)
+    {
+        uint8_t octet_value = 0;
+        int32_t long_value = 0;
+        double double_value = 0;
+        reader.deserialize_fields(octet_value, long_value, double_value);
+        EXPECT_EQ(static_cast<uint8_t>(count), octet_value);
+        EXPECT_EQ(count, long_value);
+        EXPECT_EQ(static_cast<double>(count), double_value);
+    }
+}
+
+TEST(CDRFixedFieldsTests, NotEnoughMemory)
+{
+    char buffer[10];
+    FastBuffer cdrbuffer(buffer, sizeof(buffer));
+    Cdr cdr(cdrbuffer);
+
+    cdr << static_cast<uint8_t>(1);
+    EXPECT_THROW(cdr.serialize_fields(2, 3), NotEnoughMemoryException);
+    EXPECT_EQ(1u, cdr.getSerializedDataLength());
+
+    cdr.serialize_fields(static_cast<uint16_t>(2), 3);
+    EXPECT_EQ(8u, cdr.getSerializedDataLength());
+
+    Cdr reader(cdrbuffer);
+    uint8_t octet_value = 0;
+    int32_t long_value = 0;
+    int64_t longlong_value = 0;
+    reader >> octet_value;
+    EXPECT_THROW(reader.deserialize_fields(long_value, longlong_value), NotEnoughMemoryException);
+    EXPECT_EQ(1u, reader.getSerializedDataLength());
+}
+
+TEST(CDRFixedFieldsTests, InvalidBoolean)
+{
+    char buffer[8] = {0, 0, 0, 1, 2, 0, 0, 0};
+    FastBuffer cdrbuffer(buffer, sizeof(buffer));
+    Cdr reader(cdrbuffer, Cdr::BIG_ENDIANNESS);
+
+    int32_t long_value = 0;
+    bool bool_value = false;
+    EXPECT_THROW(reader.deserialize_fields(long_value, bool_value), BadParamException);
+    EXPECT_EQ(0, long_value);
+    EXPECT_EQ(0u, reader.getSerializedDataLength());
+}
@@ -0,0 +1,195 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastcdr/FrameRing.h>
+#include <fastcdr/FastCdr.h>
+#include <fastcdr/exceptions/BadParamException.h>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+using namespace eprosima::fastcdr;
+using namespace ::exception;
+
+struct Tick
+{
+    void serialize(
+            Cdr& cdr) const
+    {
+        cdr << producer << sequence << text;
+    }
+
+    void deserialize(
+            Cdr& cdr)
+    {
+        cdr >> producer >> sequence >> text;
+    }
+
+    uint16_t producer = 0;
+    uint64_t sequence = 0;
+    std::string text;
+};
+
+static Tick make_tick(
+        uint16_t producer,
+        uint64_t sequence)
+{
+    Tick tick;
+    tick.producer = producer;
+    tick.sequence = sequence;
+    tick.text = std::string(sequence % 23, static_cast<char>('a' + producer));
+    return tick;
+}
+
+TEST(FrameRingTests, WrapsToTheStart)
+{
+    FrameRing ring(128);
+    EXPECT_EQ(128u, ring.capacity());
+    EXPECT_THROW(ring.reserve(49), BadParamException);
+
+    // A frame of 32 bytes takes a slot of 48, which does not divide the ring, so frames often skip to the start.
+    for (uint32_t turn = 0; turn < 10; ++turn)
+    {
+        for (uint32_t count = 0; count < 2; ++count)
+        {
+            FrameRing::Frame frame = ring.reserve(32);
+            ASSERT_TRUE(frame.data != nullptr);
+            EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(frame.data) % 16);
+
+            FastBuffer buffer(frame.data, frame.size);
+            FastCdr cdr(buffer);
+            cdr << turn << count;
+            ring.commit(frame, cdr.getSerializedDataLength());
+        }
+
+        EXPECT_TRUE(ring.reserve(48).data == nullptr);
+
+        for (uint32_t count = 0; count < 2; ++count)
+        {
+            FrameRing::Frame frame = ring.front();
+            ASSERT_TRUE(frame.data != nullptr);
+            ASSERT_EQ(8u, frame.size);
+
+            FastBuffer buffer(frame.data, frame.size);
+            FastCdr cdr(buffer);
+            uint32_t readTurn = 0, readCount = 0;
+            cdr >> readTurn >> readCount;
+            EXPECT_EQ(turn, readTurn);
+            EXPECT_EQ(count, readCount);
+            ring.pop();
+        }
+
+        EXPECT_TRUE(ring.front().data == nullptr);
+    }
+
+    // An aborted slot is skipped by the consumer.
+    FrameRing::Frame aborted = ring.reserve(16);
+    EXPECT_THROW(ring.push(std::string(100, 'x'), 16), NotEnoughMemoryException);
+    ring.abort(aborted);
+    EXPECT_TRUE(ring.push(std::string("kept"), 16));
+
+    std::string value;
+    EXPECT_TRUE(ring.pop(value));
+    EXPECT_EQ("kept", value);
+    EXPECT_FALSE(ring.pop(value));
+}
+
+TEST(FrameRingTests, SingleProducer)
+{
+    const uint64_t numFrames = 100000;
+    FrameRing ring(4096);
+
+    std::thread producer([&]()
+            {
+                for (uint64_t sequence = 0; sequence < numFrames; ++sequence)
+                {
+                    Tick tick = make_tick(0, sequence);
+
+                    while (!ring.push(tick, 64, sequence % 2 ? Cdr::BIG_ENDIANNESS : Cdr::LITTLE_ENDIANNESS))
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+
+    uint64_t expected = 0;
+
+    while (expected < numFrames)
+    {
+        Tick tick;
+
+        if (!ring.pop(tick))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        ASSERT_EQ(expected, tick.sequence);
+        ASSERT_EQ(make_tick(0, expected).text, tick.text);
+        ++expected;
+    }
+
+    producer.join();
+}
+
+TEST(FrameRingTests, MultipleProducers)
+{
+    const uint16_t numProducers = 4;
+    const uint64_t numFrames = 20000;
+    FrameRing ring(8192, true);
+    std::vector<std::thread> producers;
+
+    for (uint16_t index = 0; index < numProducers; ++index)
+    {
+        producers.emplace_back([&ring, index, numFrames]()
+                {
+                    for (uint64_t sequence = 0; sequence < numFrames; ++sequence)
+                    {
+                        while (!ring.push(make_tick(index, sequence), 64))
+                        {
+                            std::this_thread::yield();
+                        }
+                    }
+                });
+    }
+
+    // Frames of different producers interleave, but each producer's frames keep their order.
+    std::vector<uint64_t> expected(numProducers, 0);
+    uint64_t received = 0;
+
+    while (received < numProducers * numFrames)
+    {
+        Tick tick;
+
+        if (!ring.pop(tick))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        ASSERT_LT(tick.producer, numProducers);
+        ASSERT_EQ(expected[tick.producer], tick.sequence);
+        ASSERT_EQ(make_tick(tick.producer, tick.sequence).text, tick.text);
+        ++expected[tick.producer];
+        ++received;
+    }
+
+    for (std::thread& producer : producers)
+    {
+        producer.join();
+    }
+
+    EXPECT_TRUE(ring.front().data == nullptr);
+}
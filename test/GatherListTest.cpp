@@ -0,0 +1,198 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastcdr/GatherList.h>
+
+#include <gtest/gtest.h>
+
+using namespace eprosima::fastcdr;
+
+struct Image
+{
+    Image()
+        : payload(10001)
+        , samples(1000)
+        , small(10)
+    {
+        for (size_t count = 0; count < payload.size(); ++count)
+        {
+            payload[count] = static_cast<uint8_t>(count);
+        }
+
+        for (size_t count = 0; count < samples.size(); ++count)
+        {
+            samples[count] = static_cast<double>(count) * 0.5;
+        }
+    }
+
+    void serialize(
+            Cdr& cdr) const
+    {
+        cdr << id << payload << stamp << samples << flags << small << last;
+    }
+
+    void deserialize(
+            Cdr& cdr)
+    {
+        cdr >> id >> payload >> stamp >> samples >> flags >> small >> last;
+    }
+
+    uint8_t id = 3;
+    std::vector<uint8_t> payload;
+    double stamp = 1.25;
+    std::vector<double> samples;
+    uint16_t flags = 7;
+    std::vector<uint16_t> small;
+    uint64_t last = 0x0102030405060708;
+};
+
+static std::string concatenate(
+        const std::vector<GatherList::Segment>& segments)
+{
+    std::string stream;
+
+    for (const GatherList::Segment& segment : segments)
+    {
+        stream.append(segment.data, segment.size);
+    }
+
+    return stream;
+}
+
+static void check_gathered(
+        Cdr::Endianness endianness,
+        size_t expected_externals)
+{
+    Image image;
+
+    // Padding is not written, so both buffers start zeroed to compare the streams.
+    std::vector<char> copied_memory(20000, 0);
+    FastBuffer copied_buffer(copied_memory.data(), copied_memory.size());
+    Cdr copied(copied_buffer, endianness);
+    copied << image;
+
+    GatherList gather_list(1024);
+    std::vector<char> gathered_memory(10000, 0);
+    FastBuffer gathered_buffer(gathered_memory.data(), gathered_memory.size());
+    Cdr gathered(gathered_buffer, endianness);
+    gathered.setGatherList(&gather_list);
+    gathered << image;
+
+    // The referenced arrays are not copied, but the stream is the same.
+    EXPECT_EQ(expected_externals, gather_list.getExternalCount());
+    EXPECT_LT(gathered.getSerializedDataLength(), copied.getSerializedDataLength());
+    EXPECT_EQ(copied.getSerializedDataLength(), gather_list.getTotalSize(gathered));
+
+    std::string stream = concatenate(gather_list.getSegments(gathered));
+    ASSERT_EQ(copied.getSerializedDataLength(), stream.size());
+    EXPECT_EQ(0, memcmp(copied.getBufferPointer(), stream.data(), stream.size()));
+
+    FastBuffer stream_buffer(&stream[0], stream.size());
+    Cdr cdr_des(stream_buffer, endianness);
+    Image result;
+    result.payload.clear();
+    result.samples.clear();
+    cdr_des >> result;
+    EXPECT_EQ(image.payload, result.payload);
+    EXPECT_EQ(image.samples, result.samples);
+    EXPECT_EQ(image.small, result.small);
+    EXPECT_EQ(image.last, result.last);
+}
+
+TEST(GatherListTests, SameStreamAsCopying)
+{
+    check_gathered(Cdr::DEFAULT_ENDIAN, 2);
+}
+
+TEST(GatherListTests, SwappedArraysAreCopied)
+{
+    // Only the octets can be referenced when the bytes of the doubles have to be swapped.
+    check_gathered(Cdr::DEFAULT_ENDIAN == Cdr::BIG_ENDIANNESS ? Cdr::LITTLE_ENDIANNESS : Cdr::BIG_ENDIANNESS, 1);
+}
+
+TEST(GatherListTests, ResetClearsTheList)
+{
+    Image image;
+    GatherList gather_list(1024);
+    FastBuffer cdrbuffer;
+    Cdr cdr_ser(cdrbuffer);
+    cdr_ser.setGatherList(&gather_list);
+    cdr_ser << image;
+    EXPECT_EQ(2u, gather_list.getExternalCount());
+
+    cdr_ser.reset();
+    EXPECT_EQ(0u, gather_list.getExternalCount());
+    EXPECT_EQ(0u, gather_list.getTotalSize(cdr_ser));
+
+    cdr_ser.setGatherList(nullptr);
+    cdr_ser << image;
+    EXPECT_EQ(0u, gather_list.getExternalCount());
+}
+
+TEST(GatherListTests, RollbackRemovesTheArrays)
+{
+    std::vector<uint8_t> payload(100, 0xAB);
+    GatherList gather_list(16);
+    char memory[64] = {0};
+    FastBuffer cdrbuffer(memory, sizeof(memory));
+    Cdr cdr_ser(cdrbuffer);
+    cdr_ser.setGatherList(&gather_list);
+
+    Cdr::state state = cdr_ser.getState();
+    cdr_ser << payload;
+    EXPECT_EQ(1u, gather_list.getExternalCount());
+    cdr_ser.setState(state);
+    EXPECT_EQ(0u, gather_list.getExternalCount());
+    EXPECT_EQ(0u, gather_list.getTotalSize(cdr_ser));
+
+    // The second array does not fit, and the whole sequence of arrays is rolled back.
+    cdr_ser << static_cast<uint32_t>(7);
+    std::vector<std::vector<uint8_t>> too_long = {payload, std::vector<uint8_t>(15, 2), std::vector<uint8_t>(15, 2),
+                                                  std::vector<uint8_t>(15, 2), std::vector<uint8_t>(15, 2)};
+    EXPECT_THROW(cdr_ser << too_long, exception::NotEnoughMemoryException);
+    EXPECT_EQ(0u, gather_list.getExternalCount());
+
+    std::vector<GatherList::Segment> segments = gather_list.getSegments(cdr_ser);
+    ASSERT_EQ(1u, segments.size());
+    EXPECT_EQ(4u, segments[0].size);
+    EXPECT_EQ(cdr_ser.getSerializedDataLength(), gather_list.getTotalSize(cdr_ser));
+}
+
+#if !defined(_WIN32)
+TEST(GatherListTests, Iovecs)
+{
+    Image image;
+    GatherList gather_list(1024);
+    FastBuffer cdrbuffer;
+    Cdr cdr_ser(cdrbuffer);
+    cdr_ser.setGatherList(&gather_list);
+    cdr_ser << image;
+
+    std::vector<struct iovec> iovecs = gather_list.getIovecs(cdr_ser);
+
+    // Inline header, payload, inline stamp and length, samples, inline tail.
+    ASSERT_EQ(5u, iovecs.size());
+    EXPECT_EQ(image.payload.data(), iovecs[1].iov_base);
+    EXPECT_EQ(image.payload.size(), iovecs[1].iov_len);
+    EXPECT_EQ(image.samples.data(), iovecs[3].iov_base);
+
+    size_t total = 0;
+    for (const struct iovec& iov : iovecs)
+    {
+        total += iov.iov_len;
+    }
+    EXPECT_EQ(gather_list.getTotalSize(cdr_ser), total);
+}
+
+#endif // if !defined(_WIN32)
@@ -0,0 +1,167 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastcdr/Cdr.h>
+#include <fastcdr/exceptions/BadParamException.h>
+
+#include <gtest/gtest.h>
+
+using namespace eprosima::fastcdr;
+using namespace ::exception;
+
+TEST(CDRLimitsTests, SequenceLengthCountsBytes)
+{
+    // The length fits in the remaining bytes as a count of elements, but not as a count of bytes.
+    char buffer[200] = {0};
+    FastBuffer cdrbuffer(buffer, sizeof(buffer));
+    Cdr cdr_ser(cdrbuffer);
+    cdr_ser << static_cast<uint32_t>(100);
+
+    std::vector<uint64_t> vector_value;
+    uint64_t* sequence_value = nullptr;
+    size_t sequence_length = 0;
+
+    Cdr cdr_des(cdrbuffer);
+    EXPECT_THROW(cdr_des >> vector_value, NotEnoughMemoryException);
+    EXPECT_THROW(cdr_des.deserializeSequence(sequence_value, sequence_length), NotEnoughMemoryException);
+    EXPECT_EQ(nullptr, sequence_value);
+    EXPECT_EQ(0u, cdr_des.getSerializedDataLength());
+}
+
+TEST(CDRLimitsTests, CorruptedLengthDoesNotAllocate)
+{
+    char buffer[16] = {0};
+    FastBuffer cdrbuffer(buffer, sizeof(buffer));
+    Cdr cdr_ser(cdrbuffer);
+    cdr_ser << 0xFFFFFFFFu;
+
+    int32_t* sequence_value = nullptr;
+    size_t sequence_length = 0;
+    char* string_value = nullptr;
+    wchar_t* wstring_value = nullptr;
+    std::wstring wstring_object;
+
+    Cdr cdr_des(cdrbuffer);
+    EXPECT_THROW(cdr_des.deserializeSequence(sequence_value, sequence_length), NotEnoughMemoryException);
+    EXPECT_THROW(cdr_des >> string_value, NotEnoughMemoryException);
+    EXPECT_THROW(cdr_des.deserialize(wstring_value), NotEnoughMemoryException);
+    EXPECT_THROW(cdr_des >> wstring_object, NotEnoughMemoryException);
+    EXPECT_EQ(nullptr, sequence_value);
+    EXPECT_EQ(nullptr, string_value);
+    EXPECT_EQ(nullptr, wstring_value);
+    EXPECT_EQ(0u, cdr_des.getSerializedDataLength());
+}
+
+TEST(CDRLimitsTests, MaxSequenceElements)
+{
+    char buffer[64] = {0};
+    FastBuffer cdrbuffer(buffer, sizeof(buffer));
+    Cdr cdr_ser(cdrbuffer);
+    cdr_ser << std::vector<uint16_t>{1, 2, 3, 4};
+
+    Cdr::DeserializationLimits limits;
+    limits.maxSequenceElements = 3;
+
+    std::vector<uint16_t> vector_value;
+    std::map<uint16_t, uint16_t> map_value;
+
+    Cdr cdr_des(cdrbuffer);
+    cdr_des.setDeserializationLimits(limits);
+    EXPECT_EQ(3u, cdr_des.getDeserializationLimits().maxSequenceElements);
+    EXPECT_THROW(cdr_des >> vector_value, BadParamException);
+    EXPECT_THROW(cdr_des >> map_value, BadParamException);
+    EXPECT_EQ(0u, cdr_des.getSerializedDataLength());
+
+    limits.maxSequenceElements = 4;
+    cdr_des.setDeserializationLimits(limits);
+    cdr_des >> vector_value;
+    EXPECT_EQ(4u, vector_value.size());
+}
+
+TEST(CDRLimitsTests, MaxStringBytes)
+{
+    char buffer[64] = {0};
+    FastBuffer cdrbuffer(buffer, sizeof(buffer));
+    Cdr cdr_ser(cdrbuffer);
+    cdr_ser << std::string("too long");
+
+    Cdr::DeserializationLimits limits;
+    limits.maxStringBytes = 8;
+
+    std::string string_value;
+
+    Cdr cdr_des(cdrbuffer);
+    cdr_des.setDeserializationLimits(limits);
+    // The serialized length includes the terminating null character.
+    EXPECT_THROW(cdr_des >> string_value, BadParamException);
+    EXPECT_EQ(0u, cdr_des.getSerializedDataLength());
+
+    limits.maxStringBytes = 9;
+    cdr_des.setDeserializationLimits(limits);
+    cdr_des >> string_value;
+    EXPECT_EQ("too long", string_value);
+}
+
+TEST(CDRLimitsTests, MaxTotalAllocation)
+{
+    char buffer[128] = {0};
+    FastBuffer cdrbuffer(buffer, sizeof(buffer));
+    Cdr cdr_ser(cdrbuffer);
+    cdr_ser << std::vector<int32_t>{1, 2, 3, 4} << std::vector<int32_t>{5, 6, 7, 8};
+
+    Cdr::DeserializationLimits limits;
+    limits.maxTotalAllocation = 6 * sizeof(int32_t);
+
+    std::vector<int32_t> first_value;
+    std::vector<int32_t> second_value;
+
+    Cdr cdr_des(cdrbuffer);
+    cdr_des.setDeserializationLimits(limits);
+    cdr_des >> first_value;
+    EXPECT_THROW(cdr_des >> second_value, BadParamException);
+
+    // A new message starts a new count.
+    cdr_des.reset();
+    cdr_des >> first_value;
+    EXPECT_EQ(4u, first_value.size());
+}
+
+TEST(CDRLimitsTests, RollbackUndoesTheAllocation)
+{
+    char buffer[128] = {0};
+    FastBuffer cdrbuffer(buffer, sizeof(buffer));
+    Cdr cdr_ser(cdrbuffer);
+    cdr_ser << std::vector<int32_t>{1, 2, 3, 4} << std::vector<int32_t>{5, 6, 7, 8};
+
+    Cdr::DeserializationLimits limits;
+    limits.maxTotalAllocation = 6 * sizeof(int32_t);
+
+    std::vector<int32_t> value;
+    Cdr cdr_des(cdrbuffer);
+    cdr_des.setDeserializationLimits(limits);
+
+    // Reading the same sequence again, as a retry does, is not charged twice.
+    Cdr::state state = cdr_des.getState();
+    for (int count = 0; count < 3; ++count)
+    {
+        cdr_des.setState(state);
+        EXPECT_NO_THROW(cdr_des >> value);
+    }
+    EXPECT_EQ(4u, value.size());
+
+    // Lowering the limit below what was already allocated does not wrap around.
+    limits.maxTotalAllocation = 2 * sizeof(int32_t);
+    cdr_des.setDeserializationLimits(limits);
+    EXPECT_THROW(cdr_des >> value, BadParamException);
+}
@@ -0,0 +1,146 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastcdr/Numa.h>
+#include <fastcdr/BufferPool.h>
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace eprosima::fastcdr;
+
+// Runs a function in a new thread restricted to a node, so the affinity of the test thread is not changed.
+template<class _Function>
+static bool run_on_node(
+        size_t node,
+        _Function function)
+{
+    bool placed = false;
+    std::thread thread([&]()
+            {
+                placed = Numa::runOnNode(node);
+
+                if (placed)
+                {
+                    function();
+                }
+            });
+    thread.join();
+    return placed;
+}
+
+TEST(NumaTests, Topology)
+{
+    size_t numNodes = Numa::getNodeCount();
+    ASSERT_GE(numNodes, 1u);
+    EXPECT_LT(Numa::getCurrentNode(), numNodes);
+    EXPECT_FALSE(Numa::runOnNode(numNodes));
+
+    for (size_t node = 0; node < numNodes; ++node)
+    {
+        size_t current = Numa::UNKNOWN_NODE;
+
+        if (run_on_node(node, [&]()
+                {
+                    current = Numa::getCurrentNode();
+                }))
+        {
+            EXPECT_EQ(node, current);
+        }
+    }
+
+    // A single node is always there.
+    if (numNodes == 1)
+    {
+        EXPECT_TRUE(run_on_node(0, []()
+                {
+                }));
+    }
+}
+
+TEST(NumaTests, BindMemory)
+{
+    const size_t size = 1024 * 1024;
+    std::vector<char> data(size);
+    size_t numNodes = Numa::getNodeCount();
+
+    EXPECT_FALSE(Numa::bindMemory(data.data(), size, numNodes));
+
+    for (size_t node = 0; node < numNodes; ++node)
+    {
+        // The system calls may not be allowed, so the placement is only checked when it was done.
+        if (Numa::bindMemory(data.data(), size, node))
+        {
+            memset(data.data(), static_cast<int>(node), size);
+            size_t memoryNode = Numa::getMemoryNode(data.data() + size / 2);
+            EXPECT_TRUE((memoryNode == node) || (memoryNode == Numa::UNKNOWN_NODE));
+        }
+        else
+        {
+            EXPECT_GT(numNodes, 1u);
+        }
+    }
+}
+
+TEST(NumaTests, BufferPoolPerNode)
+{
+    const size_t size = 1024 * 1024;
+    size_t numNodes = Numa::getNodeCount();
+    BufferPool pool;
+
+    for (size_t node = 0; node < numNodes; ++node)
+    {
+        run_on_node(node, [&]()
+                {
+                    FastBuffer buffer = pool.acquire(size);
+                    ASSERT_NE(nullptr, buffer.getBuffer());
+                    memset(buffer.getBuffer(), 1, buffer.getBufferSize());
+                    size_t memoryNode = Numa::getMemoryNode(buffer.getBuffer() + size / 2);
+                    EXPECT_TRUE((memoryNode == node) || (memoryNode == Numa::UNKNOWN_NODE));
+                    pool.release(buffer);
+                });
+    }
+
+    // A buffer released on another node goes back to the node of its memory.
+    if (numNodes > 1)
+    {
+        BufferPool handoffPool;
+        FastBuffer buffer;
+        char* memory = nullptr;
+
+        run_on_node(0, [&]()
+                {
+                    buffer = handoffPool.acquire(size);
+                    memset(buffer.getBuffer(), 1, buffer.getBufferSize());
+                    memory = buffer.getBuffer();
+                });
+
+        if ((memory != nullptr) && (Numa::getMemoryNode(memory + size / 2) == 0) &&
+                run_on_node(1, [&]()
+                {
+                    handoffPool.release(buffer);
+                }))
+        {
+            run_on_node(0, [&]()
+                    {
+                        FastBuffer again = handoffPool.acquire(size);
+                        EXPECT_EQ(memory, again.getBuffer());
+                        handoffPool.release(again);
+                    });
+        }
+    }
+}
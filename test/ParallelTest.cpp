@@ -0,0 +1,311 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastcdr/Cdr.h>
+#include <fastcdr/ThreadPool.h>
+#include <fastcdr/exceptions/BadParamException.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstring>
+
+using namespace eprosima::fastcdr;
+using namespace ::exception;
+
+// Its size changes with the name, so the alignment of the ranges is often mispredicted.
+struct Measurement
+{
+    void serialize(
+            Cdr& cdr) const
+    {
+        cdr << flag << value << name << count;
+    }
+
+    void deserialize(
+            Cdr& cdr)
+    {
+        cdr >> flag >> value >> name >> count;
+    }
+
+    uint8_t flag = 0;
+    double value = 0;
+    std::string name;
+    uint16_t count = 0;
+};
+
+struct TaggedValue
+{
+    void serialize(
+            Cdr& cdr) const
+    {
+        if (first == 0xDEAD)
+        {
+            throw BadParamException("Invalid value");
+        }
+
+        cdr << second << first;
+    }
+
+    uint32_t first = 0;
+    uint8_t second = 0;
+};
+
+static std::vector<Measurement> make_measurements(
+        size_t size)
+{
+    std::vector<Measurement> measurements(size);
+
+    for (size_t index = 0; index < size; ++index)
+    {
+        measurements[index].flag = static_cast<uint8_t>(index);
+        measurements[index].value = static_cast<double>(index) / 3;
+        // The first element is the largest, so the ranges are presized enough to keep their padding zeroed.
+        measurements[index].name = std::string(index == 0 ? 12 : index % 7, 'a');
+        measurements[index].count = static_cast<uint16_t>(index * 3);
+    }
+
+    return measurements;
+}
+
+template<class _T>
+static void expect_same_bytes(
+        const _T& value,
+        size_t prefix,
+        Cdr::Endianness endianness,
+        ThreadPool& pool)
+{
+    std::vector<char> expected(1024 * 1024, 0);
+    FastBuffer expectedBuffer(expected.data(), expected.size());
+    Cdr expectedCdr(expectedBuffer, endianness);
+    expectedCdr.serializeArray(std::vector<uint8_t>(prefix, 1).data(), prefix);
+    expectedCdr << value;
+
+    std::vector<char> parallel(1024 * 1024, 0);
+    FastBuffer parallelBuffer(parallel.data(), parallel.size());
+    Cdr parallelCdr(parallelBuffer, endianness);
+    parallelCdr.serializeArray(std::vector<uint8_t>(prefix, 1).data(), prefix);
+    parallelCdr.serialize(value, pool);
+
+    ASSERT_EQ(expectedCdr.getSerializedDataLength(), parallelCdr.getSerializedDataLength());
+    EXPECT_EQ(expected, parallel);
+
+    // The values after the sequence are aligned as after the sequential path.
+    expectedCdr << static_cast<uint16_t>(1) << static_cast<uint64_t>(2);
+    parallelCdr << static_cast<uint16_t>(1) << static_cast<uint64_t>(2);
+    EXPECT_EQ(expectedCdr.getSerializedDataLength(), parallelCdr.getSerializedDataLength());
+}
+
+TEST(ParallelTests, ThreadPoolRunsEveryTask)
+{
+    ThreadPool pool(3);
+    EXPECT_EQ(3u, pool.size());
+
+    std::vector<std::atomic<int>> runs(1000);
+
+    for (int repetition = 0; repetition < 10; ++repetition)
+    {
+        pool.parallelFor(runs.size(), [&](size_t index)
+                {
+                    ++runs[index];
+
+                    // Nested calls run in the calling thread.
+                    if (index == 0)
+                    {
+                        std::atomic<int> nested(0);
+                        pool.parallelFor(10, [&](size_t)
+                        {
+                            ++nested;
+                        });
+                        EXPECT_EQ(10, nested);
+                    }
+                });
+    }
+
+    for (std::atomic<int>& count : runs)
+    {
+        EXPECT_EQ(10, count);
+    }
+
+    EXPECT_THROW(pool.parallelFor(100, [](size_t index)
+            {
+                if (index == 42)
+                {
+                    throw BadParamException("Task failed");
+                }
+            }), BadParamException);
+
+    // Without workers, the calling thread runs every task.
+    ThreadPool empty(0);
+    size_t count = 0;
+    empty.parallelFor(5, [&](size_t)
+            {
+                ++count;
+            });
+    EXPECT_EQ(5u, count);
+}
+
+TEST(ParallelTests, SameBytesAsSequential)
+{
+    ThreadPool pool(3);
+    std::vector<Measurement> measurements = make_measurements(5000);
+    std::vector<TaggedValue> values(3001);
+
+    for (size_t index = 0; index < values.size(); ++index)
+    {
+        values[index].first = static_cast<uint32_t>(index);
+        values[index].second = static_cast<uint8_t>(index);
+    }
+
+    std::vector<std::string> strings(2000);
+
+    for (size_t index = 0; index < strings.size(); ++index)
+    {
+        strings[index] = std::string(index % 13, 'x');
+    }
+
+    for (Cdr::Endianness endianness : {Cdr::BIG_ENDIANNESS, Cdr::LITTLE_ENDIANNESS})
+    {
+        for (size_t prefix = 0; prefix < 8; ++prefix)
+        {
+            expect_same_bytes(measurements, prefix, endianness, pool);
+            expect_same_bytes(values, prefix, endianness, pool);
+            expect_same_bytes(strings, prefix, endianness, pool);
+            expect_same_bytes(std::vector<uint32_t>(1000, 7), prefix, endianness, pool);
+            expect_same_bytes(make_measurements(10), prefix, endianness, pool);
+        }
+    }
+}
+
+TEST(ParallelTests, GrowingBufferRoundTrip)
+{
+    ThreadPool pool(2);
+    std::vector<Measurement> measurements = make_measurements(20000);
+
+    FastBuffer buffer;
+    Cdr cdr(buffer, Cdr::DEFAULT_ENDIAN, Cdr::DDS_CDR);
+    cdr.serialize_encapsulation();
+    cdr << static_cast<uint8_t>(1);
+    cdr.serialize(measurements, pool);
+
+    FastBuffer input(buffer.getBuffer(), cdr.getSerializedDataLength());
+    Cdr reader(input, Cdr::DEFAULT_ENDIAN, Cdr::DDS_CDR);
+    reader.read_encapsulation();
+    uint8_t prefix = 0;
+    std::vector<Measurement> result;
+    reader >> prefix >> result;
+
+    ASSERT_EQ(measurements.size(), result.size());
+
+    for (size_t index = 0; index < measurements.size(); ++index)
+    {
+        EXPECT_EQ(measurements[index].value, result[index].value);
+        EXPECT_EQ(measurements[index].name, result[index].name);
+        EXPECT_EQ(measurements[index].count, result[index].count);
+    }
+}
+
+template<class _T>
+static void expect_same_array(
+        const std::vector<_T>& values,
+        Cdr::Endianness endianness,
+        ThreadPool& pool)
+{
+    FastBuffer expectedBuffer;
+    Cdr expected(expectedBuffer, endianness);
+    expected << static_cast<uint8_t>(1) << values;
+
+    FastBuffer buffer;
+    Cdr cdr(buffer, endianness);
+    cdr.setThreadPool(&pool, 0);
+    EXPECT_EQ(&pool, cdr.getThreadPool());
+    cdr << static_cast<uint8_t>(1) << values;
+
+    ASSERT_EQ(expected.getSerializedDataLength(), cdr.getSerializedDataLength());
+    EXPECT_EQ(0, memcmp(expectedBuffer.getBuffer(), buffer.getBuffer(), cdr.getSerializedDataLength()));
+
+    FastBuffer input(buffer.getBuffer(), cdr.getSerializedDataLength());
+    Cdr reader(input, endianness);
+    reader.setThreadPool(&pool, 0);
+    uint8_t prefix = 0;
+    std::vector<_T> result;
+    reader >> prefix >> result;
+    EXPECT_EQ(values, result);
+}
+
+TEST(ParallelTests, LargeArraysOfBasicTypes)
+{
+    ThreadPool pool(3);
+    const size_t size = 300001;
+
+    std::vector<char> chars(size);
+    std::vector<int16_t> shorts(size);
+    std::vector<uint32_t> longs(size);
+    std::vector<int64_t> longlongs(size);
+    std::vector<float> floats(size);
+    std::vector<double> doubles(size);
+
+    for (size_t index = 0; index < size; ++index)
+    {
+        chars[index] = static_cast<char>(index);
+        shorts[index] = static_cast<int16_t>(index * 7);
+        longs[index] = static_cast<uint32_t>(index * 40503);
+        longlongs[index] = static_cast<int64_t>(index) * -1000003;
+        floats[index] = static_cast<float>(index) / 7;
+        doubles[index] = static_cast<double>(index) / 11;
+    }
+
+    for (Cdr::Endianness endianness : {Cdr::BIG_ENDIANNESS, Cdr::LITTLE_ENDIANNESS})
+    {
+        expect_same_array(chars, endianness, pool);
+        expect_same_array(shorts, endianness, pool);
+        expect_same_array(longs, endianness, pool);
+        expect_same_array(longlongs, endianness, pool);
+        expect_same_array(floats, endianness, pool);
+        expect_same_array(doubles, endianness, pool);
+    }
+
+    // An array of basic types serialized with a pool takes the same path.
+    FastBuffer expectedBuffer;
+    Cdr expected(expectedBuffer, Cdr::BIG_ENDIANNESS);
+    expected.serializeArray(doubles.data(), doubles.size());
+
+    FastBuffer buffer;
+    Cdr cdr(buffer, Cdr::BIG_ENDIANNESS);
+    cdr.serializeArray(doubles.data(), doubles.size(), pool);
+    EXPECT_TRUE(cdr.getThreadPool() == nullptr);
+    ASSERT_EQ(expected.getSerializedDataLength(), cdr.getSerializedDataLength());
+    EXPECT_EQ(0, memcmp(expectedBuffer.getBuffer(), buffer.getBuffer(), cdr.getSerializedDataLength()));
+}
+
+TEST(ParallelTests, Errors)
+{
+    ThreadPool pool(3);
+    std::vector<TaggedValue> values(5000);
+    values[4000].first = 0xDEAD;
+
+    char data[128 * 1024];
+    FastBuffer buffer(data, sizeof(data));
+    Cdr cdr(buffer);
+    cdr << static_cast<uint8_t>(1);
+
+    EXPECT_THROW(cdr.serialize(values, pool), BadParamException);
+    EXPECT_EQ(1u, cdr.getSerializedDataLength());
+
+    values[4000].first = 0;
+    FastBuffer small(data, 1000);
+    Cdr smallCdr(small);
+    EXPECT_THROW(smallCdr.serialize(values, pool), NotEnoughMemoryException);
+    EXPECT_EQ(0u, smallCdr.getSerializedDataLength());
+}
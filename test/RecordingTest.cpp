@@ -0,0 +1,183 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastcdr/Recording.h>
+#include <fastcdr/exceptions/BadParamException.h>
+
+#include <gtest/gtest.h>
+
+#if !defined(_WIN32)
+
+#include <cstdio>
+#include <unistd.h>
+
+using namespace eprosima::fastcdr;
+using namespace ::exception;
+
+struct Frame
+{
+    void serialize(
+            Cdr& cdr) const
+    {
+        cdr << id << pixels;
+    }
+
+    void deserialize(
+            Cdr& cdr)
+    {
+        cdr >> id >> pixels;
+    }
+
+    uint32_t id = 0;
+    std::vector<uint16_t> pixels;
+};
+
+static std::string recording_path(
+        const char* name)
+{
+    return ::testing::TempDir() + name + "." + std::to_string(getpid());
+}
+
+static void remove_recording(
+        const std::string& path)
+{
+    std::remove(path.c_str());
+    std::remove((path + ".idx").c_str());
+}
+
+TEST(RecordingTests, WriteAndSeek)
+{
+    std::string path = recording_path("fastcdr_recording");
+
+    for (Cdr::Endianness endianness : {Cdr::BIG_ENDIANNESS, Cdr::LITTLE_ENDIANNESS})
+    {
+        {
+            // A small buffer makes the writer flush many times.
+            RecordingWriter writer(path, endianness, 256);
+
+            for (uint32_t count = 0; count < 5000; ++count)
+            {
+                Frame frame;
+                frame.id = count;
+                frame.pixels.assign(count % 50, static_cast<uint16_t>(count));
+                writer.write(10 * static_cast<uint64_t>(count), frame);
+            }
+
+            EXPECT_EQ(5000u, writer.size());
+            EXPECT_TRUE(writer.close());
+        }
+
+        RecordingReader reader(path);
+        ASSERT_EQ(5000u, reader.size());
+        EXPECT_EQ(0u, reader.seek(0));
+        EXPECT_EQ(6u, reader.seek(55));
+        EXPECT_EQ(6u, reader.seek(60));
+        EXPECT_EQ(4999u, reader.seek(49990));
+        EXPECT_EQ(5000u, reader.seek(49991));
+        EXPECT_EQ(120u, reader.getTimestamp(12));
+
+        for (size_t position : {size_t(0), size_t(6), size_t(4999), size_t(1234)})
+        {
+            Frame frame;
+            Cdr& cdr = reader.getSample(position);
+            cdr >> frame;
+            EXPECT_EQ(position, frame.id);
+            EXPECT_EQ(position % 50, frame.pixels.size());
+            EXPECT_EQ(reader.getSampleSize(position), cdr.getSerializedDataLength());
+
+            // Samples are read in place, aligned in the mapped file.
+            EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(reader.getSampleData(position)) % 8);
+        }
+
+        EXPECT_THROW(reader.getSample(5000), BadParamException);
+    }
+
+    remove_recording(path);
+}
+
+TEST(RecordingTests, Errors)
+{
+    std::string path = recording_path("fastcdr_recording_errors");
+
+    {
+        RecordingWriter writer(path);
+        writer.write(10, std::string("first"));
+        EXPECT_THROW(writer.write(9, std::string("older")), BadParamException);
+
+        writer.beginSample(20) << std::string("aborted");
+        EXPECT_THROW(writer.beginSample(20), BadParamException);
+        writer.abortSample();
+        EXPECT_THROW(writer.endSample(), BadParamException);
+
+        writer.write(20, std::string("second"));
+        EXPECT_EQ(2u, writer.size());
+    }
+
+    {
+        RecordingReader reader(path);
+        ASSERT_EQ(2u, reader.size());
+        std::string value;
+        reader.getSample(1) >> value;
+        EXPECT_EQ("second", value);
+    }
+
+    // A data file cut after a crash hides the samples that did not reach it.
+    {
+        RecordingReader reader(path);
+        ASSERT_EQ(0, truncate(path.c_str(), reader.getSampleData(1) - reader.getSampleData(0)));
+    }
+
+    RecordingReader truncated(path);
+    EXPECT_EQ(1u, truncated.size());
+
+    remove_recording(path);
+    EXPECT_THROW(RecordingReader missing(path), BadParamException);
+}
+
+TEST(RecordingTests, CorruptedEntry)
+{
+    std::string path = recording_path("fastcdr_recording_corrupted");
+
+    {
+        RecordingWriter writer(path);
+        writer.write(10, std::string("first"));
+        writer.write(20, std::string("second"));
+        writer.write(30, std::string("third"));
+    }
+
+    // The offset of the middle entry, after the 8 bytes of the header and the timestamp, is set past the data file.
+    {
+        FILE* index = fopen((path + ".idx").c_str(), "r+b");
+        ASSERT_NE(nullptr, index);
+        const char offset[8] = {'\x7F', '\x7F', '\x7F', '\x7F', '\x7F', '\x7F', '\x7F', '\x7F'};
+        ASSERT_EQ(0, fseek(index, 8 + 24 + 8, SEEK_SET));
+        ASSERT_EQ(sizeof(offset), fwrite(offset, 1, sizeof(offset), index));
+        fclose(index);
+    }
+
+    RecordingReader reader(path);
+    ASSERT_EQ(3u, reader.size());
+    EXPECT_THROW(reader.getSample(1), BadParamException);
+    EXPECT_THROW(reader.getSampleData(1), BadParamException);
+    EXPECT_THROW(reader.getSampleSize(1), BadParamException);
+
+    // The other samples are still readable.
+    std::string value;
+    reader.getSample(2) >> value;
+    EXPECT_EQ("third", value);
+
+    remove_recording(path);
+}
+
+#endif // if !defined(_WIN32)
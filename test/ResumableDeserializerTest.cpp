@@ -0,0 +1,239 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastcdr/ResumableDeserializer.h>
+
+#include <gtest/gtest.h>
+
+using namespace eprosima::fastcdr;
+using namespace ::exception;
+
+struct Sample
+{
+    uint8_t id = 0;
+    double stamp = 0;
+    std::string name;
+    std::vector<int32_t> values;
+    std::map<uint16_t, std::string> labels;
+    std::vector<double> samples;
+    uint16_t crc = 0;
+};
+
+static Sample make_sample()
+{
+    Sample sample;
+    sample.id = 9;
+    sample.stamp = 12.5;
+    sample.name = "fragmented_sample";
+    for (int32_t count = 0; count < 300; ++count)
+    {
+        sample.values.push_back(count * 3);
+    }
+    sample.labels[1] = "one";
+    sample.labels[2] = "two";
+    for (size_t count = 0; count < 777; ++count)
+    {
+        sample.samples.push_back(static_cast<double>(count) / 4);
+    }
+    sample.crc = 0xBEEF;
+    return sample;
+}
+
+static std::vector<char> serialize_sample(
+        const Sample& sample,
+        Cdr::Endianness endianness)
+{
+    FastBuffer cdrbuffer;
+    Cdr cdr_ser(cdrbuffer, endianness, Cdr::DDS_CDR);
+    cdr_ser.serialize_encapsulation();
+    cdr_ser << sample.id << sample.stamp << sample.name << sample.values << sample.labels << sample.samples <<
+        sample.crc;
+    return std::vector<char>(cdr_ser.getBufferPointer(), cdr_ser.getBufferPointer() + cdr_ser.getSerializedDataLength());
+}
+
+// Feeds the stream in chunks and runs each stage of the deserialization as soon as it can finish.
+static void deserialize_in_chunks(
+        const std::vector<char>& stream,
+        size_t chunk_size,
+        Sample& result,
+        size_t& max_pending)
+{
+    ResumableDeserializer deserializer(Cdr::DEFAULT_ENDIAN, Cdr::DDS_CDR);
+    size_t stage = 0;
+    max_pending = 0;
+
+    for (size_t offset = 0; offset < stream.size(); offset += chunk_size)
+    {
+        size_t size = stream.size() - offset < chunk_size ? stream.size() - offset : chunk_size;
+        deserializer.feed(stream.data() + offset, size);
+        max_pending = deserializer.getPendingBytes() > max_pending ? deserializer.getPendingBytes() : max_pending;
+
+        bool finished = true;
+        while (finished && stage < 8)
+        {
+            switch (stage)
+            {
+                case 0:
+                    finished = deserializer.readEncapsulation();
+                    break;
+                case 1:
+                    finished = deserializer.step([&](Cdr& cdr)
+                                    {
+                                        cdr >> result.id >> result.stamp;
+                                    });
+                    break;
+                case 2:
+                    finished = deserializer.deserialize(result.name);
+                    break;
+                case 3:
+                    finished = deserializer.deserializeSequence(result.values);
+                    break;
+                case 4:
+                    finished = deserializer.deserialize(result.labels);
+                    break;
+                case 5:
+                    finished = deserializer.deserializeSequence(result.samples);
+                    break;
+                case 6:
+                    finished = deserializer.deserialize(result.crc);
+                    break;
+                default:
+                    finished = false;
+                    break;
+            }
+
+            if (finished)
+            {
+                ++stage;
+            }
+        }
+    }
+
+    EXPECT_EQ(7u, stage);
+    EXPECT_EQ(stream.size(), deserializer.getConsumedBytes());
+    EXPECT_EQ(0u, deserializer.getPendingBytes());
+}
+
+static void check_chunks(
+        Cdr::Endianness endianness)
+{
+    Sample sample = make_sample();
+    std::vector<char> stream = serialize_sample(sample, endianness);
+
+    for (size_t chunk_size : {1u, 3u, 7u, 64u, 1000u, 100000u})
+    {
+        Sample result;
+        size_t max_pending = 0;
+        deserialize_in_chunks(stream, chunk_size, result, max_pending);
+
+        EXPECT_EQ(sample.id, result.id);
+        EXPECT_EQ(sample.stamp, result.stamp);
+        EXPECT_EQ(sample.name, result.name);
+        EXPECT_EQ(sample.values, result.values);
+        EXPECT_EQ(sample.labels, result.labels);
+        EXPECT_EQ(sample.samples, result.samples);
+        EXPECT_EQ(sample.crc, result.crc);
+
+        // Sequences are deserialized as they arrive, so small chunks are never accumulated.
+        if (chunk_size < 64)
+        {
+            EXPECT_LT(max_pending, 64u);
+        }
+    }
+}
+
+TEST(ResumableDeserializerTests, Chunks)
+{
+    check_chunks(Cdr::DEFAULT_ENDIAN);
+}
+
+TEST(ResumableDeserializerTests, ChunksOtherEndianness)
+{
+    check_chunks(Cdr::DEFAULT_ENDIAN == Cdr::BIG_ENDIANNESS ? Cdr::LITTLE_ENDIANNESS : Cdr::BIG_ENDIANNESS);
+}
+
+TEST(ResumableDeserializerTests, RollbackUntilComplete)
+{
+    FastBuffer cdrbuffer;
+    Cdr cdr_ser(cdrbuffer);
+    cdr_ser << static_cast<uint8_t>(1) << static_cast<uint64_t>(0x0102030405060708);
+
+    ResumableDeserializer deserializer;
+    uint8_t first = 0;
+    uint64_t second = 0;
+    deserializer.feed(cdr_ser.getBufferPointer(), 6);
+    EXPECT_TRUE(deserializer.deserialize(first));
+    EXPECT_FALSE(deserializer.deserialize(second));
+    EXPECT_EQ(1u, deserializer.getConsumedBytes());
+    EXPECT_EQ(5u, deserializer.getPendingBytes());
+
+    deserializer.feed(cdr_ser.getBufferPointer() + 6, cdr_ser.getSerializedDataLength() - 6);
+    EXPECT_TRUE(deserializer.deserialize(second));
+    EXPECT_EQ(1u, first);
+    EXPECT_EQ(0x0102030405060708u, second);
+}
+
+TEST(ResumableDeserializerTests, Limits)
+{
+    FastBuffer cdrbuffer;
+    Cdr cdr_ser(cdrbuffer);
+    cdr_ser << 0xFFFFFFFFu;
+
+    Cdr::DeserializationLimits limits;
+    limits.maxSequenceElements = 1000;
+    ResumableDeserializer deserializer;
+    deserializer.setDeserializationLimits(limits);
+    deserializer.feed(cdr_ser.getBufferPointer(), cdr_ser.getSerializedDataLength());
+
+    std::vector<uint8_t> values;
+    EXPECT_THROW(deserializer.deserializeSequence(values), BadParamException);
+    EXPECT_TRUE(values.empty());
+}
+
+TEST(ResumableDeserializerTests, PendingBytesLimit)
+{
+    FastBuffer cdrbuffer;
+    Cdr cdr_ser(cdrbuffer);
+    std::array<uint32_t, 500> value_array = {};
+    cdr_ser << value_array;
+
+    Cdr::DeserializationLimits limits;
+    limits.maxTotalAllocation = 256;
+    ResumableDeserializer deserializer;
+    deserializer.setDeserializationLimits(limits);
+
+    // The array allocates nothing, and the step fails as soon as the bytes kept for it exceed the limit.
+    std::array<uint32_t, 500> values;
+    size_t fed = 0;
+    bool failed = false;
+
+    while (!failed && (fed < cdr_ser.getSerializedDataLength()))
+    {
+        size_t size = cdr_ser.getSerializedDataLength() - fed < 64 ? cdr_ser.getSerializedDataLength() - fed : 64;
+        deserializer.feed(cdr_ser.getBufferPointer() + fed, size);
+        fed += size;
+
+        try
+        {
+            EXPECT_FALSE(deserializer.deserialize(values));
+        }
+        catch (BadParamException&)
+        {
+            failed = true;
+        }
+    }
+
+    EXPECT_TRUE(failed);
+    EXPECT_LE(fed, 256u + 64u);
+}
@@ -6962,3 +6962,22 @@ TEST(FastCDRTests, ZeroSequenceAtTheEnd)
         cdr_des_bool >> value >> bool_zero_sequence;
     });
 }
+
+TEST(CDRTests, AlignAfterJump)
+{
+    char buffer[16] = {0};
+    FastBuffer cdrbuffer(buffer, sizeof(buffer));
+    Cdr cdr_ser(cdrbuffer);
+    cdr_ser << std::string("ab") << static_cast<uint32_t>(0x01020304);
+
+    // The string takes 7 bytes, so the integer after it is aligned to 8.
+    Cdr cdr_des(cdrbuffer);
+    uint32_t length = 0;
+    uint32_t value = 0;
+    cdr_des >> length;
+    ASSERT_EQ(3u, length);
+    ASSERT_TRUE(cdr_des.jump(length));
+    cdr_des >> value;
+    EXPECT_EQ(0x01020304u, value);
+    EXPECT_EQ(cdr_ser.getSerializedDataLength(), cdr_des.getSerializedDataLength());
+}
@@ -0,0 +1,203 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastcdr/Cdr.h>
+#include <fastcdr/TypeDescriptor.h>
+
+#include <gtest/gtest.h>
+
+using namespace eprosima::fastcdr;
+using namespace ::exception;
+
+struct Point
+{
+    void serialize(
+            Cdr& cdr) const
+    {
+        cdr << x << label;
+    }
+
+    void deserialize(
+            Cdr& cdr)
+    {
+        cdr >> x >> label;
+    }
+
+    static void skip(
+            Cdr& cdr)
+    {
+        ++skipped;
+        cdr.skip<double>().skip<std::string>();
+    }
+
+    double x = 0;
+    std::string label;
+    static int skipped;
+};
+
+int Point::skipped = 0;
+
+// A user type without a static skip function.
+struct Plain
+{
+    void serialize(
+            Cdr& cdr) const
+    {
+        cdr << value;
+    }
+
+    void deserialize(
+            Cdr& cdr)
+    {
+        cdr >> value;
+    }
+
+    uint16_t value = 0;
+};
+
+enum Color
+{
+    RED,
+    GREEN
+};
+
+static void serialize_message(
+        Cdr& cdr)
+{
+    std::vector<double> samples(1000, 0.5);
+    std::vector<std::string> names = {"a", "bb", ""};
+    std::array<int16_t, 3> shorts = {{1, 2, 3}};
+    std::map<uint32_t, std::string> labels = {{1, "one"}, {2, "two"}};
+    std::vector<Point> points(2);
+    std::vector<uint64_t> empty;
+    Plain plain;
+    uint32_t color = GREEN;
+
+    cdr << static_cast<uint8_t>(1) << std::string("skipped") << static_cast<uint8_t>(2) << samples <<
+        static_cast<uint8_t>(3) << names << shorts << static_cast<uint8_t>(4) << labels << points << empty <<
+        static_cast<uint8_t>(5) << std::wstring(L"wide") << 2.5L << plain << color << static_cast<uint64_t>(6);
+}
+
+static void check_markers(
+        Cdr& cdr,
+        uint8_t expected)
+{
+    uint8_t marker = 0;
+    cdr >> marker;
+    EXPECT_EQ(expected, marker);
+}
+
+TEST(SkipTests, SkipByType)
+{
+    FastBuffer cdrbuffer;
+    Cdr cdr_ser(cdrbuffer);
+    serialize_message(cdr_ser);
+
+    Point::skipped = 0;
+    Cdr cdr_des(cdrbuffer);
+    check_markers(cdr_des, 1);
+    cdr_des.skip<std::string>();
+    check_markers(cdr_des, 2);
+    cdr_des.skip<std::vector<double>>();
+    check_markers(cdr_des, 3);
+    cdr_des.skip<std::vector<std::string>>().skip<std::array<int16_t, 3>>();
+    check_markers(cdr_des, 4);
+    cdr_des.skip<std::map<uint32_t, std::string>>().skip<std::vector<Point>>().skip<std::vector<uint64_t>>();
+    EXPECT_EQ(2, Point::skipped);
+    check_markers(cdr_des, 5);
+    cdr_des.skip<std::wstring>().skip<long double>().skip<Plain>().skip<Color>();
+
+    uint64_t last = 0;
+    cdr_des >> last;
+    EXPECT_EQ(6u, last);
+    EXPECT_EQ(cdr_ser.getSerializedDataLength(), cdr_des.getSerializedDataLength());
+}
+
+TEST(SkipTests, SkipByDescriptor)
+{
+    FastBuffer cdrbuffer;
+    Cdr cdr_ser(cdrbuffer);
+    serialize_message(cdr_ser);
+
+    TypeDescriptor string_type(TypeDescriptor::TK_STRING);
+    TypeDescriptor point_type = TypeDescriptor::structure();
+    point_type.addMember("x", TypeDescriptor(TypeDescriptor::TK_DOUBLE)).addMember("label", string_type);
+
+    Cdr cdr_des(cdrbuffer);
+    check_markers(cdr_des, 1);
+    cdr_des.skip(string_type);
+    check_markers(cdr_des, 2);
+    cdr_des.skip(TypeDescriptor::sequence(TypeDescriptor(TypeDescriptor::TK_DOUBLE)));
+    check_markers(cdr_des, 3);
+    cdr_des.skip(TypeDescriptor::sequence(string_type))
+            .skip(TypeDescriptor::array(TypeDescriptor(TypeDescriptor::TK_SHORT), 3));
+    check_markers(cdr_des, 4);
+
+    TypeDescriptor entry_type = TypeDescriptor::structure();
+    entry_type.addMember("key", TypeDescriptor(TypeDescriptor::TK_ULONG)).addMember("value", string_type);
+    cdr_des.skip(TypeDescriptor::sequence(entry_type))
+            .skip(TypeDescriptor::sequence(point_type))
+            .skip(TypeDescriptor::sequence(TypeDescriptor(TypeDescriptor::TK_ULONGLONG)));
+    check_markers(cdr_des, 5);
+}
+
+TEST(SkipTests, Truncated)
+{
+    FastBuffer cdrbuffer;
+    Cdr cdr_ser(cdrbuffer);
+    std::vector<double> samples(100, 0.5);
+    cdr_ser << samples;
+
+    FastBuffer truncated(cdrbuffer.getBuffer(), 100);
+    Cdr cdr_des(truncated);
+    EXPECT_THROW(cdr_des.skip<std::vector<double>>(), NotEnoughMemoryException);
+
+    char buffer[8] = {0};
+    FastBuffer corrupted(buffer, sizeof(buffer));
+    Cdr cdr_corrupt(corrupted);
+    cdr_corrupt << 0xFFFFFFFFu;
+    cdr_corrupt.reset();
+    EXPECT_THROW(cdr_corrupt.skip<std::vector<uint64_t>>(), NotEnoughMemoryException);
+}
+
+TEST(SkipTests, SkipContainersWithoutAllocating)
+{
+    std::map<int32_t, std::string> map_value = {{1, "one"}, {2, "two"}};
+    std::unordered_map<int32_t, std::string> unordered_map_value = {{3, "three"}};
+    std::set<uint16_t> set_value = {7, 3, 11};
+    std::unordered_set<std::string> unordered_set_value = {"a", "bb", "ccc"};
+    std::deque<double> deque_value = {1.5, 2.5, 3.5};
+    std::vector<std::pair<int32_t, std::string>> flat_map_value = {{4, "four"}, {5, "five"}};
+
+    FastBuffer cdrbuffer;
+    Cdr cdr_ser(cdrbuffer);
+    cdr_ser << static_cast<uint8_t>(1) << map_value << unordered_map_value << set_value << static_cast<uint8_t>(2) <<
+        unordered_set_value << deque_value << flat_map_value << static_cast<uint8_t>(3);
+
+    // Deserializing any of the containers would exceed the limit.
+    Cdr::DeserializationLimits limits;
+    limits.maxTotalAllocation = 0;
+    Cdr cdr_des(cdrbuffer);
+    cdr_des.setDeserializationLimits(limits);
+
+    // The comparator of a map does not change its wire format.
+    check_markers(cdr_des, 1);
+    cdr_des.skip<std::map<int32_t, std::string, std::greater<int32_t>>>();
+    cdr_des.skip<std::unordered_map<int32_t, std::string>>().skip<std::set<uint16_t>>();
+    check_markers(cdr_des, 2);
+    cdr_des.skip<std::unordered_set<std::string>>().skip<std::deque<double>>();
+    cdr_des.skip<std::vector<std::pair<int32_t, std::string>>>();
+    check_markers(cdr_des, 3);
+    EXPECT_EQ(cdr_ser.getSerializedDataLength(), cdr_des.getSerializedDataLength());
+}
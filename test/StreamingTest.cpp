@@ -0,0 +1,220 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastcdr/Cdr.h>
+#include <fastcdr/CdrSink.h>
+#include <fastcdr/exceptions/BadParamException.h>
+
+#include <gtest/gtest.h>
+
+#if !defined(_WIN32)
+#include <stdio.h>
+#include <unistd.h>
+#endif // if !defined(_WIN32)
+
+using namespace eprosima::fastcdr;
+using namespace ::exception;
+
+struct Snapshot
+{
+    Snapshot()
+    {
+        for (uint32_t count = 0; count < 200; ++count)
+        {
+            entries[count] = "entry_" + std::to_string(count);
+        }
+
+        samples.resize(1000);
+        for (size_t count = 0; count < samples.size(); ++count)
+        {
+            samples[count] = static_cast<double>(count) * 0.25;
+        }
+
+        payload.assign(1001, 0x5A);
+        flags.assign(301, true);
+        text.assign(500, 'x');
+        wtext.assign(100, L'w');
+    }
+
+    void serialize(
+            Cdr& cdr) const
+    {
+        cdr << id << entries << samples << payload << flags << text << wtext << precise << last;
+    }
+
+    void deserialize(
+            Cdr& cdr)
+    {
+        cdr >> id >> entries >> samples >> payload >> flags >> text >> wtext >> precise >> last;
+    }
+
+    uint8_t id = 1;
+    std::map<uint32_t, std::string> entries;
+    std::vector<double> samples;
+    std::vector<uint8_t> payload;
+    std::vector<bool> flags;
+    std::string text;
+    std::wstring wtext;
+    long double precise = 3.5L;
+    uint64_t last = 0x0102030405060708;
+};
+
+static void check_streaming(
+        Cdr::Endianness endianness)
+{
+    Snapshot snapshot;
+
+    FastBuffer reference_buffer;
+    Cdr reference(reference_buffer, endianness);
+    reference << snapshot;
+
+    std::string stream;
+    size_t flushes = 0;
+    CallbackSink sink([&](const char* data, size_t size)
+            {
+                stream.append(data, size);
+                ++flushes;
+                return true;
+            });
+
+    char window[64];
+    FastBuffer window_buffer(window, sizeof(window));
+    Cdr cdr_ser(window_buffer, endianness);
+    cdr_ser.setSink(&sink);
+    cdr_ser << snapshot;
+    EXPECT_TRUE(cdr_ser.flush());
+
+    // The window never grows, and the stream is as long as the one serialized in a growing buffer.
+    EXPECT_EQ(sizeof(window), window_buffer.getBufferSize());
+    EXPECT_GT(flushes, 100u);
+    EXPECT_EQ(reference.getSerializedDataLength(), stream.size());
+    EXPECT_EQ(stream.size(), cdr_ser.getFlushedBytes());
+    EXPECT_EQ(0u, cdr_ser.getSerializedDataLength());
+
+    FastBuffer stream_buffer(&stream[0], stream.size());
+    Cdr cdr_des(stream_buffer, endianness);
+    Snapshot result;
+    result.entries.clear();
+    result.samples.clear();
+    cdr_des >> result;
+    EXPECT_EQ(snapshot.entries, result.entries);
+    EXPECT_EQ(snapshot.samples, result.samples);
+    EXPECT_EQ(snapshot.payload, result.payload);
+    EXPECT_EQ(snapshot.flags, result.flags);
+    EXPECT_EQ(snapshot.text, result.text);
+    EXPECT_EQ(snapshot.wtext, result.wtext);
+    EXPECT_EQ(snapshot.precise, result.precise);
+    EXPECT_EQ(snapshot.last, result.last);
+}
+
+TEST(StreamingTests, BoundedWindow)
+{
+    check_streaming(Cdr::DEFAULT_ENDIAN);
+}
+
+TEST(StreamingTests, BoundedWindowOtherEndianness)
+{
+    check_streaming(Cdr::DEFAULT_ENDIAN == Cdr::BIG_ENDIANNESS ? Cdr::LITTLE_ENDIANNESS : Cdr::BIG_ENDIANNESS);
+}
+
+TEST(StreamingTests, StatesAreRestrictedToTheWindow)
+{
+    CallbackSink sink([](const char*, size_t)
+            {
+                return true;
+            });
+
+    char window[32];
+    FastBuffer window_buffer(window, sizeof(window));
+    Cdr cdr_ser(window_buffer);
+    cdr_ser.setSink(&sink);
+
+    cdr_ser << static_cast<uint32_t>(1);
+    Cdr::state state = cdr_ser.getState();
+    cdr_ser << static_cast<uint32_t>(2);
+    EXPECT_NO_THROW(cdr_ser.setState(state));
+    EXPECT_EQ(4u, cdr_ser.getSerializedDataLength());
+
+    for (uint32_t count = 0; count < 10; ++count)
+    {
+        cdr_ser << count;
+    }
+    EXPECT_GT(cdr_ser.getFlushedBytes(), 0u);
+    EXPECT_THROW(cdr_ser.setState(state), BadParamException);
+}
+
+TEST(StreamingTests, SinkFailure)
+{
+    CallbackSink sink([](const char*, size_t)
+            {
+                return false;
+            });
+
+    char window[32];
+    FastBuffer window_buffer(window, sizeof(window));
+    Cdr cdr_ser(window_buffer);
+    cdr_ser.setSink(&sink);
+
+    std::vector<uint8_t> payload(100, 1);
+    EXPECT_THROW(cdr_ser << payload, NotEnoughMemoryException);
+}
+
+TEST(StreamingTests, SinkFailureInTheMiddleOfAMessage)
+{
+    size_t writes = 0;
+    CallbackSink sink([&](const char*, size_t)
+            {
+                return ++writes < 2;
+            });
+
+    char window[64];
+    FastBuffer window_buffer(window, sizeof(window));
+    Cdr cdr_ser(window_buffer);
+    cdr_ser.setSink(&sink);
+
+    // The rollback of the sequence cannot take back the first window, and the error of the sink is the one reported.
+    EXPECT_THROW(cdr_ser << std::vector<std::string>(10, std::string(40, 'x')), NotEnoughMemoryException);
+    EXPECT_EQ(2u, writes);
+    EXPECT_GT(cdr_ser.getFlushedBytes(), 0u);
+}
+
+#if !defined(_WIN32)
+TEST(StreamingTests, FileDescriptorSink)
+{
+    Snapshot snapshot;
+    FILE* file = tmpfile();
+    ASSERT_NE(nullptr, file);
+
+    FileDescriptorSink sink(fileno(file));
+    char window[128];
+    FastBuffer window_buffer(window, sizeof(window));
+    Cdr cdr_ser(window_buffer);
+    cdr_ser.setSink(&sink);
+    cdr_ser << snapshot;
+    ASSERT_TRUE(cdr_ser.flush());
+
+    std::string stream(cdr_ser.getFlushedBytes(), '\0');
+    ASSERT_EQ(0, fseek(file, 0, SEEK_SET));
+    ASSERT_EQ(stream.size(), fread(&stream[0], 1, stream.size(), file));
+    fclose(file);
+
+    FastBuffer stream_buffer(&stream[0], stream.size());
+    Cdr cdr_des(stream_buffer);
+    Snapshot result;
+    cdr_des >> result;
+    EXPECT_EQ(snapshot.entries, result.entries);
+    EXPECT_EQ(snapshot.last, result.last);
+}
+
+#endif // if !defined(_WIN32)